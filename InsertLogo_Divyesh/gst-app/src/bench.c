@@ -0,0 +1,405 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/* Bench mode: runs several headless
+ *
+ *   videotestsrc ! caps ! insert_logo ! fakesink sync=false
+ *
+ * pipelines at the same time on one main loop and reports the aggregate
+ * frame rate, the source to sink latency of each pipeline as measured by
+ * the latency tracer and the CPU time used, which gives the number of
+ * channels one core can carry at the caps frame rate.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "bench.h"
+
+typedef struct _Bench Bench;
+
+typedef struct
+{
+  Bench *bench;
+  guint index;
+  GstElement *pipeline;
+  GstBus *bus;
+  const gchar *logo_mode;
+  /* buffers that reached the sink, counted from the streaming thread */
+  gint frames;
+  gint last_frames;
+  gint64 end;
+  gboolean done;
+  gboolean failed;
+  /* latency tracer records, under the bench lock */
+  guint latency_count;
+  guint64 latency_sum;
+  guint64 latency_max;
+} BenchPipeline;
+
+struct _Bench
+{
+  GMainLoop *loop;
+  BenchPipeline *pipelines;
+  guint n_pipelines;
+  guint running;
+  gint64 start;
+  GMutex lock;
+};
+
+/* Process CPU time, user and system, in seconds */
+static gdouble
+bench_cpu_time (void)
+{
+  struct rusage usage;
+
+  if (getrusage (RUSAGE_SELF, &usage) != 0)
+    return 0.0;
+
+  return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+      usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+void
+bench_init_tracing (void)
+{
+  const gchar *debug;
+  gchar *value;
+
+  /* both are read by gst_init(), so this has to run before it */
+  if (g_getenv ("GST_TRACERS") == NULL)
+    g_setenv ("GST_TRACERS", "latency", TRUE);
+
+  debug = g_getenv ("GST_DEBUG");
+  if (debug != NULL && *debug != '\0')
+    value = g_strconcat (debug, ",GST_TRACER:7", NULL);
+  else
+    value = g_strdup ("GST_TRACER:7");
+  g_setenv ("GST_DEBUG", value, TRUE);
+  g_free (value);
+}
+
+/* Takes the latency tracer records out of the debug log and hands
+ * everything else on to the default log function */
+static void
+bench_log_func (GstDebugCategory * category, GstDebugLevel level,
+    const gchar * file, const gchar * function, gint line, GObject * object,
+    GstDebugMessage * message, gpointer user_data)
+{
+  Bench *bench = user_data;
+  GstStructure *record;
+  const gchar *sink;
+  guint64 time;
+  guint index;
+
+  if (strcmp (gst_debug_category_get_name (category), "GST_TRACER") != 0) {
+    gst_debug_log_default (category, level, file, function, line, object,
+        message, NULL);
+    return;
+  }
+
+  record = gst_structure_from_string (gst_debug_message_get (message), NULL);
+  if (record == NULL)
+    return;
+
+  /* the sinks are named after their pipeline */
+  if (gst_structure_has_name (record, "latency") &&
+      (sink = gst_structure_get_string (record, "sink-element")) != NULL &&
+      sscanf (sink, "sink%u", &index) == 1 && index < bench->n_pipelines &&
+      gst_structure_get_uint64 (record, "time", &time)) {
+    BenchPipeline *bp = &bench->pipelines[index];
+
+    g_mutex_lock (&bench->lock);
+    bp->latency_count++;
+    bp->latency_sum += time;
+    bp->latency_max = MAX (bp->latency_max, time);
+    g_mutex_unlock (&bench->lock);
+  }
+  gst_structure_free (record);
+}
+
+static GstPadProbeReturn
+bench_count_buffer (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  BenchPipeline *bp = user_data;
+
+  g_atomic_int_inc (&bp->frames);
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+bench_pipeline_finish (BenchPipeline * bp, gboolean failed)
+{
+  if (bp->done)
+    return;
+
+  bp->done = TRUE;
+  bp->failed = failed;
+  bp->end = g_get_monotonic_time ();
+  if (--bp->bench->running == 0)
+    g_main_loop_quit (bp->bench->loop);
+}
+
+static gboolean
+bench_bus_cb (GstBus * bus, GstMessage * msg, gpointer user_data)
+{
+  BenchPipeline *bp = user_data;
+
+  switch (GST_MESSAGE_TYPE (msg)) {
+    case GST_MESSAGE_ERROR:{
+      GError *err = NULL;
+      gchar *dbg_str = NULL;
+
+      gst_message_parse_error (msg, &err, &dbg_str);
+      g_printerr ("FAILED to run pipeline %u: %s\n%s\n", bp->index,
+          err->message, (dbg_str) ? dbg_str : "(no debugging information)");
+      g_error_free (err);
+      g_free (dbg_str);
+      bench_pipeline_finish (bp, TRUE);
+      break;
+    }
+    case GST_MESSAGE_EOS:
+      bench_pipeline_finish (bp, FALSE);
+      break;
+    default:
+      break;
+  }
+
+  return TRUE;
+}
+
+/* Once a second: the frame rate of all pipelines together over the last
+ * second */
+static gboolean
+bench_progress_cb (gpointer user_data)
+{
+  Bench *bench = user_data;
+  gint delta = 0;
+  guint i;
+
+  for (i = 0; i < bench->n_pipelines; i++) {
+    BenchPipeline *bp = &bench->pipelines[i];
+    gint frames = g_atomic_int_get (&bp->frames);
+
+    delta += frames - bp->last_frames;
+    bp->last_frames = frames;
+  }
+  g_print ("  %" GST_TIME_FORMAT "  %d fps, %u running\n",
+      GST_TIME_ARGS ((g_get_monotonic_time () - bench->start) * GST_USECOND),
+      delta, bench->running);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+bench_pipeline_init (Bench * bench, BenchPipeline * bp, guint index,
+    const BenchConfig * config)
+{
+  guint n_modes = config->logo_modes ? g_strv_length (config->logo_modes) : 0;
+  GError *err = NULL;
+  GstElement *sink;
+  GstPad *pad;
+  gchar *desc, *name;
+
+  bp->bench = bench;
+  bp->index = index;
+  bp->logo_mode = n_modes ? config->logo_modes[index % n_modes] : "";
+
+  desc = g_strdup_printf ("videotestsrc name=src%u num-buffers=%d ! %s ! "
+      "insert_logo %s ! fakesink name=sink%u sync=false", index,
+      config->num_buffers, config->caps, bp->logo_mode, index);
+  bp->pipeline = gst_parse_launch (desc, &err);
+  g_free (desc);
+  if (err != NULL) {
+    g_printerr ("Could not create pipeline %u: %s\n", index, err->message);
+    g_error_free (err);
+    if (bp->pipeline)
+      gst_object_unref (bp->pipeline);
+    return FALSE;
+  }
+
+  /* count frames at the sink, cheaper than fakesink's handoff signal */
+  name = g_strdup_printf ("sink%u", index);
+  sink = gst_bin_get_by_name (GST_BIN (bp->pipeline), name);
+  g_free (name);
+  pad = gst_element_get_static_pad (sink, "sink");
+  gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER, bench_count_buffer, bp,
+      NULL);
+  gst_object_unref (pad);
+  gst_object_unref (sink);
+
+  bp->bus = gst_pipeline_get_bus (GST_PIPELINE (bp->pipeline));
+  gst_bus_add_watch (bp->bus, bench_bus_cb, bp);
+
+  return TRUE;
+}
+
+/* Frame rate of the caps, 0 if they have none */
+static gdouble
+bench_caps_fps (const gchar * caps_str)
+{
+  GstCaps *caps = gst_caps_from_string (caps_str);
+  gint fps_n = 0, fps_d = 1;
+
+  if (caps == NULL)
+    return 0.0;
+  if (gst_caps_get_size (caps) > 0)
+    gst_structure_get_fraction (gst_caps_get_structure (caps, 0),
+        "framerate", &fps_n, &fps_d);
+  gst_caps_unref (caps);
+
+  return fps_d > 0 ? (gdouble) fps_n / fps_d : 0.0;
+}
+
+static void
+bench_report (Bench * bench, const BenchConfig * config, gdouble wall,
+    gdouble cpu)
+{
+  gdouble target_fps = bench_caps_fps (config->caps);
+  gdouble cores = wall > 0.0 ? cpu / wall : 0.0;
+  gdouble total_fps;
+  guint64 frames = 0;
+  guint i;
+
+  g_print ("\n%-8s %8s %9s %12s %12s  %s\n", "pipeline", "frames", "fps",
+      "latency-avg", "latency-max", "logo");
+  for (i = 0; i < bench->n_pipelines; i++) {
+    BenchPipeline *bp = &bench->pipelines[i];
+    gdouble secs = (bp->end - bench->start) / (gdouble) G_USEC_PER_SEC;
+    gint n = g_atomic_int_get (&bp->frames);
+
+    frames += n;
+    g_print ("%-8u %8d %9.1f ", i, n, secs > 0.0 ? n / secs : 0.0);
+    if (bp->latency_count > 0)
+      g_print ("%9.3f ms %9.3f ms", bp->latency_sum / 1e6 /
+          bp->latency_count, bp->latency_max / 1e6);
+    else
+      g_print ("%12s %12s", "n/a", "n/a");
+    g_print ("  %s%s\n", *bp->logo_mode ? bp->logo_mode : "(defaults)",
+        bp->failed ? " FAILED" : "");
+  }
+
+  total_fps = wall > 0.0 ? frames / wall : 0.0;
+  g_print ("\nPipelines:        %u\n", bench->n_pipelines);
+  g_print ("Caps:             %s\n", config->caps);
+  g_print ("Wall time:        %.3f s\n", wall);
+  g_print ("CPU time:         %.3f s (%.2f cores)\n", cpu, cores);
+  g_print ("Aggregate:        %.1f fps\n", total_fps);
+  if (cores > 0.0)
+    g_print ("Per core:         %.1f fps\n", total_fps / cores);
+  if (cores > 0.0 && target_fps > 0.0)
+    g_print ("Channels/core:    %.2f at %.2f fps\n",
+        total_fps / target_fps / cores, target_fps);
+}
+
+gint
+bench_run (const BenchConfig * config)
+{
+  Bench bench = { NULL, };
+  gboolean failed = FALSE;
+  gint64 end;
+  gdouble cpu;
+  guint i, progress;
+
+  if (config->pipelines < 1 || config->num_buffers < 1) {
+    g_printerr ("Bench needs at least one pipeline and one buffer\n");
+    return -1;
+  }
+
+  g_mutex_init (&bench.lock);
+  bench.n_pipelines = config->pipelines;
+  bench.pipelines = g_new0 (BenchPipeline, bench.n_pipelines);
+  for (i = 0; i < bench.n_pipelines; i++) {
+    if (!bench_pipeline_init (&bench, &bench.pipelines[i], i, config)) {
+      bench.n_pipelines = i;
+      failed = TRUE;
+      goto done;
+    }
+  }
+
+  bench.loop = g_main_loop_new (NULL, FALSE);
+  gst_debug_remove_log_function (gst_debug_log_default);
+  gst_debug_add_log_function (bench_log_func, &bench, NULL);
+
+  g_print ("Running %u pipelines of %d frames ...\n", bench.n_pipelines,
+      config->num_buffers);
+  cpu = bench_cpu_time ();
+  bench.start = g_get_monotonic_time ();
+  bench.running = bench.n_pipelines;
+  for (i = 0; i < bench.n_pipelines; i++)
+    gst_element_set_state (bench.pipelines[i].pipeline, GST_STATE_PLAYING);
+  progress = g_timeout_add_seconds (1, bench_progress_cb, &bench);
+
+  g_main_loop_run (bench.loop);
+
+  end = g_get_monotonic_time ();
+  cpu = bench_cpu_time () - cpu;
+  g_source_remove (progress);
+  for (i = 0; i < bench.n_pipelines; i++) {
+    gst_element_set_state (bench.pipelines[i].pipeline, GST_STATE_NULL);
+    failed |= bench.pipelines[i].failed;
+  }
+
+  gst_debug_remove_log_function (bench_log_func);
+  gst_debug_add_log_function (gst_debug_log_default, NULL, NULL);
+  g_main_loop_unref (bench.loop);
+
+  bench_report (&bench, config, (end - bench.start) / (gdouble) G_USEC_PER_SEC,
+      cpu);
+
+done:
+  /* shut down and free everything */
+  for (i = 0; i < bench.n_pipelines; i++) {
+    gst_bus_remove_watch (bench.pipelines[i].bus);
+    gst_object_unref (bench.pipelines[i].bus);
+    gst_object_unref (bench.pipelines[i].pipeline);
+  }
+  g_free (bench.pipelines);
+  g_mutex_clear (&bench.lock);
+
+  return failed ? -1 : 0;
+}
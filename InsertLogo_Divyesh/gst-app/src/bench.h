@@ -0,0 +1,74 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef _MY_APP_BENCH_H_INCLUDED_
+#define _MY_APP_BENCH_H_INCLUDED_
+
+#include <gst/gst.h>
+
+/* Default caps of the test source */
+#define BENCH_DEFAULT_CAPS \
+  "video/x-raw,format=NV12,width=1920,height=1080,framerate=30/1"
+
+/* Default number of frames each pipeline runs for */
+#define BENCH_DEFAULT_NUM_BUFFERS 600
+
+typedef struct
+{
+  /* number of pipelines run at the same time */
+  gint pipelines;
+  /* frames produced by each test source */
+  gint num_buffers;
+  /* caps between the test source and insert_logo */
+  const gchar *caps;
+  /* insert_logo properties in gst-launch syntax, pipeline i uses entry
+   * i modulo their number, NULL or empty for the defaults */
+  gchar **logo_modes;
+} BenchConfig;
+
+void    bench_init_tracing (void);
+gint    bench_run (const BenchConfig * config);
+
+#endif /* _MY_APP_BENCH_H_INCLUDED_ */
@@ -40,3 +40,5 @@
  */
 
 #include "play.h"
+#include "bench.h"
+#include "offline.h"
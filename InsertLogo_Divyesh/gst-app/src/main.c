@@ -43,6 +43,8 @@
 #include "config.h"
 #endif
 
+#include <string.h>
+
 #include "gst-app.h"
 
 static void
@@ -95,8 +97,35 @@ int
 main (int argc, char *argv[])
 {
   gchar **filenames = NULL;
+  gchar *caps = NULL;
+  BenchConfig bench = { 1, BENCH_DEFAULT_NUM_BUFFERS, BENCH_DEFAULT_CAPS,
+    NULL };
+  gboolean bench_mode = FALSE;
+  OfflineConfig offline = { NULL, 0, NULL, OFFLINE_DEFAULT_ENCODER,
+    OFFLINE_DEFAULT_EXTENSION };
+  gchar *encoder = NULL, *extension = NULL;
   const GOptionEntry entries[] = {
     /* you can add your won command line options here */
+    { "bench", 'b', 0, G_OPTION_ARG_NONE, &bench_mode,
+      "Run headless insert_logo pipelines and report throughput", NULL },
+    { "pipelines", 'n', 0, G_OPTION_ARG_INT, &bench.pipelines,
+      "Number of pipelines to run at the same time in bench mode", "N" },
+    { "num-buffers", 0, 0, G_OPTION_ARG_INT, &bench.num_buffers,
+      "Frames per pipeline in bench mode", "N" },
+    { "caps", 0, 0, G_OPTION_ARG_STRING, &caps,
+      "Caps of the test source in bench mode", "CAPS" },
+    { "logo", 'l', 0, G_OPTION_ARG_STRING_ARRAY, &bench.logo_modes,
+      "insert_logo properties of a pipeline in bench mode, may be repeated "
+      "and is used round robin", "PROPS" },
+    { "output-dir", 'o', 0, G_OPTION_ARG_FILENAME, &offline.output_dir,
+      "Watermark the files into this directory instead of playing them",
+      "DIR" },
+    { "jobs", 'j', 0, G_OPTION_ARG_INT, &offline.jobs,
+      "Files watermarked at the same time, default one per core", "N" },
+    { "encoder", 0, 0, G_OPTION_ARG_STRING, &encoder,
+      "Encoder and muxer of the watermarked files", "DESC" },
+    { "extension", 0, 0, G_OPTION_ARG_STRING, &extension,
+      "Extension of the watermarked files", "EXT" },
     { G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &filenames,
       "Special option that collects any remaining arguments for us" },
     { NULL, }
@@ -105,6 +134,12 @@ main (int argc, char *argv[])
   GError *err = NULL;
   gint i, num;
 
+  /* the latency tracer has to be set up before gst_init() */
+  for (i = 1; i < argc; ++i) {
+    if (strcmp (argv[i], "--bench") == 0 || strcmp (argv[i], "-b") == 0)
+      bench_init_tracing ();
+  }
+
   ctx = g_option_context_new ("[FILE1] [FILE2] ...");
   g_option_context_add_group (ctx, gst_init_get_option_group ());
   g_option_context_add_main_entries (ctx, entries, NULL);
@@ -115,11 +150,40 @@ main (int argc, char *argv[])
   }
   g_option_context_free (ctx);
 
+  if (bench_mode) {
+    gint ret;
+
+    if (caps != NULL)
+      bench.caps = caps;
+    ret = bench_run (&bench);
+    g_strfreev (bench.logo_modes);
+    g_free (caps);
+    return ret;
+  }
+
   if (filenames == NULL || *filenames == NULL) {
     g_print ("Please specify a file to play\n\n");
     return -1;
   }
 
+  if (offline.output_dir != NULL) {
+    gint ret;
+
+    if (encoder != NULL)
+      offline.encoder = encoder;
+    if (extension != NULL)
+      offline.extension = extension;
+    if (bench.logo_modes != NULL)
+      offline.logo_mode = bench.logo_modes[0];
+    ret = offline_run (&offline, filenames);
+    g_strfreev (bench.logo_modes);
+    g_strfreev (filenames);
+    g_free ((gchar *) offline.output_dir);
+    g_free (encoder);
+    g_free (extension);
+    return ret;
+  }
+
 
 
   num = g_strv_length (filenames);
@@ -0,0 +1,386 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/* Offline mode: watermarks every file below the given files and
+ * directories with
+ *
+ *   filesrc ! decodebin ! videoconvert ! insert_logo ! videoconvert !
+ *   encoder ! filesink
+ *
+ * running a fixed number of these pipelines at the same time on one main
+ * loop. A finished pipeline starts the next file straight away, so the
+ * pool stays full until the queue is empty. Only the video is kept.
+ *
+ * Each output is written as <name>.part and renamed when the pipeline
+ * reaches EOS, so an interrupted or failed run never leaves a truncated
+ * file under the final name.
+ */
+
+#include <string.h>
+#include <glib/gstdio.h>
+
+#include "offline.h"
+
+/* Seconds between two progress lines */
+#define OFFLINE_PROGRESS_INTERVAL 2
+
+typedef struct _Offline Offline;
+
+typedef struct
+{
+  gchar *input;
+  gchar *output;
+} OfflineFile;
+
+typedef struct
+{
+  Offline *offline;
+  OfflineFile *file;
+  GstElement *pipeline;
+  gchar *part;
+  /* frames out of insert_logo, counted from the streaming thread */
+  gint frames;
+  gint64 start;
+} OfflineJob;
+
+struct _Offline
+{
+  const OfflineConfig *config;
+  GMainLoop *loop;
+  GQueue pending;
+  OfflineJob *jobs;
+  guint n_jobs;
+  guint running;
+  guint total;
+  guint finished;
+  guint failed;
+  guint64 frames;
+  guint64 last_frames;
+  gint64 start;
+};
+
+static void
+offline_file_free (OfflineFile * file)
+{
+  g_free (file->input);
+  g_free (file->output);
+  g_free (file);
+}
+
+/* Queues @path, or every file below it if it is a directory. @root is the
+ * argument it was found under, its part of the path is replaced by the
+ * output directory. */
+static void
+offline_add (Offline * offline, const gchar * root, const gchar * path)
+{
+  OfflineFile *file;
+  const gchar *relative;
+  gchar *base, *dot;
+  GDir *dir;
+
+  if ((dir = g_dir_open (path, 0, NULL))) {
+    const gchar *entry;
+
+    while ((entry = g_dir_read_name (dir))) {
+      gchar *child;
+
+      child = g_build_filename (path, entry, NULL);
+      offline_add (offline, root, child);
+      g_free (child);
+    }
+
+    g_dir_close (dir);
+    return;
+  }
+
+  if (strcmp (path, root) == 0) {
+    base = g_path_get_basename (path);
+  } else {
+    relative = path + strlen (root);
+    while (G_IS_DIR_SEPARATOR (*relative))
+      relative++;
+    base = g_strdup (relative);
+  }
+
+  /* swap the extension for the one of the output container */
+  dot = strrchr (base, '.');
+  if (dot != NULL && strchr (dot, G_DIR_SEPARATOR) == NULL)
+    *dot = '\0';
+
+  file = g_new0 (OfflineFile, 1);
+  file->input = g_strdup (path);
+  file->output = g_strdup_printf ("%s" G_DIR_SEPARATOR_S "%s.%s",
+      offline->config->output_dir, base, offline->config->extension);
+  g_free (base);
+
+  g_queue_push_tail (&offline->pending, file);
+  offline->total++;
+}
+
+static GstPadProbeReturn
+offline_count_buffer (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  OfflineJob *job = user_data;
+
+  g_atomic_int_inc (&job->frames);
+
+  return GST_PAD_PROBE_OK;
+}
+
+static gboolean offline_job_next (OfflineJob * job);
+
+/* Tears the pipeline of @job down, publishes or removes its output and
+ * moves on to the next file */
+static void
+offline_job_finish (OfflineJob * job, const gchar * error)
+{
+  Offline *offline = job->offline;
+  gdouble secs = (g_get_monotonic_time () - job->start) /
+      (gdouble) G_USEC_PER_SEC;
+  gint frames = g_atomic_int_get (&job->frames);
+
+  if (job->pipeline) {
+    gst_element_set_state (job->pipeline, GST_STATE_NULL);
+    gst_object_unref (job->pipeline);
+    job->pipeline = NULL;
+  }
+
+  if (error == NULL && g_rename (job->part, job->file->output) != 0)
+    error = "could not rename the output";
+
+  offline->finished++;
+  offline->frames += frames;
+  if (error != NULL) {
+    offline->failed++;
+    g_unlink (job->part);
+    g_printerr ("[%u/%u] FAILED %s: %s\n", offline->finished, offline->total,
+        job->file->input, error);
+  } else {
+    g_print ("[%u/%u] %s: %d frames in %.2f s (%.1f fps)\n",
+        offline->finished, offline->total, job->file->input, frames, secs,
+        secs > 0.0 ? frames / secs : 0.0);
+  }
+
+  g_free (job->part);
+  job->part = NULL;
+  offline_file_free (job->file);
+  job->file = NULL;
+
+  if (!offline_job_next (job) && --offline->running == 0)
+    g_main_loop_quit (offline->loop);
+}
+
+static gboolean
+offline_bus_cb (GstBus * bus, GstMessage * msg, gpointer user_data)
+{
+  OfflineJob *job = user_data;
+
+  switch (GST_MESSAGE_TYPE (msg)) {
+    case GST_MESSAGE_ERROR:{
+      GError *err = NULL;
+      gchar *dbg_str = NULL;
+
+      gst_message_parse_error (msg, &err, &dbg_str);
+      GST_DEBUG ("%s: %s", job->file->input, dbg_str);
+      offline_job_finish (job, err->message);
+      g_error_free (err);
+      g_free (dbg_str);
+      return G_SOURCE_REMOVE;
+    }
+    case GST_MESSAGE_EOS:
+      offline_job_finish (job, NULL);
+      return G_SOURCE_REMOVE;
+    default:
+      break;
+  }
+
+  return G_SOURCE_CONTINUE;
+}
+
+/* Starts @job on the next file of the queue that can be set up. Returns
+ * FALSE when the queue is empty. */
+static gboolean
+offline_job_next (OfflineJob * job)
+{
+  Offline *offline = job->offline;
+  const OfflineConfig *config = offline->config;
+
+  while ((job->file = g_queue_pop_head (&offline->pending))) {
+    GError *err = NULL;
+    GstElement *element;
+    GstPad *pad;
+    GstBus *bus;
+    gchar *desc, *dir;
+
+    dir = g_path_get_dirname (job->file->output);
+    g_mkdir_with_parents (dir, 0755);
+    g_free (dir);
+
+    desc = g_strdup_printf ("filesrc name=src ! decodebin ! videoconvert ! "
+        "insert_logo name=logo %s ! videoconvert ! "
+        "%s ! filesink name=sink", config->logo_mode ? config->logo_mode : "",
+        config->encoder);
+    job->pipeline = gst_parse_launch (desc, &err);
+    g_free (desc);
+    job->part = g_strconcat (job->file->output, ".part", NULL);
+    job->frames = 0;
+    job->start = g_get_monotonic_time ();
+    if (err != NULL) {
+      /* the same description fails for every file, give up on them all */
+      g_printerr ("Could not create pipeline: %s\n", err->message);
+      g_error_free (err);
+      if (job->pipeline)
+        gst_object_unref (job->pipeline);
+      job->pipeline = NULL;
+      g_free (job->part);
+      job->part = NULL;
+      offline_file_free (job->file);
+      job->file = NULL;
+      offline->failed += g_queue_get_length (&offline->pending) + 1;
+      g_queue_clear_full (&offline->pending,
+          (GDestroyNotify) offline_file_free);
+      return FALSE;
+    }
+
+    element = gst_bin_get_by_name (GST_BIN (job->pipeline), "src");
+    g_object_set (element, "location", job->file->input, NULL);
+    gst_object_unref (element);
+    element = gst_bin_get_by_name (GST_BIN (job->pipeline), "sink");
+    g_object_set (element, "location", job->part, NULL);
+    gst_object_unref (element);
+
+    element = gst_bin_get_by_name (GST_BIN (job->pipeline), "logo");
+    pad = gst_element_get_static_pad (element, "src");
+    gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER, offline_count_buffer,
+        job, NULL);
+    gst_object_unref (pad);
+    gst_object_unref (element);
+
+    bus = gst_pipeline_get_bus (GST_PIPELINE (job->pipeline));
+    gst_bus_add_watch (bus, offline_bus_cb, job);
+    gst_object_unref (bus);
+
+    /* a failing state change posts an error, handled on the bus */
+    gst_element_set_state (job->pipeline, GST_STATE_PLAYING);
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
+static gboolean
+offline_progress_cb (gpointer user_data)
+{
+  Offline *offline = user_data;
+  gdouble secs = (g_get_monotonic_time () - offline->start) /
+      (gdouble) G_USEC_PER_SEC;
+  guint64 frames = offline->frames;
+  guint i;
+
+  for (i = 0; i < offline->n_jobs; i++) {
+    if (offline->jobs[i].file != NULL)
+      frames += g_atomic_int_get (&offline->jobs[i].frames);
+  }
+
+  g_print ("  %u/%u done, %u running, %u failed, %.1f fps, %.0f s\n",
+      offline->finished, offline->total, offline->running, offline->failed,
+      (frames - offline->last_frames) / (gdouble) OFFLINE_PROGRESS_INTERVAL,
+      secs);
+  offline->last_frames = frames;
+
+  return G_SOURCE_CONTINUE;
+}
+
+gint
+offline_run (const OfflineConfig * config, gchar ** paths)
+{
+  Offline offline = { config, };
+  gdouble secs;
+  guint i, progress;
+
+  g_queue_init (&offline.pending);
+  for (i = 0; paths[i] != NULL; i++)
+    offline_add (&offline, paths[i], paths[i]);
+  if (offline.total == 0) {
+    g_print ("No files to watermark\n");
+    return -1;
+  }
+
+  offline.n_jobs = config->jobs > 0 ? config->jobs : g_get_num_processors ();
+  offline.n_jobs = MIN (offline.n_jobs, offline.total);
+  offline.jobs = g_new0 (OfflineJob, offline.n_jobs);
+  offline.loop = g_main_loop_new (NULL, FALSE);
+
+  g_print ("Watermarking %u files with %u pipelines into %s ...\n",
+      offline.total, offline.n_jobs, config->output_dir);
+  offline.start = g_get_monotonic_time ();
+  for (i = 0; i < offline.n_jobs; i++) {
+    offline.jobs[i].offline = &offline;
+    if (offline_job_next (&offline.jobs[i]))
+      offline.running++;
+  }
+  progress = g_timeout_add_seconds (OFFLINE_PROGRESS_INTERVAL,
+      offline_progress_cb, &offline);
+
+  if (offline.running > 0)
+    g_main_loop_run (offline.loop);
+
+  g_source_remove (progress);
+  secs = (g_get_monotonic_time () - offline.start) / (gdouble) G_USEC_PER_SEC;
+  g_print ("\nFiles:      %u done, %u failed\n", offline.total - offline.failed,
+      offline.failed);
+  g_print ("Frames:     %" G_GUINT64_FORMAT "\n", offline.frames);
+  g_print ("Wall time:  %.2f s\n", secs);
+  g_print ("Throughput: %.1f fps, %.2f files/s\n",
+      secs > 0.0 ? offline.frames / secs : 0.0,
+      secs > 0.0 ? (offline.total - offline.failed) / secs : 0.0);
+
+  /* shut down and free everything */
+  g_main_loop_unref (offline.loop);
+  g_free (offline.jobs);
+
+  return offline.failed > 0 ? -1 : 0;
+}
@@ -0,0 +1,669 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:blend-bench
+ *
+ * Micro-benchmark of the logo blend kernels, run by `meson benchmark`.
+ *
+ * Synthetic frames of 720p, 1080p and 4K in semi-planar, planar, grey,
+ * packed, 10 bit and tiled formats, with tight and padded strides, are overlaid with logos of three sizes and three alpha profiles
+ * (sparse, opaque, gradient) in the static, scroll, rotate and zoom modes, at
+ * full and at half global opacity so every kernel is used. Each case
+ * prints the cost in ns per logo pixel and frames per second as CSV, or as
+ * JSON with --json. --space linear runs the cases in the linear blend
+ * space instead.
+ *
+ * Every case is also blended once by a plain per-byte scalar reference and
+ * the frames are compared byte for byte, including the stride padding. The
+ * program fails if any case differs, so a faster kernel has to prove it
+ * gives exactly the same output.
+ *
+ * Usage: blend-bench [--json] [--time SECONDS] [--format FORMAT]
+ *     [--space gamma|linear]
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gstlogocolor.h"
+#include "gstlogosprite.h"
+
+/* Seconds each case is timed for unless given on the command line */
+#define DFLT_CASE_TIME 0.05
+
+typedef enum
+{
+  PROFILE_SPARSE,
+  PROFILE_OPAQUE,
+  PROFILE_GRADIENT,
+  N_PROFILES
+} BenchProfile;
+
+typedef enum
+{
+  MODE_STATIC,
+  MODE_SCROLL,
+  MODE_ROTATE,
+  MODE_ZOOM,
+  N_MODES
+} BenchMode;
+
+static const gchar *profile_names[N_PROFILES] = { "sparse", "opaque", "gradient" };
+static const gchar *mode_names[N_MODES] = { "static", "scroll", "rotate",
+  "zoom"
+};
+
+static const GstVideoFormat formats[] = {
+  GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_NV16,
+  GST_VIDEO_FORMAT_Y444, GST_VIDEO_FORMAT_GRAY8, GST_VIDEO_FORMAT_UYVY,
+  GST_VIDEO_FORMAT_BGRx, GST_VIDEO_FORMAT_P010_10LE,
+  GST_VIDEO_FORMAT_I420_10LE, GST_VIDEO_FORMAT_NV12_4L4,
+  GST_VIDEO_FORMAT_NV12_64Z32
+};
+static const gint resolutions[][2] = { {1280, 720}, {1920, 1080}, {3840, 2160} };
+static const gint logo_sizes[][2] = { {96, 48}, {320, 120}, {640, 240} };
+static const guint alphas[] = { 255, 128 };
+
+/* Exact x / 255 with rounding, as used by the kernels */
+static inline guint
+div255 (guint x)
+{
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+/* Premultiplied ARGB of one logo pixel for an alpha profile */
+static guint32
+bench_logo_pixel (BenchProfile profile, gint x, gint y, gint w, gint h)
+{
+  guint a, r, g, b;
+
+  switch (profile) {
+    case PROFILE_OPAQUE:
+      a = 255;
+      break;
+    case PROFILE_GRADIENT:
+      a = x * 255 / MAX (1, w - 1);
+      break;
+    default:
+      /* Round dots with soft edges on a transparent background, about a
+       * tenth of the area like thin text or a line art logo */
+    {
+      gdouble dx = (x % 24) - 11.5, dy = (y % 24) - 11.5;
+      gdouble d = sqrt (dx * dx + dy * dy);
+
+      a = d < 5.0 ? 255 : d < 7.0 ? (guint) ((7.0 - d) * 127.5) : 0;
+      break;
+    }
+  }
+  r = (x * 7 + y * 3) & 0xff;
+  g = (x * 2 + y * 5) & 0xff;
+  b = (x + y * 11) & 0xff;
+
+  return (a << 24) | (div255 (r * a) << 16) | (div255 (g * a) << 8) |
+      div255 (b * a);
+}
+
+static cairo_surface_t *
+bench_logo_new (BenchProfile profile, gint w, gint h)
+{
+  cairo_surface_t *surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+      w, h);
+  guint8 *data = cairo_image_surface_get_data (surface);
+  gint stride = cairo_image_surface_get_stride (surface);
+  gint x, y;
+
+  for (y = 0; y < h; y++) {
+    guint32 *row = (guint32 *) (data + (gsize) y * stride);
+    for (x = 0; x < w; x++)
+      row[x] = bench_logo_pixel (profile, x, y, w, h);
+  }
+  cairo_surface_mark_dirty (surface);
+
+  return surface;
+}
+
+/* Frame info, with every row padded to 64 bytes plus 64 if asked */
+static void
+bench_info_init (GstVideoInfo * info, GstVideoFormat format, gint w, gint h,
+    gboolean padded)
+{
+  const GstVideoFormatInfo *finfo = gst_video_format_get_info (format);
+  gsize offset = 0;
+  guint p, c;
+
+  gst_video_info_set_format (info, format, w, h);
+  if (!padded)
+    return;
+
+  for (p = 0; p < GST_VIDEO_FORMAT_INFO_N_PLANES (finfo); p++) {
+    gint rows = h;
+
+    for (c = 0; c < GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo); c++) {
+      if (GST_VIDEO_FORMAT_INFO_PLANE (finfo, c) == p)
+        rows = GST_VIDEO_SUB_SCALE (GST_VIDEO_FORMAT_INFO_H_SUB (finfo, c), h);
+    }
+    info->stride[p] = GST_ROUND_UP_64 (info->stride[p]) + 64;
+    info->offset[p] = offset;
+    offset += (gsize) info->stride[p] * rows;
+  }
+  info->size = offset;
+}
+
+/* A frame of random samples, with the unused bits of 16 bit samples
+ * cleared like a decoder leaves them */
+static GstBuffer *
+bench_frame_new (const GstVideoInfo * info)
+{
+  GstBuffer *buffer = gst_buffer_new_allocate (NULL, info->size, NULL);
+  guint depth = GST_VIDEO_INFO_COMP_DEPTH (info, 0);
+  GstMapInfo map;
+  guint32 seed = 12345;
+  gsize i;
+
+  gst_buffer_map (buffer, &map, GST_MAP_WRITE);
+  for (i = 0; i < map.size; i++) {
+    seed = seed * 1103515245 + 12345;
+    map.data[i] = seed >> 24;
+  }
+  if (depth > 8) {
+    guint16 mask = ((1 << depth) - 1)
+        << GST_VIDEO_FORMAT_INFO_SHIFT (info->finfo, 0);
+    guint16 *samples = (guint16 *) map.data;
+
+    for (i = 0; i < map.size / 2; i++)
+      samples[i] &= mask;
+  }
+  gst_buffer_unmap (buffer, &map);
+
+  return buffer;
+}
+
+/* Queues a sprite like the element does, wrapping around the right and
+ * bottom edge */
+static guint
+bench_place (GstLogoPlacement * placements, const GstLogoSprite * sprite,
+    gint x, gint y, guint alpha, gint width, gint height)
+{
+  guint n = 0;
+
+  x = ((x % width) + width) % width;
+  y = ((y % height) + height) % height;
+  placements[n++] = (GstLogoPlacement) {
+  sprite, x, y, alpha};
+  if (x + sprite->width > width)
+    placements[n++] = (GstLogoPlacement) {
+    sprite, x - width, y, alpha};
+  if (y + sprite->height > height) {
+    placements[n++] = (GstLogoPlacement) {
+    sprite, x, y - height, alpha};
+    if (x + sprite->width > width)
+      placements[n++] = (GstLogoPlacement) {
+      sprite, x - width, y - height, alpha};
+  }
+  return n;
+}
+
+/* Address of byte @x of row @y of a plane, resolving the tiles of tiled
+ * formats */
+static guint8 *
+bench_sample (GstVideoFrame * frame, guint p, gint x, gint y)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  guint8 *data = GST_VIDEO_FRAME_PLANE_DATA (frame, p);
+  gint stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, p);
+  guint tile;
+  gint tw, th;
+
+  if (!GST_VIDEO_FORMAT_INFO_IS_TILED (finfo))
+    return data + (gsize) y * stride + x;
+
+#if GST_CHECK_VERSION(1, 22, 0)
+  tw = GST_VIDEO_FORMAT_INFO_TILE_INFO (finfo, p)->stride;
+  th = GST_VIDEO_FORMAT_INFO_TILE_INFO (finfo, p)->height;
+#else
+  tw = 1 << GST_VIDEO_FORMAT_INFO_TILE_WS (finfo);
+  th = 1 << GST_VIDEO_FORMAT_INFO_TILE_HS (finfo);
+#endif
+  tile = gst_video_tile_get_index (GST_VIDEO_FORMAT_INFO_TILE_MODE (finfo),
+      x / tw, y / th, GST_VIDEO_TILE_X_TILES (stride),
+      GST_VIDEO_TILE_Y_TILES (stride));
+
+  return data + (gsize) tile * tw * th + (y % th) * tw + x % tw;
+}
+
+/* Blends one luma or R, G or B sample in linear light */
+static guint
+bench_reference_linear (const GstLogoLinearTables * linear, guint s, guint d,
+    guint a, guint ga)
+{
+  guint max = (1 << linear->depth) - 1;
+  guint fa = div255 (a * ga);
+  guint light;
+
+  if (fa == 0)
+    return d;
+  if (a < 255)
+    s = MIN (max, (s * 255 + a / 2) / a);
+  light = (linear->decode[s] * fa + linear->decode[d] * (255 - fa) + 127)
+      / 255;
+  return linear->encode[light >> linear->encode_shift];
+}
+
+/* Maps a resampled position to the source position before it and the
+ * weight of the one after it, with pixel centers lined up */
+static void
+bench_reference_map (gint i, gint dst_n, gint src_n, gint * i0, guint * f)
+{
+  gint64 pos = ((gint64) (2 * i + 1) * src_n << 16) / (2 * dst_n) - 32768;
+
+  pos = MAX (pos, 0);
+  *i0 = pos >> 16;
+  *f = (pos & 0xffff) >> 8;
+  if (*i0 >= src_n - 1) {
+    *i0 = src_n - 1;
+    *f = 0;
+  }
+}
+
+/* Reads one sample of a plane resampled to @dst_w x @dst_h samples: the
+ * premultiplied value bits and the coverage */
+static void
+bench_reference_fetch (const GstLogoSpritePlane * plane, gint dst_w,
+    gint dst_h, gint c, gint r, guint depth, guint * s, guint * a)
+{
+  guint v[4], cov[4], fx, fy, top, bottom, k;
+  gsize at[4];
+  gint x0, y0;
+
+  bench_reference_map (c / (gint) plane->pstride, dst_w / plane->pstride,
+      plane->width / plane->pstride, &x0, &fx);
+  bench_reference_map (r, dst_h, plane->height, &y0, &fy);
+  x0 = x0 * plane->pstride + c % plane->pstride;
+  at[0] = (gsize) y0 * plane->width + x0;
+  at[1] = at[0] + (fx > 0 ? plane->pstride : 0);
+  at[2] = at[0] + (fy > 0 ? plane->width : 0);
+  at[3] = at[2] + (fx > 0 ? plane->pstride : 0);
+
+  for (k = 0; k < 4; k++) {
+    cov[k] = plane->alpha[at[k]];
+    v[k] = plane->bytes == 2 ?
+        ((const guint16 *) plane->pixels)[at[k]] >> plane->shift :
+        plane->pixels[at[k]];
+  }
+  top = cov[0] * (256 - fx) + cov[1] * fx;
+  bottom = cov[2] * (256 - fx) + cov[3] * fx;
+  *a = (top * (256 - fy) + bottom * fy + 32768) >> 16;
+  top = v[0] * (256 - fx) + v[1] * fx;
+  bottom = v[2] * (256 - fx) + v[3] * fx;
+  *s = MIN ((top * (256 - fy) + bottom * fy + 32768) >> 16, *a << (depth - 8));
+}
+
+/* The scalar reference: every sample of every placement, in stacking order,
+ * with the arithmetic of the kernels and no span index. Placements of
+ * another size are resampled sample by sample from their mip level. */
+static void
+bench_reference_blend (const GstLogoPlacement * placements, guint n,
+    GstVideoFrame * frame, GstLogoBlendSpace space)
+{
+  guint depth = GST_VIDEO_INFO_COMP_DEPTH (&frame->info, 0);
+  guint i, p;
+
+  for (i = 0; i < n; i++) {
+    const GstLogoSprite *sprite = placements[i].sprite;
+    guint ga = placements[i].alpha;
+    gint width = placements[i].width > 0 ? placements[i].width : sprite->width;
+    gint height = placements[i].height > 0 ?
+        placements[i].height : sprite->height;
+    gboolean resampled = width != sprite->width || height != sprite->height;
+
+    while (resampled && sprite->mip != NULL && sprite->mip->width >= width
+        && sprite->mip->height >= height)
+      sprite = sprite->mip;
+
+    for (p = 0; p < sprite->n_planes; p++) {
+      const GstLogoSpritePlane *plane = &sprite->planes[p];
+      const GstLogoLinearTables *linear = NULL;
+      gint frame_w = GST_VIDEO_SUB_SCALE (plane->x_sub,
+          GST_VIDEO_FRAME_WIDTH (frame)) * plane->pstride;
+      gint frame_h = GST_VIDEO_SUB_SCALE (plane->y_sub,
+          GST_VIDEO_FRAME_HEIGHT (frame));
+      gint px = (placements[i].x >> plane->x_sub) * (gint) plane->pstride;
+      gint py = placements[i].y >> plane->y_sub;
+      gint plane_w = GST_VIDEO_SUB_SCALE (plane->x_sub, width) * plane->pstride;
+      gint plane_h = GST_VIDEO_SUB_SCALE (plane->y_sub, height);
+      gint r, c;
+
+      if (space == GST_LOGO_BLEND_SPACE_LINEAR)
+        linear = gst_logo_color_linear_get (&frame->info.colorimetry,
+            GST_VIDEO_INFO_IS_RGB (&frame->info),
+            GST_VIDEO_INFO_COMP_DEPTH (&frame->info, 0));
+
+      for (r = MAX (0, -py); r < plane_h && py + r < frame_h; r++) {
+        for (c = MAX (0, -px); c < plane_w && px + c < frame_w; c++) {
+          guint8 *d = bench_sample (frame, p, (px + c) * plane->bytes,
+              py + r);
+          gboolean light = linear != NULL
+              && (plane->linear_mask & (1 << (c % plane->pstride)));
+          guint a, s;
+
+          bench_reference_fetch (plane, plane_w, plane_h, c, r, depth, &s,
+              &a);
+          if (light && plane->bytes == 2) {
+            guint16 *w = (guint16 *) d;
+
+            *w = bench_reference_linear (linear, s, *w >> plane->shift, a,
+                ga) << plane->shift;
+          } else if (light) {
+            *d = bench_reference_linear (linear, s, *d, a, ga);
+          } else if (plane->bytes == 2) {
+            guint16 *w = (guint16 *) d;
+            guint v = *w >> plane->shift;
+
+            if (ga == 255)
+              v = s + (v * (255 - a) + 127) / 255;
+            else
+              v = (s * ga + 127) / 255
+                  + (v * (255 - div255 (a * ga)) + 127) / 255;
+            *w = v << plane->shift;
+          } else if (ga == 255) {
+            *d = s + div255 (*d * (255 - a));
+          } else {
+            *d = div255 (s * ga) + div255 (*d * (255 - div255 (a * ga)));
+          }
+        }
+      }
+    }
+  }
+}
+
+/* Places the logo for iteration @i of a mode, drawing a rotated sprite
+ * into @rotated when the mode needs one */
+static guint
+bench_mode_place (BenchMode mode, guint i, cairo_surface_t * surface,
+    const GstLogoSprite * sprite, GstLogoSprite ** rotated, guint alpha,
+    const GstVideoInfo * info, GstLogoPlacement * placements)
+{
+  gint width = GST_VIDEO_INFO_WIDTH (info);
+  gint height = GST_VIDEO_INFO_HEIGHT (info);
+
+  switch (mode) {
+    case MODE_SCROLL:
+      /* Starts across the right edge so the wrap is covered */
+      return bench_place (placements, sprite,
+          width - sprite->width / 2 + (gint) i * 7, 40, alpha, width, height);
+    case MODE_ROTATE:
+      *rotated = gst_logo_sprite_new_transformed (surface, 37.0 + i * 3.0,
+          1.0, sprite->format, &sprite->colorimetry);
+      return bench_place (placements, *rotated, width / 2, height / 2, alpha,
+          width, height);
+    case MODE_ZOOM:
+      /* A new size every iteration, from a third of the logo up to one and
+       * a half times its size, resampled from the mip pyramid */
+    {
+      gdouble scale = 0.3 + (i % 25) * 0.05;
+      gint w = MAX (1, (gint) (sprite->width * scale));
+      gint h = MAX (1, (gint) (sprite->height * scale));
+
+      placements[0] = (GstLogoPlacement) {
+      sprite, (width - w) / 2, (height - h) / 2, alpha, w, h};
+      return 1;
+    }
+    default:
+      return bench_place (placements, sprite, width - sprite->width - 20, 20,
+          alpha, width, height);
+  }
+}
+
+/* Blends one case with the kernels and the reference into two copies of
+ * the same frame and compares them byte for byte */
+static gboolean
+bench_check (BenchMode mode, cairo_surface_t * surface,
+    const GstLogoSprite * sprite, guint alpha, const GstVideoInfo * info,
+    GstLogoBlendSpace space, GstBuffer * pristine)
+{
+  GstBuffer *a = gst_buffer_copy_deep (pristine);
+  GstBuffer *b = gst_buffer_copy_deep (pristine);
+  GstLogoSprite *rotated = NULL;
+  GstLogoPlacement placements[4];
+  GstVideoFrame fa, fb;
+  GstMapInfo ma, mb;
+  gboolean exact;
+  guint n;
+
+  n = bench_mode_place (mode, 1, surface, sprite, &rotated, alpha, info,
+      placements);
+  gst_video_frame_map (&fa, info, a, GST_MAP_READWRITE);
+  gst_video_frame_map (&fb, info, b, GST_MAP_READWRITE);
+  gst_logo_sprite_blend_layers (placements, n, &fa, space, NULL);
+  bench_reference_blend (placements, n, &fb, space);
+  gst_video_frame_unmap (&fa);
+  gst_video_frame_unmap (&fb);
+
+  gst_buffer_map (a, &ma, GST_MAP_READ);
+  gst_buffer_map (b, &mb, GST_MAP_READ);
+  exact = ma.size == mb.size && memcmp (ma.data, mb.data, ma.size) == 0;
+  gst_buffer_unmap (a, &ma);
+  gst_buffer_unmap (b, &mb);
+
+  if (rotated != NULL)
+    gst_logo_sprite_free (rotated);
+  gst_buffer_unref (a);
+  gst_buffer_unref (b);
+  return exact;
+}
+
+/* Runs a case for about @seconds and returns the iterations and the time
+ * taken in nanoseconds */
+static guint
+bench_time (BenchMode mode, cairo_surface_t * surface,
+    const GstLogoSprite * sprite, guint alpha, const GstVideoInfo * info,
+    GstLogoBlendSpace space, GstBuffer * buffer, gdouble seconds,
+    gint64 * elapsed)
+{
+  GstLogoPlacement placements[4];
+  GstVideoFrame frame;
+  gint64 start, deadline;
+  guint i = 0;
+
+  gst_video_frame_map (&frame, info, buffer, GST_MAP_READWRITE);
+  start = g_get_monotonic_time ();
+  deadline = start + (gint64) (seconds * G_USEC_PER_SEC);
+  do {
+    GstLogoSprite *rotated = NULL;
+    guint n = bench_mode_place (mode, i, surface, sprite, &rotated, alpha,
+        info, placements);
+
+    gst_logo_sprite_blend_layers (placements, n, &frame, space, NULL);
+    if (rotated != NULL)
+      gst_logo_sprite_free (rotated);
+    i++;
+  } while (i < 3 || g_get_monotonic_time () < deadline);
+  *elapsed = (g_get_monotonic_time () - start) * 1000;
+  gst_video_frame_unmap (&frame);
+
+  return i;
+}
+
+/* Runs every case of one format, printing a row per case */
+static void
+bench_format (GstVideoFormat format, GstLogoBlendSpace space, gboolean json,
+    gdouble seconds, gboolean * first, guint * failures)
+{
+  const gchar *space_name = space == GST_LOGO_BLEND_SPACE_LINEAR ?
+      "linear" : "gamma";
+  const GstVideoFormatInfo *finfo = gst_video_format_get_info (format);
+  guint r, padded, l, pr, m, a;
+
+  for (r = 0; r < G_N_ELEMENTS (resolutions); r++) {
+    for (padded = 0; padded < 2; padded++) {
+      GstVideoInfo info;
+      GstBuffer *pristine, *buffer;
+
+      /* The stride of a tiled plane counts tiles, there is no padding */
+      if (padded && GST_VIDEO_FORMAT_INFO_IS_TILED (finfo))
+        continue;
+
+      bench_info_init (&info, format, resolutions[r][0],
+          resolutions[r][1], padded);
+      pristine = bench_frame_new (&info);
+      buffer = gst_buffer_copy_deep (pristine);
+
+      for (l = 0; l < G_N_ELEMENTS (logo_sizes); l++) {
+        for (pr = 0; pr < N_PROFILES; pr++) {
+          gint lw = logo_sizes[l][0], lh = logo_sizes[l][1];
+          cairo_surface_t *surface = bench_logo_new (pr, lw, lh);
+          GstLogoSprite *sprite = gst_logo_sprite_new_from_surface (surface,
+              format, &info.colorimetry);
+
+          gst_logo_sprite_add_mips (sprite, surface);
+
+          for (m = 0; m < N_MODES; m++) {
+            for (a = 0; a < G_N_ELEMENTS (alphas); a++) {
+              gboolean exact = bench_check (m, surface, sprite, alphas[a],
+                  &info, space, pristine);
+              gint64 elapsed;
+              guint n = bench_time (m, surface, sprite, alphas[a], &info,
+                  space, buffer, seconds, &elapsed);
+              gdouble ns_per_pixel = (gdouble) elapsed / n / (lw * lh);
+              gdouble fps = n * 1e9 / MAX (elapsed, 1);
+
+              if (!exact)
+                (*failures)++;
+              if (json)
+                g_print ("%s  {\"format\":\"%s\",\"resolution\":\"%dx%d\","
+                    "\"stride\":%d,\"logo\":\"%dx%d\",\"profile\":\"%s\",\"mode\":\"%s\","
+                    "\"kernel\":\"%s\",\"space\":\"%s\",\"alpha\":%u,"
+                    "\"iterations\":%u,"
+                    "\"ns_per_pixel\":%.3f,\"frames_per_s\":%.1f,"
+                    "\"bit_exact\":%s}", *first ? "" : ",\n",
+                    gst_video_format_to_string (format), resolutions[r][0], resolutions[r][1], info.stride[0],
+                    lw, lh, profile_names[pr], mode_names[m],
+                    gst_logo_sprite_kernel_name (), space_name, alphas[a], n,
+                    ns_per_pixel, fps, exact ? "true" : "false");
+              else
+                g_print ("%s,%dx%d,%d,%dx%d,%s,%s,%s,%s,%u,%u,%.3f,%.1f,%s\n",
+                    gst_video_format_to_string (format), resolutions[r][0], resolutions[r][1], info.stride[0],
+                    lw, lh, profile_names[pr], mode_names[m],
+                    gst_logo_sprite_kernel_name (), space_name, alphas[a], n,
+                    ns_per_pixel, fps, exact ? "yes" : "no");
+              *first = FALSE;
+            }
+          }
+          gst_logo_sprite_free (sprite);
+          cairo_surface_destroy (surface);
+        }
+      }
+      gst_buffer_unref (buffer);
+      gst_buffer_unref (pristine);
+    }
+  }
+
+}
+
+int
+main (int argc, char *argv[])
+{
+  gboolean json = FALSE, first = TRUE;
+  gdouble seconds = DFLT_CASE_TIME;
+  GstVideoFormat only = GST_VIDEO_FORMAT_UNKNOWN;
+  GstLogoBlendSpace space = GST_LOGO_BLEND_SPACE_GAMMA;
+  guint failures = 0;
+  guint f;
+  gint i;
+
+  gst_init (&argc, &argv);
+  for (i = 1; i < argc; i++) {
+    if (strcmp (argv[i], "--json") == 0) {
+      json = TRUE;
+    } else if (strcmp (argv[i], "--time") == 0 && i + 1 < argc) {
+      seconds = g_ascii_strtod (argv[++i], NULL);
+    } else if (strcmp (argv[i], "--format") == 0 && i + 1 < argc) {
+      only = gst_video_format_from_string (argv[++i]);
+      if (!gst_logo_sprite_supports_format (only)) {
+        g_printerr ("Unsupported format %s\n", argv[i]);
+        return 2;
+      }
+    } else if (strcmp (argv[i], "--space") == 0 && i + 1 < argc) {
+      space = strcmp (argv[++i], "linear") == 0 ?
+          GST_LOGO_BLEND_SPACE_LINEAR : GST_LOGO_BLEND_SPACE_GAMMA;
+    } else {
+      g_printerr ("Usage: %s [--json] [--time SECONDS] [--format FORMAT] "
+          "[--space gamma|linear]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  if (json)
+    g_print ("[\n");
+  else
+    g_print ("format,resolution,stride,logo,profile,mode,kernel,space,alpha,iterations,"
+        "ns_per_pixel,frames_per_s,bit_exact\n");
+
+  if (only != GST_VIDEO_FORMAT_UNKNOWN) {
+    bench_format (only, space, json, seconds, &first, &failures);
+  } else {
+    for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+      /* 16 bit formats are only blended in native endianness */
+      if (gst_logo_sprite_supports_format (formats[f]))
+        bench_format (formats[f], space, json, seconds, &first, &failures);
+    }
+  }
+
+  if (json)
+    g_print ("\n]\n");
+  if (failures > 0)
+    g_printerr ("%u cases differ from the scalar reference\n", failures);
+
+  return failures > 0;
+}
@@ -86,6 +86,9 @@
 GST_DEBUG_CATEGORY_STATIC (gst_insert_logo_debug);
 #define GST_CAT_DEFAULT gst_insert_logo_debug
 
+/* Quark of the tracer hooks set on an element */
+static GQuark trace_quark;
+
 /* Filter signals and args */
 enum
 {
@@ -104,17 +107,51 @@ enum
   PROP_STRICT_MODE,
   PROP_ALPHA,
   PROP_LOGO,
+  PROP_LOGO_SCALE,
+  PROP_LAYERS,
+  PROP_KEYFRAMES,
+  PROP_PATH,
+  PROP_REPEAT,
+  PROP_ZOOM,
+  PROP_LOGO_FPS,
+  PROP_LOGO_MEMORY,
+  PROP_PLAYLIST,
+  PROP_PLAYLIST_FILE,
+  PROP_CROSSFADE,
+  PROP_SCHEDULE,
+  PROP_X,
+  PROP_Y,
+  PROP_QOS,
+  PROP_STATS,
+  PROP_STATS_INTERVAL,
+  PROP_BLEND_SPACE,
+  PROP_SHADOW_X,
+  PROP_SHADOW_Y,
+  PROP_SHADOW_BLUR,
+  PROP_SHADOW_COLOR,
+  PROP_OUTLINE_WIDTH,
+  PROP_OUTLINE_COLOR,
+  PROP_GLOW_RADIUS,
+  PROP_GLOW_COLOR,
+  PROP_AUTO_CONTRAST,
+  PROP_AUTO_CONTRAST_INTERVAL,
+  PROP_COVERS,
+  PROP_TICKER,
+  PROP_TICKER_Y,
+  PROP_TICKER_SPEED,
+  PROP_TICKER_BACKGROUND,
   N_PROPERTIES
 };
 
 /* the capabilities of the inputs and outputs.
  *
- * describe the real formats here.
+ * The logo is blended in place in every format the sprites can be laid
+ * out for, so no conversion is needed in front of the element.
  */
 static GstStaticPadTemplate sink_factory = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
-    GST_STATIC_CAPS ("video/x-raw, format=NV12")
+    GST_STATIC_CAPS ("video/x-raw, format=(string)" GST_LOGO_SPRITE_FORMATS)
     );
 
 static GstStaticPadTemplate src_factory = GST_STATIC_PAD_TEMPLATE ("src",
@@ -129,6 +166,8 @@ G_DEFINE_TYPE (GstInsertLogo, gst_insert_logo, GST_TYPE_ELEMENT);
 GST_ELEMENT_REGISTER_DEFINE (insert_logo, "insertlogo", GST_RANK_NONE,
     GST_TYPE_INSERTLOGO);
 
+static void gst_insert_logo_finalize (GObject * object);
+
 /* Property setter and getter functions */
 static void gst_insert_logo_set_property (GObject * object,
     guint prop_id, const GValue * value, GParamSpec * pspec);
@@ -139,21 +178,33 @@ static void gst_insert_logo_get_property (GObject * object,
 static gboolean gst_insert_logo_sink_event (GstPad * pad,
     GstObject * parent, GstEvent * event);
 
+/* Src pad event handler */
+static gboolean gst_insert_logo_src_event (GstPad * pad,
+    GstObject * parent, GstEvent * event);
+
 /* Chain function for processing buffers */
 static GstFlowReturn gst_insert_logo_chain (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
 
 /* Functions for imposing, scrolling, and rotating the logo */
-static void gst_insert_logo_impose_logo(GstInsertLogo *filter, guint8 *y_pixels, 
-		guint8 *uv_pixels, guint y_stride, guint uv_stride);
-static void gst_insert_logo_scroll_logo(GstInsertLogo *filter, guint8 *y_pixels, 
-		guint8 *uv_pixels, guint y_stride, guint uv_stride);
-static void gst_insert_logo_rotate_logo(GstInsertLogo *filter, guint8 *y_pixels, 
-		guint8 *uv_pixels, guint y_stride, guint uv_stride);
+static GstFlowReturn gst_insert_logo_impose_logo(GstInsertLogo *filter, GstVideoFrame *frame,
+		GstLogoImage *logo);
+static GstFlowReturn gst_insert_logo_scroll_logo(GstInsertLogo *filter, GstVideoFrame *frame,
+		GstLogoImage *logo);
+static GstFlowReturn gst_insert_logo_rotate_logo(GstInsertLogo *filter, GstVideoFrame *frame,
+		GstLogoImage *logo);
 
 /* Helper functions */
 static void gst_insert_logo_set_logo(GstInsertLogo *filter);
 static void gst_insert_logo_check_property_validation(GstInsertLogo *filter);
+static void gst_insert_logo_update_source(GstInsertLogo *filter);
+static guint gst_insert_logo_schedule_level(GstInsertLogo *filter);
+static void gst_insert_logo_update_qos(GstInsertLogo *filter, GstBuffer *buf,
+		GstClockTime stream_time, GstClockTime process_time);
+static void gst_insert_logo_post_stats(GstInsertLogo *filter);
+static GstFlowReturn gst_insert_logo_push(GstInsertLogo *filter, GstBuffer *buf);
+static GstStateChangeReturn gst_insert_logo_change_state (GstElement * element,
+    GstStateChange transition);
 
 /**
  * gst_insert_logo_class_init:
@@ -172,6 +223,9 @@ gst_insert_logo_class_init (GstInsertLogoClass * klass)
 
   gobject_class->set_property = gst_insert_logo_set_property;
   gobject_class->get_property = gst_insert_logo_get_property;
+  gobject_class->finalize = gst_insert_logo_finalize;
+  gstelement_class->change_state = gst_insert_logo_change_state;
+  trace_quark = g_quark_from_static_string (GST_LOGO_TRACE_QDATA);
 
   /* Install properties */
   g_object_class_install_property (gobject_class, PROP_SILENT,
@@ -203,14 +257,196 @@ gst_insert_logo_class_init (GstInsertLogoClass * klass)
           FALSE, G_PARAM_READWRITE));
   
   g_object_class_install_property(gobject_class,PROP_ALPHA,
-      g_param_spec_int ("alpha","Alpha","Set alpha (opacity) blending on plugin. Range is 0 to 100", G_MININT, G_MAXINT, 
-      		-1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+      g_param_spec_int ("alpha","Alpha","Set alpha (opacity) blending on plugin. Range is 0 to 100. Controllable, 0 passes the frames through", 0, 100, 
+      		DFLT_ALPHA, G_PARAM_READWRITE | GST_PARAM_CONTROLLABLE | G_PARAM_STATIC_STRINGS));
   
   g_object_class_install_property (gobject_class, PROP_LOGO,
     g_param_spec_string ("logo-file", "Logo",
-              "Path of logo file. If not provided, plugin will take default logo (Moschip logo). \n\t\t\tLogo should be present in current directory with name 'moschip.png'.",
+              "Path of logo file. If not provided, plugin will take default logo (Moschip logo). \n\t\t\tLogo should be present in current directory with name 'moschip.png'. \n\t\t\tAnimated logos are an APNG file or a numbered sequence such as 'logo_%03d.png'.",
+              NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_LOGO_SCALE,
+    g_param_spec_string ("logo-scale", "Logo Scale",
+              "Resample the logo per output resolution. (off, fraction of the frame height e.g. '0.08', or absolute size 'WxH' where 0 keeps the aspect ratio e.g. '160x0')",
+              DFLT_LOGO_SCALE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_LAYERS,
+    gst_param_spec_array ("layers", "Layers",
+        "Additional overlays blended on top of the logo in the same pass, bottom first. One structure per layer, e.g. '<\"rating,logo-file=rating.png,x=20,y=20,alpha=80\", \"live,logo-file=live.png,scrolling=rtl,speed=fast\">'. Fields are logo-file, x, y, alpha, scrolling, rotation, speed, logo-scale and the effect properties shadow-x to glow-color. Text layers take text (with %T for the timecode and %C for the clock), font, font-size and color instead of logo-file.",
+        g_param_spec_boxed ("layer", "Layer", "Layer description",
+            GST_TYPE_STRUCTURE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS),
+        G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_KEYFRAMES,
+    gst_param_spec_array ("keyframes", "Keyframes",
+        "Animation keyframes of the logo by running time, e.g. '<\"kf,t=0,x=0,y=40,alpha=0\", \"kf,t=1.5,x=200,alpha=100,ease=out\">'. Fields are t (seconds), x, y, angle, alpha, scale and ease (linear, in, out, in-out); missing fields keep the previous value. Overrides path, scrolling and rotation.",
+        g_param_spec_boxed ("keyframe", "Keyframe", "Keyframe description",
+            GST_TYPE_STRUCTURE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS),
+        G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_PATH,
+    g_param_spec_string ("path", "Path",
+              "Move the logo between the frame edges at the animation speed. (off, horizontal, vertical, diagonal)",
+              DFLT_PATH, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_REPEAT,
+    g_param_spec_string ("repeat", "Repeat",
+              "What the path or keyframe animation does at its end. (once, loop, bounce)",
+              DFLT_REPEAT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_ZOOM,
+    g_param_spec_string ("zoom", "Zoom",
+              "Zoom the logo around its center at the animation speed, resampled from a mip pyramid every frame. pulse grows and shrinks it, in grows it from nothing once. Ignored while path, scrolling or rotation is enabled. (off, pulse, in)",
+              DFLT_ZOOM, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_LOGO_FPS,
+    g_param_spec_double ("logo-fps", "Logo FPS",
+              "Frame rate of numbered logo sequences such as 'logo_%03d.png', also used for APNG frames without delay.",
+              1.0, 120.0, DFLT_LOGO_FPS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_LOGO_MEMORY,
+    g_param_spec_uint ("logo-memory", "Logo Memory",
+              "Memory in MiB for decoded frames of an animated logo. Longer animations are decoded ahead of playback in the background.",
+              1, 4096, DFLT_LOGO_MEMORY, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_PLAYLIST,
+    gst_param_spec_array ("playlist", "Playlist",
+        "Sponsor logos shown in turn instead of the logo, starting over at the end, e.g. '<\"a,logo-file=a.png,duration=10\", \"b,logo-file=b.png,duration=15\">'. Fields are logo-file and duration in seconds.",
+        g_param_spec_boxed ("entry", "Entry", "Playlist entry",
+            GST_TYPE_STRUCTURE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS),
+        G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_PLAYLIST_FILE,
+    g_param_spec_string ("playlist-file", "Playlist File",
+              "File with one logo file and its duration in seconds per line, used instead of the playlist property and read again when it is modified.",
+              NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_CROSSFADE,
+    g_param_spec_double ("crossfade", "Crossfade",
+              "Seconds at the end of every playlist logo during which the next one fades in. 0 cuts.",
+              0.0, 10.0, DFLT_CROSSFADE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_SCHEDULE,
+    gst_param_spec_array ("schedule", "Schedule",
+        "Time windows in which the overlay is shown, buffers outside of them pass through untouched, e.g. '<\"intro,start=0,end=30,fade=1\", \"news,from=19:00,to=19:30\">'. Fields are start and end in seconds of running time or from and to as local time HH:MM[:SS], plus fade, fade-in and fade-out in seconds. Empty shows the overlay all the time. An 'insert-logo-control' custom downstream event with an 'enabled' boolean and an optional 'fade' in seconds overrides the schedule, without 'enabled' it goes back to the schedule.",
+        g_param_spec_boxed ("window", "Window", "Window description",
+            GST_TYPE_STRUCTURE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS),
+        G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_X,
+      g_param_spec_int ("x", "X", "Horizontal position of the logo, same as the first coordinate. Controllable. Until x or y is set the logo keeps its default position",
+          0, MAX_COORDINATE, 0, G_PARAM_READWRITE | GST_PARAM_CONTROLLABLE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_Y,
+      g_param_spec_int ("y", "Y", "Vertical position of the logo, same as the second coordinate. Controllable. Until x or y is set the logo keeps its default position",
+          0, MAX_COORDINATE, 0, G_PARAM_READWRITE | GST_PARAM_CONTROLLABLE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_QOS,
+      g_param_spec_boolean ("qos", "QoS", "Step down the quality of the animations when frames are late: coarse rotation, frozen animation, static logo. Posts a QoS message at every step",
+          DFLT_QOS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Blend cost of this instance: frames, passthrough-frames, opaque-, mixed-, blended- and faded-pixels, ns-per-frame-p50, -p99 and -max, sprite-cache-hits and -misses, first-frame-latency and kernel",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_STATS_INTERVAL,
+      g_param_spec_uint ("stats-interval", "Statistics Interval",
+          "Post the stats as an 'insert-logo-stats' element message every this many milliseconds. 0 disables the messages",
+          0, G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_BLEND_SPACE,
+      g_param_spec_enum ("blend-space", "Blend Space",
+          "Blend the gamma encoded samples, or luma and RGB in linear light so anti-aliased edges and translucent logos do not come out too dark. Chroma is always blended as it is",
+          GST_TYPE_LOGO_BLEND_SPACE, DFLT_BLEND_SPACE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_SHADOW_X,
+      g_param_spec_int ("shadow-x", "Shadow X",
+          "Horizontal offset of the drop shadow in pixels. The shadow is drawn when it is offset or blurred",
+          -GST_LOGO_EFFECT_MAX_SIZE, GST_LOGO_EFFECT_MAX_SIZE, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_SHADOW_Y,
+      g_param_spec_int ("shadow-y", "Shadow Y",
+          "Vertical offset of the drop shadow in pixels",
+          -GST_LOGO_EFFECT_MAX_SIZE, GST_LOGO_EFFECT_MAX_SIZE, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_SHADOW_BLUR,
+      g_param_spec_uint ("shadow-blur", "Shadow Blur",
+          "Blur radius of the drop shadow in pixels",
+          0, GST_LOGO_EFFECT_MAX_SIZE, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_SHADOW_COLOR,
+      g_param_spec_uint ("shadow-color", "Shadow Color",
+          "Colour of the drop shadow as 0xAARRGGBB",
+          0, G_MAXUINT32, GST_LOGO_EFFECT_SHADOW_COLOR,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_OUTLINE_WIDTH,
+      g_param_spec_uint ("outline-width", "Outline Width",
+          "Width of the outline around the logo in pixels, 0 for none",
+          0, GST_LOGO_EFFECT_MAX_SIZE, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_OUTLINE_COLOR,
+      g_param_spec_uint ("outline-color", "Outline Color",
+          "Colour of the outline as 0xAARRGGBB",
+          0, G_MAXUINT32, GST_LOGO_EFFECT_OUTLINE_COLOR,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_GLOW_RADIUS,
+      g_param_spec_uint ("glow-radius", "Glow Radius",
+          "Radius of the glow around the logo in pixels, 0 for none",
+          0, GST_LOGO_EFFECT_MAX_SIZE, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_GLOW_COLOR,
+      g_param_spec_uint ("glow-color", "Glow Color",
+          "Colour of the glow as 0xAARRGGBB",
+          0, G_MAXUINT32, GST_LOGO_EFFECT_GLOW_COLOR,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_AUTO_CONTRAST,
+    g_param_spec_string ("auto-contrast", "Auto Contrast",
+              "Adapt the logo to the light of the video under it. opacity makes a logo that glares on a flat background more transparent, variant fades to a light or dark variant of the logo where that stands out better. (off, opacity, variant)",
+              DFLT_AUTO_CONTRAST, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_AUTO_CONTRAST_INTERVAL,
+    g_param_spec_uint ("auto-contrast-interval", "Auto Contrast Interval",
+              "Frames from one measurement of the video under the logo to the next",
+              1, G_MAXUINT, DFLT_CONTRAST_INTERVAL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_COVERS,
+    gst_param_spec_array ("covers", "Covers",
+        "Regions of the video blurred or pixelated in place before the logo is blended, e.g. to hide a logo burned in upstream, e.g. '<\"bug,x=1700,y=40,width=180,height=90,radius=12\", \"plate,x=100,y=600,width=200,height=60,mode=pixelate,block=20\">'. Fields are x, y, width and height in pixels, mode (blur, pixelate), radius and passes of the blur and block size of the pixelation.",
+        g_param_spec_boxed ("cover", "Cover", "Cover region description",
+            GST_TYPE_STRUCTURE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS),
+        G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_TICKER,
+    g_param_spec_string ("ticker", "Ticker",
+              "Path of a pre-rendered PNG strip crawled from right to left through a band of the frame, starting over once it has left. The strip may be tens of thousands of pixels wide, only the part in the band is converted.",
               NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
   
+  g_object_class_install_property (gobject_class, PROP_TICKER_Y,
+      g_param_spec_int ("ticker-y", "Ticker Y",
+          "Top of the ticker band in pixels, -1 for the bottom of the frame",
+          -1, G_MAXINT, DFLT_VAL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_TICKER_SPEED,
+      g_param_spec_double ("ticker-speed", "Ticker Speed",
+          "Speed of the ticker in pixels per second",
+          1.0, 10000.0, DFLT_TICKER_SPEED, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
+  g_object_class_install_property (gobject_class, PROP_TICKER_BACKGROUND,
+      g_param_spec_uint ("ticker-background", "Ticker Background",
+          "Colour of the ticker band under the strip as 0xAARRGGBB, transparent for none",
+          0, G_MAXUINT32, DFLT_TICKER_BACKGROUND,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  
   /* Set element details */
   gst_element_class_set_details_simple (gstelement_class,
       "InsertLogo",
@@ -246,6 +482,8 @@ gst_insert_logo_init (GstInsertLogo * filter)
 
   /* Create src pad */
   filter->srcpad = gst_pad_new_from_static_template (&src_factory, "src");
+  gst_pad_set_event_function (filter->srcpad,
+      GST_DEBUG_FUNCPTR (gst_insert_logo_src_event));
   GST_PAD_SET_PROXY_CAPS (filter->srcpad);
   gst_element_add_pad (GST_ELEMENT (filter), filter->srcpad);
 
@@ -259,7 +497,7 @@ gst_insert_logo_init (GstInsertLogo * filter)
   filter->logo = NULL;
   filter->strict = DFLT_NOT_BOOL;
   filter->degree = DFLE_ROTATE;
-  filter->alpha = DFLT_VAL;
+  filter->alpha = DFLT_ALPHA;
   filter->dflt = DFLT_BOOL;
   filter->scrlEnable = DFLT_NOT_BOOL;
   filter->scrl_dflt_cord = DFLT_NOT_BOOL;
@@ -268,10 +506,126 @@ gst_insert_logo_init (GstInsertLogo * filter)
   filter->dflt_rotate = DFLT_BOOL;
   filter->dflt_speed = DFLT_BOOL;
   filter->dflt_scrl = DFLT_BOOL;
-  filter->dflt_alpha = DFLT_BOOL;
   filter->rotateEnable = DFLT_NOT_BOOL;
   filter->check_Property_validation = DFLT_NOT_BOOL;
   filter->adjust_y_cord = DFLT_NOT_BOOL;
+  filter->logo_scale = g_strdup (DFLT_LOGO_SCALE);
+  gst_logo_scale_parse (filter->logo_scale, &filter->scale);
+  filter->dflt_logo_scale = DFLT_BOOL;
+  filter->cache = gst_logo_cache_new ();
+  filter->layer_descs = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_structure_free);
+  filter->layers = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_logo_layer_free);
+  filter->invalid_layers = DFLT_NOT_BOOL;
+  filter->placements = g_array_new (FALSE, FALSE, sizeof (GstLogoPlacement));
+  filter->frame_sprites = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_logo_sprite_free);
+  filter->logo_failed = DFLT_NOT_BOOL;
+  gst_segment_init (&filter->segment, GST_FORMAT_TIME);
+  filter->running_time = GST_CLOCK_TIME_NONE;
+  filter->n_frames = 0;
+  filter->path_str = g_strdup (DFLT_PATH);
+  gst_logo_path_parse (filter->path_str, &filter->path);
+  filter->dflt_path = DFLT_BOOL;
+  filter->repeat_str = g_strdup (DFLT_REPEAT);
+  gst_logo_repeat_parse (filter->repeat_str, &filter->repeat);
+  filter->dflt_repeat = DFLT_BOOL;
+  filter->zoom_str = g_strdup (DFLT_ZOOM);
+  gst_logo_zoom_parse (filter->zoom_str, &filter->zoom);
+  filter->dflt_zoom = DFLT_BOOL;
+  filter->keyframe_descs = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_structure_free);
+  filter->invalid_keyframes = DFLT_NOT_BOOL;
+  filter->anim = NULL;
+  filter->anim_dirty = DFLT_BOOL;
+  filter->logo_fps = DFLT_LOGO_FPS;
+  filter->logo_memory = DFLT_LOGO_MEMORY;
+  filter->sequence = gst_logo_sequence_new ();
+  filter->animated = DFLT_NOT_BOOL;
+  filter->playlist_descs = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_structure_free);
+  filter->invalid_playlist = DFLT_NOT_BOOL;
+  filter->playlist_file = NULL;
+  filter->crossfade = DFLT_CROSSFADE;
+  filter->playlist = gst_logo_playlist_new ();
+  filter->fade_logo = NULL;
+  filter->fade_mix = 0;
+  gst_video_info_init (&filter->video_info);
+  filter->schedule_descs = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_structure_free);
+  filter->schedule = g_array_new (FALSE, FALSE, sizeof (GstLogoWindow));
+  filter->invalid_schedule = DFLT_NOT_BOOL;
+  filter->cover_descs = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_structure_free);
+  filter->covers = g_array_new (FALSE, FALSE, sizeof (GstLogoCover));
+  filter->invalid_covers = DFLT_NOT_BOOL;
+  filter->ticker_path = NULL;
+  filter->ticker = gst_logo_ticker_new ();
+  filter->ticker_y = DFLT_VAL;
+  filter->ticker_speed = DFLT_TICKER_SPEED;
+  filter->ticker_background = DFLT_TICKER_BACKGROUND;
+  filter->control = GST_INSERT_LOGO_CONTROL_AUTO;
+  filter->control_fade = 0;
+  filter->control_start = GST_CLOCK_TIME_NONE;
+  filter->control_from = 255;
+  filter->level = 255;
+  filter->qos_enabled = DFLT_QOS;
+  gst_logo_qos_reset (&filter->qos);
+  filter->qos_proportion = 1.0;
+  filter->qos_diff = 0;
+  filter->blend_space = DFLT_BLEND_SPACE;
+  gst_logo_effects_init (&filter->effects);
+  filter->auto_contrast_str = g_strdup (DFLT_AUTO_CONTRAST);
+  gst_logo_contrast_parse (filter->auto_contrast_str, &filter->contrast.mode);
+  gst_logo_contrast_reset (&filter->contrast);
+  filter->dflt_auto_contrast = DFLT_BOOL;
+  filter->contrast_interval = DFLT_CONTRAST_INTERVAL;
+  filter->anim_time = GST_CLOCK_TIME_NONE;
+  memset (filter->transformed, 0, sizeof (filter->transformed));
+  gst_logo_stats_reset (&filter->stats);
+  filter->stats_interval = 0;
+  filter->stats_next = 0;
+  filter->caps_time = 0;
+  filter->trace = NULL;
+}
+
+
+/**
+ * gst_insert_logo_finalize:
+ * @object: a #GstInsertLogo instance
+ *
+ * Free the logo cache and the resources owned by the element.
+ */
+static void
+gst_insert_logo_finalize (GObject * object)
+{
+  GstInsertLogo *filter = GST_INSERTLOGO (object);
+  guint i;
+
+  gst_logo_cache_free (filter->cache);
+  gst_logo_sequence_free (filter->sequence);
+  gst_logo_playlist_free (filter->playlist);
+  g_ptr_array_unref (filter->playlist_descs);
+  g_free (filter->playlist_file);
+  g_ptr_array_unref (filter->schedule_descs);
+  g_array_unref (filter->schedule);
+  g_ptr_array_unref (filter->cover_descs);
+  g_array_unref (filter->covers);
+  gst_logo_ticker_free (filter->ticker);
+  g_free (filter->ticker_path);
+  g_free (filter->logo_scale);
+  g_ptr_array_unref (filter->layer_descs);
+  g_ptr_array_unref (filter->layers);
+  g_array_free (filter->placements, TRUE);
+  g_ptr_array_unref (filter->frame_sprites);
+  g_free (filter->path_str);
+  g_free (filter->repeat_str);
+  g_free (filter->zoom_str);
+  g_free (filter->auto_contrast_str);
+  g_ptr_array_unref (filter->keyframe_descs);
+  gst_logo_anim_free (filter->anim);
+  for (i = 0; i < G_N_ELEMENTS (filter->transformed); i++) {
+    if (filter->transformed[i].sprite != NULL) {
+      gst_logo_sprite_free (filter->transformed[i].sprite);
+      cairo_surface_destroy (filter->transformed[i].surface);
+    }
+  }
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
 
@@ -348,6 +702,7 @@ gst_insert_logo_set_property (GObject * object, guint prop_id,
         filter->speed = g_strdup (g_value_get_string (value));
         g_print ("Speed set to : %s\n", filter->speed);
         filter->dflt_speed = FALSE;
+        filter->anim_dirty = TRUE;
       }
       break;
     case PROP_SCROLL:
@@ -373,9 +728,9 @@ gst_insert_logo_set_property (GObject * object, guint prop_id,
       break;
     case PROP_ALPHA:
       // Set the alpha property
+      // A control binding sets it for every buffer, so only log it
       filter->alpha = g_value_get_int (value);
-      g_print ("Alpha set to : %d", filter->alpha);
-      filter->dflt_alpha = FALSE;
+      GST_LOG_OBJECT (filter, "Alpha set to : %d", filter->alpha);
       break;
     case PROP_LOGO:
       {
@@ -384,8 +739,398 @@ gst_insert_logo_set_property (GObject * object, guint prop_id,
         filter->logo = g_strdup (g_value_get_string (value));
         filter->dfltLogo = FALSE;
         g_print ("Logo argument was changed to %s\n", filter->logo);
+        
+        // Reload the logo if it is changed while streaming
+        if (filter->check_Property_validation) {
+          gst_insert_logo_update_source (filter);
+        }
+        break;
+      }
+    case PROP_LOGO_SCALE:
+      {
+        // Set the logo scale property
+        g_free (filter->logo_scale);
+        filter->logo_scale = g_strdup (g_value_get_string (value));
+        filter->dflt_logo_scale = FALSE;
+        g_print ("Logo scale set to : %s\n", filter->logo_scale);
+        
+        // Rescale the logo if it is changed while streaming
+        if (filter->check_Property_validation &&
+            gst_logo_scale_parse (filter->logo_scale, &filter->scale)) {
+          gst_insert_logo_update_source (filter);
+        }
+        break;
+      }
+    case PROP_LAYERS:
+      {
+        GPtrArray *descs, *layers, *old_descs, *old_layers;
+        guint i;
+
+        descs = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_structure_free);
+        layers = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_logo_layer_free);
+        filter->invalid_layers = FALSE;
+
+        GST_OBJECT_LOCK (filter);
+        old_layers = g_ptr_array_ref (filter->layers);
+        GST_OBJECT_UNLOCK (filter);
+
+        // Build the layers, skipping the ones that are invalid
+        for (i = 0; i < gst_value_array_get_size (value); i++) {
+          const GValue *v = gst_value_array_get_value (value, i);
+          const GstStructure *s;
+          GstLogoLayer *layer;
+
+          if (!GST_VALUE_HOLDS_STRUCTURE (v)) {
+            filter->invalid_layers = TRUE;
+            continue;
+          }
+          s = gst_value_get_structure (v);
+          g_ptr_array_add (descs, gst_structure_copy (s));
+
+          layer = gst_logo_layer_new_from_structure (s);
+          if (layer == NULL) {
+            filter->invalid_layers = TRUE;
+            continue;
+          }
+          // Rasterize text once, sharing the glyphs of the replaced layers
+          gst_logo_layer_load_atlas (layer, old_layers,
+              GST_VIDEO_INFO_FORMAT (&filter->video_info),
+              &GST_VIDEO_INFO_COLORIMETRY (&filter->video_info));
+
+          // Start preparing the layer if the resolution is already known
+          if (filter->frame_width > 0 && filter->frame_height > 0)
+            gst_logo_layer_prepare (layer, filter->frame_width, filter->frame_height,
+                GST_VIDEO_INFO_FORMAT (&filter->video_info),
+                &GST_VIDEO_INFO_COLORIMETRY (&filter->video_info));
+          g_ptr_array_add (layers, layer);
+        }
+        g_print ("Layers set : %u\n", layers->len);
+
+        // The streaming thread holds its own reference while blending
+        g_ptr_array_unref (old_layers);
+        GST_OBJECT_LOCK (filter);
+        old_descs = filter->layer_descs;
+        old_layers = filter->layers;
+        filter->layer_descs = descs;
+        filter->layers = layers;
+        GST_OBJECT_UNLOCK (filter);
+
+        g_ptr_array_unref (old_descs);
+        g_ptr_array_unref (old_layers);
+        break;
+      }
+    case PROP_KEYFRAMES:
+      {
+        GstLogoKeyframe prev = { 0, 0, 0, 0, 100, 1.0, GST_LOGO_EASE_LINEAR };
+        GPtrArray *descs, *old_descs;
+        guint i;
+
+        descs = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_structure_free);
+        filter->invalid_keyframes = FALSE;
+
+        // Keep the valid keyframes, the timeline is built from them per resolution
+        for (i = 0; i < gst_value_array_get_size (value); i++) {
+          const GValue *v = gst_value_array_get_value (value, i);
+          GstLogoKeyframe kf;
+
+          if (!GST_VALUE_HOLDS_STRUCTURE (v) ||
+              !gst_logo_keyframe_parse (gst_value_get_structure (v), &prev, &kf)) {
+            filter->invalid_keyframes = TRUE;
+            continue;
+          }
+          g_ptr_array_add (descs, gst_structure_copy (gst_value_get_structure (v)));
+          prev = kf;
+        }
+        g_print ("Keyframes set : %u\n", descs->len);
+
+        GST_OBJECT_LOCK (filter);
+        old_descs = filter->keyframe_descs;
+        filter->keyframe_descs = descs;
+        filter->anim_dirty = TRUE;
+        GST_OBJECT_UNLOCK (filter);
+
+        g_ptr_array_unref (old_descs);
+        break;
+      }
+    case PROP_PATH:
+      {
+        // Set the path property
+        g_free (filter->path_str);
+        filter->path_str = g_strdup (g_value_get_string (value));
+        filter->dflt_path = FALSE;
+        g_print ("Path set to : %s\n", filter->path_str);
+        if (filter->check_Property_validation &&
+            gst_logo_path_parse (filter->path_str, &filter->path)) {
+          filter->anim_dirty = TRUE;
+        }
+        break;
+      }
+    case PROP_REPEAT:
+      {
+        // Set the repeat property
+        g_free (filter->repeat_str);
+        filter->repeat_str = g_strdup (g_value_get_string (value));
+        filter->dflt_repeat = FALSE;
+        g_print ("Repeat set to : %s\n", filter->repeat_str);
+        if (filter->check_Property_validation &&
+            gst_logo_repeat_parse (filter->repeat_str, &filter->repeat)) {
+          filter->anim_dirty = TRUE;
+        }
+        break;
+      }
+    case PROP_ZOOM:
+      {
+        // Set the zoom property
+        g_free (filter->zoom_str);
+        filter->zoom_str = g_strdup (g_value_get_string (value));
+        filter->dflt_zoom = FALSE;
+        g_print ("Zoom set to : %s\n", filter->zoom_str);
+        if (filter->check_Property_validation &&
+            gst_logo_zoom_parse (filter->zoom_str, &filter->zoom)) {
+          filter->anim_dirty = TRUE;
+        }
+        break;
+      }
+    case PROP_LOGO_FPS:
+      // Set the logo fps property, sequences are indexed again while streaming
+      filter->logo_fps = g_value_get_double (value);
+      g_print ("Logo fps set to : %f\n", filter->logo_fps);
+      if (filter->check_Property_validation) {
+        gst_insert_logo_update_source (filter);
+      }
+      break;
+    case PROP_LOGO_MEMORY:
+      // Set the logo memory property
+      filter->logo_memory = g_value_get_uint (value);
+      g_print ("Logo memory set to : %u MiB\n", filter->logo_memory);
+      if (filter->check_Property_validation) {
+        gst_insert_logo_update_source (filter);
+      }
+      break;
+    case PROP_PLAYLIST:
+      {
+        GPtrArray *descs, *old_descs;
+        GArray *entries;
+        guint i;
+
+        descs = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_structure_free);
+        entries = gst_logo_playlist_entries_new ();
+        filter->invalid_playlist = FALSE;
+
+        // Keep the valid entries, the logos are loaded by the playlist worker
+        for (i = 0; i < gst_value_array_get_size (value); i++) {
+          const GValue *v = gst_value_array_get_value (value, i);
+          GstLogoPlaylistEntry entry;
+
+          if (!GST_VALUE_HOLDS_STRUCTURE (v) ||
+              !gst_logo_playlist_entry_parse (gst_value_get_structure (v), &entry)) {
+            filter->invalid_playlist = TRUE;
+            continue;
+          }
+          g_ptr_array_add (descs, gst_structure_copy (gst_value_get_structure (v)));
+          g_array_append_val (entries, entry);
+        }
+        g_print ("Playlist set : %u\n", entries->len);
+        gst_logo_playlist_set_entries (filter->playlist, entries);
+
+        GST_OBJECT_LOCK (filter);
+        old_descs = filter->playlist_descs;
+        filter->playlist_descs = descs;
+        GST_OBJECT_UNLOCK (filter);
+
+        g_ptr_array_unref (old_descs);
+        break;
+      }
+    case PROP_PLAYLIST_FILE:
+      // Set the playlist file property, checked before it is used
+      g_free (filter->playlist_file);
+      filter->playlist_file = g_strdup (g_value_get_string (value));
+      g_print ("Playlist file set to : %s\n", filter->playlist_file);
+      if (filter->check_Property_validation) {
+        gst_logo_playlist_set_file (filter->playlist, filter->playlist_file);
+      }
+      break;
+    case PROP_CROSSFADE:
+      // Set the crossfade property
+      filter->crossfade = g_value_get_double (value);
+      g_print ("Crossfade set to : %f\n", filter->crossfade);
+      gst_logo_playlist_configure (filter->playlist, &filter->scale,
+          &filter->effects, filter->crossfade * GST_SECOND);
+      break;
+    case PROP_X:
+    case PROP_Y:
+      {
+        gint axis = prop_id == PROP_X ? 0 : 1;
+
+        // Setting one axis places the logo, the other one starts at 0
+        // until it is set too. A control binding sets it for every buffer
+        if (filter->dflt) {
+          filter->coordinate[!axis] = 0;
+          filter->dflt = FALSE;
+        }
+        filter->coordinate[axis] = g_value_get_int (value);
+        GST_LOG_OBJECT (filter, "Coordinate set to : <%d,%d>",
+            filter->coordinate[0], filter->coordinate[1]);
+      }
+      break;
+    case PROP_QOS:
+      // Set the qos property, going back to full quality when disabled
+      filter->qos_enabled = g_value_get_boolean (value);
+      g_print ("QoS set to : %s\n", filter->qos_enabled ? "TRUE" : "FALSE");
+      if (!filter->qos_enabled)
+        gst_logo_qos_reset (&filter->qos);
+      break;
+    case PROP_STATS_INTERVAL:
+      // Set the stats interval, the first message follows the next buffer
+      filter->stats_interval = g_value_get_uint (value);
+      filter->stats_next = 0;
+      break;
+    case PROP_BLEND_SPACE:
+      // Set the blend space, taking effect with the next frame
+      filter->blend_space = g_value_get_enum (value);
+      break;
+    case PROP_SHADOW_X:
+    case PROP_SHADOW_Y:
+    case PROP_SHADOW_BLUR:
+    case PROP_SHADOW_COLOR:
+    case PROP_OUTLINE_WIDTH:
+    case PROP_OUTLINE_COLOR:
+    case PROP_GLOW_RADIUS:
+    case PROP_GLOW_COLOR:
+      // Set an effect, drawn into the logo once per resolution
+      if (prop_id == PROP_SHADOW_X)
+        filter->effects.shadow_x = g_value_get_int (value);
+      else if (prop_id == PROP_SHADOW_Y)
+        filter->effects.shadow_y = g_value_get_int (value);
+      else if (prop_id == PROP_SHADOW_BLUR)
+        filter->effects.shadow_blur = g_value_get_uint (value);
+      else if (prop_id == PROP_SHADOW_COLOR)
+        filter->effects.shadow_color = g_value_get_uint (value);
+      else if (prop_id == PROP_OUTLINE_WIDTH)
+        filter->effects.outline_width = g_value_get_uint (value);
+      else if (prop_id == PROP_OUTLINE_COLOR)
+        filter->effects.outline_color = g_value_get_uint (value);
+      else if (prop_id == PROP_GLOW_RADIUS)
+        filter->effects.glow_radius = g_value_get_uint (value);
+      else
+        filter->effects.glow_color = g_value_get_uint (value);
+
+      // Prepare the logo again if it is changed while streaming
+      if (filter->check_Property_validation)
+        gst_insert_logo_update_source (filter);
+      break;
+    case PROP_AUTO_CONTRAST:
+      {
+        // Set the auto-contrast mode, the variant is prepared with the logo
+        g_free (filter->auto_contrast_str);
+        filter->auto_contrast_str = g_strdup (g_value_get_string (value));
+        filter->dflt_auto_contrast = FALSE;
+        g_print ("Auto contrast set to : %s\n", filter->auto_contrast_str);
+        if (filter->check_Property_validation &&
+            gst_logo_contrast_parse (filter->auto_contrast_str, &filter->contrast.mode)) {
+          gst_logo_contrast_reset (&filter->contrast);
+          filter->effects.contrast_variant =
+              filter->contrast.mode == GST_LOGO_CONTRAST_VARIANT;
+          gst_insert_logo_update_source (filter);
+        }
+        break;
+      }
+    case PROP_AUTO_CONTRAST_INTERVAL:
+      // Set the measuring interval, taking effect with the next frame
+      filter->contrast_interval = g_value_get_uint (value);
+      break;
+    case PROP_SCHEDULE:
+      {
+        GPtrArray *descs, *old_descs;
+        GArray *windows, *old_windows;
+        guint i;
+
+        descs = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_structure_free);
+        windows = g_array_new (FALSE, FALSE, sizeof (GstLogoWindow));
+        filter->invalid_schedule = FALSE;
+
+        // Keep the valid windows
+        for (i = 0; i < gst_value_array_get_size (value); i++) {
+          const GValue *v = gst_value_array_get_value (value, i);
+          GstLogoWindow window;
+
+          if (!GST_VALUE_HOLDS_STRUCTURE (v) ||
+              !gst_logo_window_parse (gst_value_get_structure (v), &window)) {
+            filter->invalid_schedule = TRUE;
+            continue;
+          }
+          g_ptr_array_add (descs, gst_structure_copy (gst_value_get_structure (v)));
+          g_array_append_val (windows, window);
+        }
+        g_print ("Schedule set : %u windows\n", windows->len);
+
+        // The streaming thread holds its own reference while evaluating
+        GST_OBJECT_LOCK (filter);
+        old_descs = filter->schedule_descs;
+        old_windows = filter->schedule;
+        filter->schedule_descs = descs;
+        filter->schedule = windows;
+        GST_OBJECT_UNLOCK (filter);
+
+        g_ptr_array_unref (old_descs);
+        g_array_unref (old_windows);
+        break;
+      }
+    case PROP_COVERS:
+      {
+        GPtrArray *descs, *old_descs;
+        GArray *covers, *old_covers;
+        guint i;
+
+        descs = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_structure_free);
+        covers = g_array_new (FALSE, FALSE, sizeof (GstLogoCover));
+        filter->invalid_covers = FALSE;
+
+        // Keep the valid regions
+        for (i = 0; i < gst_value_array_get_size (value); i++) {
+          const GValue *v = gst_value_array_get_value (value, i);
+          GstLogoCover cover;
+
+          if (!GST_VALUE_HOLDS_STRUCTURE (v) ||
+              !gst_logo_cover_parse (gst_value_get_structure (v), &cover)) {
+            filter->invalid_covers = TRUE;
+            continue;
+          }
+          g_ptr_array_add (descs, gst_structure_copy (gst_value_get_structure (v)));
+          g_array_append_val (covers, cover);
+        }
+        g_print ("Covers set : %u regions\n", covers->len);
+
+        // The streaming thread holds its own reference while covering
+        GST_OBJECT_LOCK (filter);
+        old_descs = filter->cover_descs;
+        old_covers = filter->covers;
+        filter->cover_descs = descs;
+        filter->covers = covers;
+        GST_OBJECT_UNLOCK (filter);
+
+        g_ptr_array_unref (old_descs);
+        g_array_unref (old_covers);
         break;
       }
+    case PROP_TICKER:
+      // Set the ticker strip, cut into tiles in the background
+      g_free (filter->ticker_path);
+      filter->ticker_path = g_strdup (g_value_get_string (value));
+      g_print ("Ticker set to : %s\n", filter->ticker_path);
+      if (filter->check_Property_validation) {
+        gst_logo_ticker_set_source (filter->ticker, filter->ticker_path);
+      }
+      break;
+    case PROP_TICKER_Y:
+      filter->ticker_y = g_value_get_int (value);
+      break;
+    case PROP_TICKER_SPEED:
+      filter->ticker_speed = g_value_get_double (value);
+      break;
+    case PROP_TICKER_BACKGROUND:
+      filter->ticker_background = g_value_get_uint (value);
+      break;
     default:
       // Warn if an invalid property ID is provided
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -458,6 +1203,175 @@ gst_insert_logo_get_property (GObject * object, guint prop_id,
       // Get the logo property value
       g_value_set_string (value, filter->logo);
       break;
+    case PROP_LOGO_SCALE:
+      // Get the logo scale property value
+      g_value_set_string (value, filter->logo_scale);
+      break;
+    case PROP_LAYERS:
+      {
+        // Get the layer descriptions
+        guint i;
+        GST_OBJECT_LOCK (filter);
+        for (i = 0; i < filter->layer_descs->len; i++) {
+          GValue v = G_VALUE_INIT;
+          g_value_init (&v, GST_TYPE_STRUCTURE);
+          g_value_set_boxed (&v, g_ptr_array_index (filter->layer_descs, i));
+          gst_value_array_append_and_take_value (value, &v);
+        }
+        GST_OBJECT_UNLOCK (filter);
+        break;
+      }
+    case PROP_KEYFRAMES:
+      {
+        // Get the keyframe descriptions
+        guint i;
+        GST_OBJECT_LOCK (filter);
+        for (i = 0; i < filter->keyframe_descs->len; i++) {
+          GValue v = G_VALUE_INIT;
+          g_value_init (&v, GST_TYPE_STRUCTURE);
+          g_value_set_boxed (&v, g_ptr_array_index (filter->keyframe_descs, i));
+          gst_value_array_append_and_take_value (value, &v);
+        }
+        GST_OBJECT_UNLOCK (filter);
+        break;
+      }
+    case PROP_PATH:
+      // Get the path property value
+      g_value_set_string (value, filter->path_str);
+      break;
+    case PROP_REPEAT:
+      // Get the repeat property value
+      g_value_set_string (value, filter->repeat_str);
+      break;
+    case PROP_ZOOM:
+      // Get the zoom property value
+      g_value_set_string (value, filter->zoom_str);
+      break;
+    case PROP_LOGO_FPS:
+      // Get the logo fps property value
+      g_value_set_double (value, filter->logo_fps);
+      break;
+    case PROP_LOGO_MEMORY:
+      // Get the logo memory property value
+      g_value_set_uint (value, filter->logo_memory);
+      break;
+    case PROP_PLAYLIST:
+      {
+        // Get the playlist entries
+        guint i;
+        GST_OBJECT_LOCK (filter);
+        for (i = 0; i < filter->playlist_descs->len; i++) {
+          GValue v = G_VALUE_INIT;
+          g_value_init (&v, GST_TYPE_STRUCTURE);
+          g_value_set_boxed (&v, g_ptr_array_index (filter->playlist_descs, i));
+          gst_value_array_append_and_take_value (value, &v);
+        }
+        GST_OBJECT_UNLOCK (filter);
+        break;
+      }
+    case PROP_PLAYLIST_FILE:
+      // Get the playlist file property value
+      g_value_set_string (value, filter->playlist_file);
+      break;
+    case PROP_CROSSFADE:
+      // Get the crossfade property value
+      g_value_set_double (value, filter->crossfade);
+      break;
+    case PROP_X:
+      // Get the horizontal position
+      g_value_set_int (value, filter->dflt ? 0 : filter->coordinate[0]);
+      break;
+    case PROP_Y:
+      // Get the vertical position
+      g_value_set_int (value, filter->dflt ? 0 : filter->coordinate[1]);
+      break;
+    case PROP_QOS:
+      // Get the qos property value
+      g_value_set_boolean (value, filter->qos_enabled);
+      break;
+    case PROP_STATS:
+      // Take a snapshot of the statistics
+      g_value_take_boxed (value, gst_logo_stats_to_structure (&filter->stats));
+      break;
+    case PROP_STATS_INTERVAL:
+      // Get the stats interval
+      g_value_set_uint (value, filter->stats_interval);
+      break;
+    case PROP_BLEND_SPACE:
+      // Get the blend space
+      g_value_set_enum (value, filter->blend_space);
+      break;
+    case PROP_SHADOW_X:
+      g_value_set_int (value, filter->effects.shadow_x);
+      break;
+    case PROP_SHADOW_Y:
+      g_value_set_int (value, filter->effects.shadow_y);
+      break;
+    case PROP_SHADOW_BLUR:
+      g_value_set_uint (value, filter->effects.shadow_blur);
+      break;
+    case PROP_SHADOW_COLOR:
+      g_value_set_uint (value, filter->effects.shadow_color);
+      break;
+    case PROP_OUTLINE_WIDTH:
+      g_value_set_uint (value, filter->effects.outline_width);
+      break;
+    case PROP_OUTLINE_COLOR:
+      g_value_set_uint (value, filter->effects.outline_color);
+      break;
+    case PROP_GLOW_RADIUS:
+      g_value_set_uint (value, filter->effects.glow_radius);
+      break;
+    case PROP_GLOW_COLOR:
+      g_value_set_uint (value, filter->effects.glow_color);
+      break;
+    case PROP_AUTO_CONTRAST:
+      // Get the auto-contrast mode
+      g_value_set_string (value, filter->auto_contrast_str);
+      break;
+    case PROP_AUTO_CONTRAST_INTERVAL:
+      g_value_set_uint (value, filter->contrast_interval);
+      break;
+    case PROP_SCHEDULE:
+      {
+        // Get the window descriptions
+        guint i;
+        GST_OBJECT_LOCK (filter);
+        for (i = 0; i < filter->schedule_descs->len; i++) {
+          GValue v = G_VALUE_INIT;
+          g_value_init (&v, GST_TYPE_STRUCTURE);
+          g_value_set_boxed (&v, g_ptr_array_index (filter->schedule_descs, i));
+          gst_value_array_append_and_take_value (value, &v);
+        }
+        GST_OBJECT_UNLOCK (filter);
+        break;
+      }
+    case PROP_COVERS:
+      {
+        // Get the cover region descriptions
+        guint i;
+        GST_OBJECT_LOCK (filter);
+        for (i = 0; i < filter->cover_descs->len; i++) {
+          GValue v = G_VALUE_INIT;
+          g_value_init (&v, GST_TYPE_STRUCTURE);
+          g_value_set_boxed (&v, g_ptr_array_index (filter->cover_descs, i));
+          gst_value_array_append_and_take_value (value, &v);
+        }
+        GST_OBJECT_UNLOCK (filter);
+        break;
+      }
+    case PROP_TICKER:
+      g_value_set_string (value, filter->ticker_path);
+      break;
+    case PROP_TICKER_Y:
+      g_value_set_int (value, filter->ticker_y);
+      break;
+    case PROP_TICKER_SPEED:
+      g_value_set_double (value, filter->ticker_speed);
+      break;
+    case PROP_TICKER_BACKGROUND:
+      g_value_set_uint (value, filter->ticker_background);
+      break;
     default:
       // Warn if an invalid property ID is provided
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -482,8 +1396,16 @@ gst_insert_logo_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 {
 		GstInsertLogo *filter = GST_INSERTLOGO (parent);
 		GstFlowReturn ret;
-  	GstVideoInfo video_info;
 		GstVideoFrame video_frame;		
+		GstLogoImage *logo;
+		GstClockTime stream_time, process_time;
+		GstLogoBlendCounts counts = { 0, 0, 0, 0 };
+		gint64 start;
+		guint level;
+		gboolean draw;
+		GPtrArray *layers;
+		GArray *covers;
+		guint i;
 		
 		// Check and validate the filter properties
 		if(!filter->check_Property_validation){
@@ -491,49 +1413,194 @@ gst_insert_logo_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 			filter->check_Property_validation = TRUE;
 		}
 		
-    // Retrieve video information from the buffer's caps
-  	if(!(gst_video_info_from_caps(&video_info, gst_pad_get_current_caps(pad))))
-		{
-			g_print("failed to retrieve information from caps\n");
-			exit(0);
+		// A tracer may have installed its hooks on the element
+		filter->trace = g_object_get_qdata(G_OBJECT(filter), trace_quark);
+		
+		// Post the statistics when they are due
+		if(filter->stats_interval > 0){
+			gst_insert_logo_post_stats(filter);
+		}
+		
+		// Animations are driven by running time, untimestamped buffers count frames
+		filter->running_time = gst_segment_to_running_time(&filter->segment, GST_FORMAT_TIME,
+				GST_BUFFER_PTS(buf));
+		if(!GST_CLOCK_TIME_IS_VALID(filter->running_time) && GST_VIDEO_INFO_FPS_N(&filter->video_info) > 0){
+			filter->running_time = gst_util_uint64_scale(filter->n_frames, GST_VIDEO_INFO_FPS_D(&filter->video_info) * GST_SECOND,
+					GST_VIDEO_INFO_FPS_N(&filter->video_info));
+		}
+		filter->n_frames++;
+		
+		// Update the controlled properties (alpha, x and y) for this buffer
+		stream_time = gst_segment_to_stream_time(&filter->segment, GST_FORMAT_TIME, GST_BUFFER_PTS(buf));
+		if(GST_CLOCK_TIME_IS_VALID(stream_time)){
+			gst_object_sync_values(GST_OBJECT(filter), stream_time);
+		}
+		
+		// Nothing is drawn outside the scheduled windows or while the logo is
+		// faded out. The cover regions are hidden on every frame regardless,
+		// so the buffer is only passed through untouched when there are none
+		level = gst_insert_logo_schedule_level(filter);
+		GST_OBJECT_LOCK(filter);
+		layers = g_ptr_array_ref(filter->layers);
+		covers = g_array_ref(filter->covers);
+		GST_OBJECT_UNLOCK(filter);
+		draw = level > 0 && (filter->alpha != 0 || layers->len > 0 || filter->ticker_path != NULL);
+		if(!draw && covers->len == 0){
+			g_ptr_array_unref(layers);
+			g_array_unref(covers);
+			gst_logo_stats_add_passthrough(&filter->stats);
+			return gst_insert_logo_push(filter, buf);
+		}
+		
+		// The animation stands still on the frozen steps of the QoS ladder
+		start = g_get_monotonic_time();
+		filter->anim_time = gst_logo_qos_anim_time(&filter->qos, filter->running_time);
+		
+		// Get the logo prepared for this resolution, normally built already
+		// by the cache worker when the caps arrived. A sponsor playlist
+		// replaces the logo and animated logos pick the frame for the
+		// running time instead
+		logo = NULL;
+		if(draw){
+			gst_logo_trace_begin(filter->trace, filter, GST_LOGO_TRACE_SPRITE);
+			if(!gst_logo_playlist_get(filter->playlist, filter->running_time, &logo,
+					&filter->fade_logo, &filter->fade_mix)){
+				if(filter->animated)
+					logo = gst_logo_sequence_get(filter->sequence, filter->anim_time);
+				else
+					logo = gst_logo_cache_get(filter->cache, filter->frame_width, filter->frame_height,
+							GST_VIDEO_INFO_FORMAT(&filter->video_info),
+							&GST_VIDEO_INFO_COLORIMETRY(&filter->video_info));
+			}
+			gst_logo_trace_end(filter->trace, filter, GST_LOGO_TRACE_SPRITE);
+			
+			// A logo that fails to load is reported once, the layers and
+			// the ticker are still drawn without it
+			if(logo == NULL && !filter->logo_failed){
+				GST_ELEMENT_WARNING(filter, RESOURCE, READ, ("Could not load the logo."),
+						("Failed to load the logo image '%s'.", filter->logo));
+			}
+			filter->logo_failed = logo == NULL;
 		}
 		
 		// Map the video frame for writing
-		if(!(gst_video_frame_map(&video_frame, &video_info, buf, GST_MAP_WRITE)))
+		buf = gst_buffer_make_writable(buf);
+		if(!(gst_video_frame_map(&video_frame, &filter->video_info, buf, GST_MAP_WRITE)))
 		{
 			g_print("failed to map the video frame\n");
 			exit(0);
 		}
 		
-		// Extract pixel data and stride information
-		guint8 *y_pixels = GST_VIDEO_FRAME_PLANE_DATA(&video_frame, 0); 
-		guint8 *uv_pixels = GST_VIDEO_FRAME_PLANE_DATA(&video_frame, 1); 
-		guint y_stride = GST_VIDEO_FRAME_PLANE_STRIDE(&video_frame, 0); 
-		guint uv_stride = GST_VIDEO_FRAME_PLANE_STRIDE(&video_frame, 1);
+		// Hide the cover regions first, the logo and layers go on top
+		if(covers->len > 0){
+			gst_logo_trace_begin(filter->trace, filter, GST_LOGO_TRACE_BLEND);
+			gst_logo_cover_apply((GstLogoCover *) covers->data, covers->len, &video_frame);
+			gst_logo_trace_end(filter->trace, filter, GST_LOGO_TRACE_BLEND);
+		}
+		g_array_unref(covers);
 		
-		// Impose the logo on the frame
-		if(!filter->rotateEnable && !filter->scrlEnable){
-			gst_insert_logo_impose_logo(filter, y_pixels, uv_pixels, y_stride, uv_stride);
+		ret = GST_FLOW_OK;
+		if(draw){
+			// Impose the logo on the frame
+			if(logo != NULL && !filter->rotateEnable && !filter->scrlEnable){
+				ret = gst_insert_logo_impose_logo(filter, &video_frame, logo);
+			}
+			
+			// Scroll the logo if scrolling is enabled
+			if(logo != NULL && filter->scrlEnable){
+				ret = gst_insert_logo_scroll_logo(filter, &video_frame, logo);
+			}
+			
+			// Rotate the logo if rotation is enabled		
+			if(logo != NULL && filter->rotateEnable && !filter->scrlEnable){
+				ret = gst_insert_logo_rotate_logo(filter, &video_frame, logo);
+			}  
+			
+			// Stack the layers on top of the logo
+			for(i = 0; i < layers->len; i++){
+				gst_logo_layer_place(g_ptr_array_index(layers, i), &filter->video_info,
+						GST_BUFFER_PTS(buf), filter->anim_time, &filter->qos, filter->placements);
+			}
+			
+			// Crawl the ticker through its band on top of the layers
+			gst_logo_ticker_place(filter->ticker, &filter->video_info, filter->running_time,
+					filter->ticker_y, filter->ticker_speed, filter->ticker_background, filter->placements);
+			
+			// Fade everything in or out at the edges of the scheduled windows
+			if(level < 255){
+				for(i = 0; i < filter->placements->len; i++){
+					GstLogoPlacement *placement = &g_array_index(filter->placements, GstLogoPlacement, i);
+					placement->alpha = placement->alpha * level / 255;
+				}
+			}
+			
+			// Blend the logo and all layers in a single pass over the frame
+			gst_logo_trace_begin(filter->trace, filter, GST_LOGO_TRACE_BLEND);
+			gst_logo_sprite_blend_layers((GstLogoPlacement *) filter->placements->data,
+					filter->placements->len, &video_frame, filter->blend_space, &counts);
+			gst_logo_trace_end(filter->trace, filter, GST_LOGO_TRACE_BLEND);
 		}
+		g_array_set_size(filter->placements, 0);
+		g_ptr_array_set_size(filter->frame_sprites, 0);
+		g_ptr_array_unref(layers);
+		
+		gst_video_frame_unmap(&video_frame);
+		gst_logo_image_unref(logo);
+		gst_logo_image_unref(filter->fade_logo);
+		filter->fade_logo = NULL;
 		
-		// Scroll the logo if scrolling is enabled
-		if(filter->scrlEnable){
-			gst_insert_logo_scroll_logo(filter, y_pixels, uv_pixels, y_stride, uv_stride);
+		// Strict mode stops the stream on an invalid coordinate or logo size
+		if(ret != GST_FLOW_OK){
+			gst_buffer_unref(buf);
+			return ret;
 		}
 		
-		// Rotate the logo if rotation is enabled		
-		if(filter->rotateEnable && !filter->scrlEnable){
-			gst_insert_logo_rotate_logo(filter, y_pixels, uv_pixels, y_stride, uv_stride);
-		}  
+		// Account the time this frame took and step along the QoS ladder
+		process_time = (g_get_monotonic_time() - start) * GST_USECOND;
+		gst_logo_stats_add_frame(&filter->stats, process_time, &counts);
+		if(filter->caps_time != 0){
+			gst_logo_stats_set_first_frame(&filter->stats, (g_get_monotonic_time() - filter->caps_time) * GST_USECOND);
+		}
+		if(filter->qos_enabled){
+			gst_insert_logo_update_qos(filter, buf, stream_time, process_time);
+		}
 		
 		// Push the processed buffer to the src pad
-		ret = gst_pad_push(filter->srcpad, buf);
-		gst_video_frame_unmap(&video_frame);
+		ret = gst_insert_logo_push(filter, buf);
 		
 		return ret;
 }
 
 
+/**
+ * @brief Handles the state changes of the InsertLogo element.
+ *
+ * When the element stops, the playlist forgets the logo it showed last so
+ * the next stream starts with its own first logo.
+ *
+ * @param element The InsertLogo element.
+ * @param transition The state transition.
+ * @return The result of the state change.
+ */
+static GstStateChangeReturn
+gst_insert_logo_change_state (GstElement * element, GstStateChange transition)
+{
+  GstInsertLogo *filter = GST_INSERTLOGO (element);
+  GstStateChangeReturn ret;
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      gst_logo_playlist_stop (filter->playlist);
+      break;
+    default:
+      break;
+  }
+  return ret;
+}
+
+
 /**
  * @brief Handles sink events for the InsertLogo element.
  *
@@ -561,20 +1628,59 @@ gst_insert_logo_sink_event (GstPad * pad, GstObject * parent,
     case GST_EVENT_CAPS:
     {
       GstCaps *caps;
+      GstVideoInfo video_info;
       gchar *caps_str;
       gst_event_parse_caps (event, &caps);
       caps_str = gst_caps_to_string (caps);
       g_print ("Received caps in sink: %s\n", caps_str);
 
+      // Keep the video format for the buffers that follow, caps that do not
+      // describe a video format fail the negotiation
+      if (!gst_video_info_from_caps (&video_info, caps)) {
+        GST_WARNING_OBJECT (filter, "failed to retrieve information from caps %s",
+            caps_str);
+        g_free (caps_str);
+        gst_event_unref (event);
+        ret = FALSE;
+        break;
+      }
+      filter->video_info = video_info;
+
       // Get frame width and height from caps
       GstStructure *structure = gst_caps_get_structure (caps, 0); // Assuming only one structure in caps
       if (structure) {
+        GstVideoFormat format = GST_VIDEO_INFO_FORMAT (&filter->video_info);
+        const GstVideoColorimetry *colorimetry =
+            &GST_VIDEO_INFO_COLORIMETRY (&filter->video_info);
         gint frame_width, frame_height;
+        guint i;
         if (gst_structure_get_int (structure, "width", &frame_width) &&
             gst_structure_get_int (structure, "height", &frame_height)) {
           g_print ("Frame Width: %d, Frame Height: %d\n", frame_width, frame_height);
           filter->frame_width = frame_width;
           filter->frame_height = frame_height;
+          
+          // Start preparing the logo for this resolution off the streaming thread
+          if (!filter->check_Property_validation) {
+            gst_insert_logo_check_property_validation (filter);
+            filter->check_Property_validation = TRUE;
+          }
+          if (filter->caps_time == 0)
+            filter->caps_time = g_get_monotonic_time ();
+          // Build the colour conversion tables before any sprite needs them
+          gst_logo_color_tables_get (colorimetry,
+              GST_VIDEO_INFO_IS_RGB (&filter->video_info));
+          gst_logo_cache_prepare (filter->cache, frame_width, frame_height, format,
+              colorimetry);
+          gst_logo_sequence_set_size (filter->sequence, frame_width, frame_height,
+              format, colorimetry);
+          gst_logo_playlist_set_size (filter->playlist, frame_width, frame_height,
+              format, colorimetry);
+          GST_OBJECT_LOCK (filter);
+          for (i = 0; i < filter->layers->len; i++)
+            gst_logo_layer_prepare (g_ptr_array_index (filter->layers, i),
+                frame_width, frame_height, format, colorimetry);
+          GST_OBJECT_UNLOCK (filter);
         }
       }
       g_free (caps_str);
@@ -582,6 +1688,47 @@ gst_insert_logo_sink_event (GstPad * pad, GstObject * parent,
       ret = gst_pad_event_default (pad, parent, event);
       break;
     }
+    case GST_EVENT_FLUSH_STOP:
+      // Start over at full quality and measure again after a seek
+      gst_logo_qos_reset (&filter->qos);
+      gst_logo_contrast_reset (&filter->contrast);
+      GST_OBJECT_LOCK (filter);
+      filter->qos_proportion = 1.0;
+      filter->qos_diff = 0;
+      GST_OBJECT_UNLOCK (filter);
+      ret = gst_pad_event_default (pad, parent, event);
+      break;
+    case GST_EVENT_SEGMENT:
+      // Keep the segment to drive the animations by running time
+      gst_event_copy_segment (event, &filter->segment);
+      filter->n_frames = 0;
+      ret = gst_pad_event_default (pad, parent, event);
+      break;
+    case GST_EVENT_CUSTOM_DOWNSTREAM:
+    {
+      // Switch the overlay on or off, or back to the schedule
+      const GstStructure *s = gst_event_get_structure (event);
+      const gchar *target;
+      gboolean enabled;
+      gdouble fade = 0;
+
+      if (gst_structure_has_name (s, GST_INSERT_LOGO_CONTROL_EVENT) &&
+          ((target = gst_structure_get_string (s, "target")) == NULL ||
+              g_strcmp0 (target, GST_OBJECT_NAME (filter)) == 0)) {
+        if (gst_structure_get_boolean (s, "enabled", &enabled))
+          filter->control = enabled ? 1 : 0;
+        else
+          filter->control = GST_INSERT_LOGO_CONTROL_AUTO;
+        gst_structure_get_double (s, "fade", &fade);
+        filter->control_fade = fade > 0 ? fade * GST_SECOND : 0;
+        filter->control_from = filter->level;
+        filter->control_start = GST_CLOCK_TIME_NONE;
+        GST_INFO_OBJECT (filter, "overlay control: %s", filter->control == GST_INSERT_LOGO_CONTROL_AUTO ?
+            "schedule" : filter->control ? "on" : "off");
+      }
+      ret = gst_pad_event_default (pad, parent, event);
+      break;
+    }
     default:
       ret = gst_pad_event_default (pad, parent, event);
       break;
@@ -591,20 +1738,56 @@ gst_insert_logo_sink_event (GstPad * pad, GstObject * parent,
 
 
 /**
- * @brief Check and validate the properties of the InsertLogo element.
+ * @brief Handles src events for the InsertLogo element.
  *
- * This function checks and validates the logo file, rotation, speed, scroll, alpha,
- * and their default values. It sets default values if necessary and handles warnings
- * or errors based on the strict mode.
+ * Keeps the lateness reported by QoS events for the degradation ladder and
+ * forwards every event upstream.
  *
- * @param filter The InsertLogo element instance.
+ * @param pad The src pad that received the event.
+ * @param parent The parent object of the pad.
+ * @param event The event to handle.
+ * @return TRUE if the event was handled successfully, FALSE otherwise.
  */
-static void
-gst_insert_logo_check_property_validation (GstInsertLogo *filter)
+static gboolean
+gst_insert_logo_src_event (GstPad * pad, GstObject * parent,
+    GstEvent * event)
+{
+  GstInsertLogo *filter = GST_INSERTLOGO (parent);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_QOS) {
+    GstQOSType type;
+    gdouble proportion;
+    GstClockTimeDiff diff;
+    GstClockTime timestamp;
+
+    gst_event_parse_qos (event, &type, &proportion, &diff, &timestamp);
+    GST_OBJECT_LOCK (filter);
+    filter->qos_proportion = proportion;
+    filter->qos_diff = diff;
+    GST_OBJECT_UNLOCK (filter);
+  }
+
+  return gst_pad_event_default (pad, parent, event);
+}
+
+
+/**
+ * @brief Check and validate the properties of the InsertLogo element.
+ *
+ * This function checks and validates the logo file, rotation, speed, scroll, alpha,
+ * and their default values. It sets default values if necessary and handles warnings
+ * or errors based on the strict mode.
+ *
+ * @param filter The InsertLogo element instance.
+ */
+static void
+gst_insert_logo_check_property_validation (GstInsertLogo *filter)
 {
   if (!filter->dfltLogo) {
-    // Check if the logo file exists and has the correct extension
-    if (access (filter->logo, F_OK) == -1) {
+    // Check if the logo file exists and has the correct extension, for a
+    // numbered sequence the first file of the sequence is checked
+    gchar *first_file = gst_logo_sequence_first_file (filter->logo);
+    if (first_file == NULL || access (first_file, F_OK) == -1) {
       if (filter->strict) {        
         GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("File does not exist."),
 		    ("Only files with the extension .png are valid."));
@@ -628,6 +1811,7 @@ gst_insert_logo_check_property_validation (GstInsertLogo *filter)
       }
     }
   skip:
+    g_free (first_file);
   }
   // Set the default logo if necessary
     if (filter->logo == NULL || filter->dfltLogo) {
@@ -688,34 +1872,236 @@ gst_insert_logo_check_property_validation (GstInsertLogo *filter)
     }
   }
 
-  // Check and validate the alpha property
-  if (!filter->dflt_alpha) {
-    if (!(filter->alpha >= -1 && filter->alpha <= 100)) {
+  // Check if both rotation and scroll are enabled
+  if (filter->rotateEnable && filter->scrlEnable) {
+    if (filter->strict) {
+      GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Rotation and Scroll Both are Enabled."),
+		  ("At a particular time, either Rotation or Scroll will work."));
+		  exit(1);
+    } else {
+      g_warning ("Rotation and Scroll Both are Enabled. At a particular time, either Rotation or Scroll will work.");
+      filter->rotateEnable = FALSE;
+      g_print ("Set default animation scroll to : %s\n", filter->scroll);
+    }
+  }
+
+  // Check and validate the logo scale property
+  if (!filter->dflt_logo_scale) {
+    if (!gst_logo_scale_parse (filter->logo_scale, &filter->scale)) {
       if (filter->strict) {
-        GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid alpha Property."),
-		    ("Valid values are '-1 (default)' or '0 to 100 (integer)'."));
+        GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid logo-scale Property."),
+		    ("Valid values are 'off', a fraction of the frame height (0 to 1) or 'WxH'."));
 		    exit(1);
       } else {
-        g_warning ("Invalid value '%d' for alpha property. Valid values are '-1 (default)' or '0 to 100 (integer)'.", filter->alpha);
-        filter->alpha = -1;
-        g_print ("Default value set to : %d\n", filter->alpha);
-        filter->dflt_alpha = TRUE;
+        g_warning ("Invalid value '%s' for logo-scale property. Valid values are 'off', a fraction of the frame height (0 to 1) or 'WxH'.", filter->logo_scale);
+        g_free (filter->logo_scale);
+        filter->logo_scale = g_strdup (DFLT_LOGO_SCALE);
+        gst_logo_scale_parse (filter->logo_scale, &filter->scale);
+        g_print ("Default value set to : %s\n", filter->logo_scale);
+        filter->dflt_logo_scale = TRUE;
       }
     }
   }
 
-  // Check if both rotation and scroll are enabled
-  if (filter->rotateEnable && filter->scrlEnable) {
+  // Check and validate the path property
+  if (!filter->dflt_path) {
+    if (!gst_logo_path_parse (filter->path_str, &filter->path)) {
+      if (filter->strict) {
+        GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid path Property."),
+		    ("Valid values are 'off', 'horizontal', 'vertical', or 'diagonal'."));
+		    exit(1);
+      } else {
+        g_warning ("Invalid value '%s' for path property. Valid values are 'off', 'horizontal', 'vertical', or 'diagonal'.", filter->path_str);
+        g_free (filter->path_str);
+        filter->path_str = g_strdup (DFLT_PATH);
+        gst_logo_path_parse (filter->path_str, &filter->path);
+        g_print ("Default value set to : %s\n", filter->path_str);
+        filter->dflt_path = TRUE;
+      }
+    }
+  }
+
+  // Check and validate the repeat property
+  if (!filter->dflt_repeat) {
+    if (!gst_logo_repeat_parse (filter->repeat_str, &filter->repeat)) {
+      if (filter->strict) {
+        GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid repeat Property."),
+		    ("Valid values are 'once', 'loop', or 'bounce'."));
+		    exit(1);
+      } else {
+        g_warning ("Invalid value '%s' for repeat property. Valid values are 'once', 'loop', or 'bounce'.", filter->repeat_str);
+        g_free (filter->repeat_str);
+        filter->repeat_str = g_strdup (DFLT_REPEAT);
+        gst_logo_repeat_parse (filter->repeat_str, &filter->repeat);
+        g_print ("Default value set to : %s\n", filter->repeat_str);
+        filter->dflt_repeat = TRUE;
+      }
+    }
+  }
+
+  // Check and validate the zoom property
+  if (!filter->dflt_zoom) {
+    if (!gst_logo_zoom_parse (filter->zoom_str, &filter->zoom)) {
+      if (filter->strict) {
+        GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid zoom Property."),
+		    ("Valid values are 'off', 'pulse', or 'in'."));
+		    exit(1);
+      } else {
+        g_warning ("Invalid value '%s' for zoom property. Valid values are 'off', 'pulse', or 'in'.", filter->zoom_str);
+        g_free (filter->zoom_str);
+        filter->zoom_str = g_strdup (DFLT_ZOOM);
+        gst_logo_zoom_parse (filter->zoom_str, &filter->zoom);
+        g_print ("Default value set to : %s\n", filter->zoom_str);
+        filter->dflt_zoom = TRUE;
+      }
+    }
+  }
+
+  // Check and validate the auto-contrast property
+  if (!filter->dflt_auto_contrast) {
+    if (!gst_logo_contrast_parse (filter->auto_contrast_str, &filter->contrast.mode)) {
+      if (filter->strict) {
+        GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid auto-contrast Property."),
+		    ("Valid values are 'off', 'opacity', or 'variant'."));
+		    exit(1);
+      } else {
+        g_warning ("Invalid value '%s' for auto-contrast property. Valid values are 'off', 'opacity', or 'variant'.", filter->auto_contrast_str);
+        g_free (filter->auto_contrast_str);
+        filter->auto_contrast_str = g_strdup (DFLT_AUTO_CONTRAST);
+        gst_logo_contrast_parse (filter->auto_contrast_str, &filter->contrast.mode);
+        g_print ("Default value set to : %s\n", filter->auto_contrast_str);
+        filter->dflt_auto_contrast = TRUE;
+      }
+    }
+  }
+  filter->effects.contrast_variant = filter->contrast.mode == GST_LOGO_CONTRAST_VARIANT;
+
+  // Check if the path is enabled together with scroll or rotation
+  if (filter->path != GST_LOGO_PATH_OFF && (filter->scrlEnable || filter->rotateEnable)) {
     if (filter->strict) {
-      GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Rotation and Scroll Both are Enabled."),
-		  ("At a particular time, either Rotation or Scroll will work."));
+      GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Path and Scroll or Rotation are Enabled."),
+		  ("At a particular time, only one animation will work."));
 		  exit(1);
     } else {
-      g_warning ("Rotation and Scroll Both are Enabled. At a particular time, either Rotation or Scroll will work.");
+      g_warning ("Path and Scroll or Rotation are Enabled. At a particular time, only one animation will work.");
+      filter->scrlEnable = FALSE;
       filter->rotateEnable = FALSE;
-      g_print ("Set default animation scroll to : %s\n", filter->scroll);
+      g_print ("Set default animation path to : %s\n", filter->path_str);
+    }
+  }
+
+  // Check that all keyframe descriptions were accepted
+  if (filter->invalid_keyframes) {
+    if (filter->strict) {
+      GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid keyframes Property."),
+		  ("Every keyframe needs a time t >= 0, alpha 0 to 100, scale above 0 and a valid ease."));
+		  exit(1);
+    } else {
+      g_warning ("Invalid keyframe descriptions were skipped.");
+    }
+  }
+
+  // Check that all layer descriptions were accepted
+  if (filter->invalid_layers) {
+    if (filter->strict) {
+      GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid layers Property."),
+		  ("Every layer needs a .png logo-file or a text and valid x, y, alpha, scrolling, rotation, speed, logo-scale, font-size and color fields."));
+		  exit(1);
+    } else {
+      g_warning ("Invalid layer descriptions were skipped.");
     }
   }
+
+  // Check that all playlist entries were accepted
+  if (filter->invalid_playlist) {
+    if (filter->strict) {
+      GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid playlist Property."),
+		  ("Every playlist entry needs a .png logo-file and a duration above 0 seconds."));
+		  exit(1);
+    } else {
+      g_warning ("Invalid playlist entries were skipped.");
+    }
+  }
+
+  // Check that all window descriptions were accepted
+  if (filter->invalid_schedule) {
+    if (filter->strict) {
+      GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid schedule Property."),
+		  ("Every window needs a start and optional later end in seconds, or from and to as HH:MM[:SS], and fades of 0 seconds or more."));
+		  exit(1);
+    } else {
+      g_warning ("Invalid window descriptions were skipped.");
+    }
+  }
+
+  // Check that all cover descriptions were accepted
+  if (filter->invalid_covers) {
+    if (filter->strict) {
+      GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid covers Property."),
+		  ("Every region needs x and y of 0 or more, width and height above 0, mode blur or pixelate and sizes of 1 to 256."));
+		  exit(1);
+    } else {
+      g_warning ("Invalid cover descriptions were skipped.");
+    }
+  }
+
+  // Check that the playlist file can be read
+  if (filter->playlist_file != NULL) {
+    GArray *entries = gst_logo_playlist_read_file (filter->playlist_file);
+    if (entries == NULL) {
+      if (filter->strict) {
+        GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid playlist-file Property."),
+		    ("Every line needs a .png logo file and a duration above 0 seconds."));
+		    exit(1);
+      } else {
+        g_warning ("Invalid playlist file '%s' is ignored.", filter->playlist_file);
+        g_free (filter->playlist_file);
+        filter->playlist_file = NULL;
+      }
+    } else {
+      g_array_unref (entries);
+    }
+  }
+  gst_logo_playlist_set_file (filter->playlist, filter->playlist_file);
+
+  // Check that the ticker strip exists, it is cut into tiles in the background
+  if (filter->ticker_path != NULL && !g_file_test (filter->ticker_path, G_FILE_TEST_EXISTS)) {
+    if (filter->strict) {
+      GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid ticker Property."),
+		  ("The ticker strip '%s' does not exist.", filter->ticker_path));
+		  exit(1);
+    } else {
+      g_warning ("Ticker strip '%s' does not exist, the ticker is disabled.", filter->ticker_path);
+      g_free (filter->ticker_path);
+      filter->ticker_path = NULL;
+    }
+  }
+  gst_logo_ticker_set_source (filter->ticker, filter->ticker_path);
+
+  // Hand the validated logo over to the cache or the sequence player
+  gst_insert_logo_update_source (filter);
+}
+
+
+/**
+ * @brief Hands the logo over to the sequence player or the logo cache.
+ *
+ * Animated logos are decoded by the sequence player, still logos by the
+ * cache, which is then emptied for animated ones. Playlist logos are sized
+ * like the logo.
+ *
+ * @param filter The InsertLogo element instance.
+ */
+static void
+gst_insert_logo_update_source (GstInsertLogo *filter)
+{
+  filter->animated = gst_logo_sequence_set_source (filter->sequence, filter->logo,
+      filter->logo_fps, (guint64) filter->logo_memory << 20, &filter->scale,
+      &filter->effects);
+  gst_logo_cache_set_source (filter->cache, filter->animated ? NULL : filter->logo,
+      &filter->scale, &filter->effects);
+  gst_logo_playlist_configure (filter->playlist, &filter->scale,
+      &filter->effects, filter->crossfade * GST_SECOND);
 }
 
 
@@ -775,38 +2161,592 @@ gst_insert_logo_set_logo(GstInsertLogo *filter)
 
 
 /**
- * @brief Imposes the logo onto the YUV frame at the specified coordinates with rotation and alpha blending.
+ * @brief Queues a logo sprite with wrap-around at the frame edges.
  *
- * This function loads the logo image from the file specified in the filter and imposes it onto the YUV frame
- * at the specified coordinates with alpha blending.
+ * Parts of the sprite that leave the frame on the right or bottom edge are
+ * blended again on the opposite edge, like the per pixel modulo addressing
+ * used before the logo was cached. The copies are added to the placements
+ * blended by the chain function once all layers are collected.
  *
  * @param filter The GstInsertLogo filter instance.
- * @param y_pixels The Y plane pixels of the YUV frame.
- * @param uv_pixels The UV plane pixels of the YUV frame.
- * @param y_stride The stride of the Y plane.
- * @param uv_stride The stride of the UV plane.
+ * @param frame The mapped video frame.
+ * @param sprite The sprite to blend.
+ * @param x The X coordinate of the sprite.
+ * @param y The Y coordinate of the sprite.
+ * @param sprite_width The width the sprite is resampled to.
+ * @param sprite_height The height the sprite is resampled to.
+ * @param alpha The opacity of the sprite, 0 to 255.
  */
 static void
-gst_insert_logo_impose_logo(GstInsertLogo *filter, guint8 *y_pixels, guint8 *uv_pixels, guint y_stride, guint uv_stride)
+gst_insert_logo_add_wrapped(GstInsertLogo *filter, GstVideoFrame *frame, const GstLogoSprite *sprite, gint x, gint y,
+		gint sprite_width, gint sprite_height, guint alpha)
 {
-    cairo_surface_t *image_surface = cairo_image_surface_create_from_png(filter->logo);
-    if (cairo_surface_status(image_surface) != CAIRO_STATUS_SUCCESS) {
-        g_printerr("Error loading logo image: %s\n", cairo_status_to_string(cairo_surface_status(image_surface)));
-        return;
+    gint width = GST_VIDEO_FRAME_WIDTH(frame);
+    gint height = GST_VIDEO_FRAME_HEIGHT(frame);
+    GstLogoPlacement placement;
+
+    placement.sprite = sprite;
+    placement.alpha = alpha;
+    placement.width = sprite_width;
+    placement.height = sprite_height;
+    placement.x = ((x % width) + width) % width;
+    placement.y = ((y % height) + height) % height;
+    g_array_append_val(filter->placements, placement);
+
+    x = placement.x;
+    y = placement.y;
+    if(x + sprite_width > width){
+    	placement.x = x - width;
+    	placement.y = y;
+    	g_array_append_val(filter->placements, placement);
+    }
+    if(y + sprite_height > height){
+    	placement.x = x;
+    	placement.y = y - height;
+    	g_array_append_val(filter->placements, placement);
+    	if(x + sprite_width > width){
+    		placement.x = x - width;
+    		g_array_append_val(filter->placements, placement);
+    	}
+    }
+}
+
+/**
+ * @brief Gives the rectangle a logo is drawn into at an animation state.
+ *
+ * The rectangle covers the effects around the logo. A rotated logo is drawn
+ * into a square of the longer side, and every transformed logo stays
+ * centered on the untransformed one.
+ *
+ * @param logo The logo prepared for the frame resolution.
+ * @param state The animation state, only angle and scale are used if
+ *     @x and @y are NULL.
+ * @param x Return location for the left edge, may be NULL.
+ * @param y Return location for the top edge, may be NULL.
+ * @param width Return location for the width.
+ * @param height Return location for the height.
+ */
+static void
+gst_insert_logo_get_bounds(const GstLogoImage *logo, const GstLogoAnimState *state,
+		gint *x, gint *y, gint *width, gint *height)
+{
+    gint sprite_width = logo->sprite->width;
+    gint sprite_height = logo->sprite->height;
+
+    *width = sprite_width;
+    *height = sprite_height;
+    if(state->angle != 0){
+    	*width = *height = MAX(sprite_width, sprite_height);
+    }
+    *width = lround(*width * state->scale);
+    *height = lround(*height * state->scale);
+    if(x != NULL && y != NULL){
+    	*x = state->x - logo->x_offset - (*width - sprite_width) / 2;
+    	*y = state->y - logo->y_offset - (*height - sprite_height) / 2;
+    }
+}
+
+/**
+ * @brief Checks that the logo fits into the frame.
+ *
+ * Without logo scaling the logo must stay below one-sixth of the frame size;
+ * a scaled logo is sized by the user for every resolution. Either way the
+ * logo as it is drawn, with its effects and rotated, has to fit into the
+ * frame.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ * @param logo The logo prepared for the frame resolution.
+ * @param rotated Whether the logo rotates.
+ * @return TRUE if the logo fits.
+ */
+static gboolean
+gst_insert_logo_check_logo_size(GstInsertLogo *filter, const GstLogoImage *logo, gboolean rotated)
+{
+    GstLogoAnimState state = { 0, 0, rotated ? 45 : 0, 1, 255 };
+    gint width, height;
+
+    gst_insert_logo_get_bounds(logo, &state, NULL, NULL, &width, &height);
+    if(width > filter->frame_width || height > filter->frame_height){
+    	return FALSE;
+    }
+    if(filter->scale.mode != GST_LOGO_SCALE_NONE){
+    	return TRUE;
+    }
+    return (logo->width < (filter->frame_width/6)) && (logo->height < (filter->frame_height/6));
+}
+
+/**
+ * @brief Builds the animation timeline of the logo.
+ *
+ * The timeline is a pure function of the running time. It is built from
+ * the keyframes if there are any, else from the path, scroll or rotation
+ * properties, and sampled once per frame duration. It is only built again
+ * when the properties, the frame or the logo size change.
+ *
+ * The opacity of the timeline is relative to the alpha property, and
+ * static, scrolling and rotating timelines start at the origin and are
+ * moved to the coordinate when queued. A control binding on alpha, x or y
+ * therefore does not build the timeline again for every frame.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ * @param frame The mapped video frame.
+ * @param logo The logo prepared for the frame resolution.
+ */
+static void
+gst_insert_logo_update_anim(GstInsertLogo *filter, GstVideoFrame *frame, GstLogoImage *logo)
+{
+    gboolean relative;
+    gint key[GST_INSERT_LOGO_ANIM_KEY_LEN];
+    GstClockTime step = GST_SECOND / 60;
+    gdouble speed = 0;
+    guint i;
+
+    GST_OBJECT_LOCK(filter);
+    relative = filter->keyframe_descs->len == 0 && filter->path == GST_LOGO_PATH_OFF;
+    GST_OBJECT_UNLOCK(filter);
+    key[0] = filter->frame_width;
+    key[1] = filter->frame_height;
+    key[2] = logo->width;
+    key[3] = logo->height;
+    key[4] = relative ? 0 : filter->coordinate[0];
+    key[5] = relative ? 0 : filter->coordinate[1];
+    key[6] = relative;
+    key[7] = GST_VIDEO_INFO_FPS_N(&frame->info);
+    key[8] = GST_VIDEO_INFO_FPS_D(&frame->info);
+    key[9] = filter->scrlEnable;
+    key[10] = filter->rotateEnable;
+    filter->anim_relative = relative;
+
+    if(filter->anim != NULL && !filter->anim_dirty && memcmp(key, filter->anim_key, sizeof(key)) == 0){
+    	return;
+    }
+    memcpy(filter->anim_key, key, sizeof(key));
+    filter->anim_dirty = FALSE;
+    gst_logo_anim_free(filter->anim);
+
+    GST_OBJECT_LOCK(filter);
+    if(filter->keyframe_descs->len > 0){
+    	// Keyframe fields that are not given keep the previous value
+    	GstLogoKeyframe prev = { 0, filter->coordinate[0], filter->coordinate[1], 0, 100, 1.0, GST_LOGO_EASE_LINEAR };
+    	filter->anim = gst_logo_anim_new(filter->repeat);
+    	for(i = 0; i < filter->keyframe_descs->len; i++){
+    		GstLogoKeyframe kf;
+    		if(gst_logo_keyframe_parse(g_ptr_array_index(filter->keyframe_descs, i), &prev, &kf)){
+    			gst_logo_anim_add_keyframe(filter->anim, &kf);
+    			prev = kf;
+    		}
+    	}
+    	if(filter->anim->keyframes->len == 0){
+    		gst_logo_anim_add_keyframe(filter->anim, &prev);
+    	}
+    	GST_OBJECT_UNLOCK(filter);
+    } else {
+    	GST_OBJECT_UNLOCK(filter);
+    	gst_logo_speed_parse(filter->speed, filter->rotateEnable && filter->path == GST_LOGO_PATH_OFF
+    			&& !filter->scrlEnable, &speed);
+    	if(filter->path != GST_LOGO_PATH_OFF){
+    		filter->anim = gst_logo_anim_new_path(filter->path, filter->repeat, filter->coordinate[0], filter->coordinate[1],
+    				100, filter->frame_width - logo->width, filter->frame_height - logo->height, speed);
+    	} else if(filter->scrlEnable){
+    		// The wrap-around makes one frame width a full cycle
+    		filter->anim = gst_logo_anim_new_scroll(0, 0, 100,
+    				strcmp(filter->scroll, "rtl") == 0 ? -filter->frame_width : filter->frame_width, speed);
+    	} else if(filter->rotateEnable){
+    		filter->anim = gst_logo_anim_new_spin(0, 0, 100,
+    				strcmp(filter->rotation, "counter-clockwise") == 0 ? -speed : speed);
+    	} else if(filter->zoom != GST_LOGO_ZOOM_OFF){
+    		filter->anim = gst_logo_anim_new_zoom(filter->zoom, 0, 0, 100, speed);
+    	} else {
+    		filter->anim = gst_logo_anim_new_static(0, 0, 100);
+    	}
+    }
+
+    // One table entry per frame
+    if(GST_VIDEO_INFO_FPS_N(&frame->info) > 0){
+    	step = gst_util_uint64_scale_int(GST_SECOND, GST_VIDEO_INFO_FPS_D(&frame->info), GST_VIDEO_INFO_FPS_N(&frame->info));
     }
+    gst_logo_anim_compile(filter->anim, step);
+}
+
+/**
+ * @brief Computes the opacity of the overlay for the current frame.
+ *
+ * The schedule gives the opacity unless a control event switched the
+ * overlay on or off, which fades from the opacity it had at that moment.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ * @return The overlay opacity, 0 to 255. 0 passes the frame through.
+ */
+static guint
+gst_insert_logo_schedule_level(GstInsertLogo *filter)
+{
+    GstClockTime rt = filter->running_time, elapsed;
+    guint target;
+    GArray *windows;
+
+    if(filter->control == GST_INSERT_LOGO_CONTROL_AUTO){
+    	GST_OBJECT_LOCK(filter);
+    	windows = g_array_ref(filter->schedule);
+    	GST_OBJECT_UNLOCK(filter);
+    	if(windows->len == 0)
+    		filter->level = 255;
+    	else
+    		filter->level = gst_logo_schedule_eval(windows, rt,
+    				gst_logo_schedule_uses_wall_clock(windows) ? gst_logo_schedule_time_of_day() : GST_CLOCK_TIME_NONE);
+    	g_array_unref(windows);
+    	return filter->level;
+    }
+
+    // The fade of a control event starts with the next frame
+    target = filter->control ? 255 : 0;
+    if(!GST_CLOCK_TIME_IS_VALID(filter->control_start))
+    	filter->control_start = rt;
+    if(filter->control_fade == 0 || !GST_CLOCK_TIME_IS_VALID(rt) || rt < filter->control_start){
+    	filter->level = target;
+    } else {
+    	elapsed = MIN(rt - filter->control_start, filter->control_fade);
+    	filter->level = filter->control_from + ((gint) target - (gint) filter->control_from) *
+    			(gint) gst_util_uint64_scale(elapsed, 255, filter->control_fade) / 255;
+    }
+    return filter->level;
+}
+
+/**
+ * @brief Steps along the QoS ladder after a frame was rendered.
+ *
+ * Compares the time the frame took with the lateness of the latest QoS
+ * event and posts a QoS message naming the new step when it changes.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ * @param buf The rendered buffer.
+ * @param stream_time The stream time of the buffer.
+ * @param process_time The time the frame took.
+ */
+static void
+gst_insert_logo_update_qos(GstInsertLogo *filter, GstBuffer *buf, GstClockTime stream_time, GstClockTime process_time)
+{
+    GstClockTime frame_duration = 0;
+    gdouble proportion;
+    GstClockTimeDiff diff;
+    GstMessage *msg;
+
+    if(GST_VIDEO_INFO_FPS_N(&filter->video_info) > 0){
+    	frame_duration = gst_util_uint64_scale_int(GST_SECOND, GST_VIDEO_INFO_FPS_D(&filter->video_info),
+    			GST_VIDEO_INFO_FPS_N(&filter->video_info));
+    }
+    GST_OBJECT_LOCK(filter);
+    proportion = filter->qos_proportion;
+    diff = filter->qos_diff;
+    GST_OBJECT_UNLOCK(filter);
+
+    if(!gst_logo_qos_update(&filter->qos, filter->running_time, frame_duration, process_time, proportion, diff)){
+    	return;
+    }
+
+    GST_INFO_OBJECT(filter, "QoS step: %s", gst_logo_qos_step_name(filter->qos.step));
+    msg = gst_message_new_qos(GST_OBJECT(filter), FALSE, filter->running_time, stream_time,
+    		GST_BUFFER_PTS(buf), GST_BUFFER_DURATION(buf));
+    gst_message_set_qos_values(msg, diff, proportion, gst_logo_qos_quality(&filter->qos));
+    gst_message_set_qos_stats(msg, GST_FORMAT_BUFFERS, filter->qos.processed, 0);
+    gst_structure_set(gst_message_writable_structure(msg),
+    		"degradation-step", G_TYPE_UINT, (guint) filter->qos.step,
+    		"degradation", G_TYPE_STRING, gst_logo_qos_step_name(filter->qos.step), NULL);
+    gst_element_post_message(GST_ELEMENT(filter), msg);
+}
+
+/**
+ * @brief Pushes a buffer downstream, reporting it to a tracer.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ * @param buf The buffer to push.
+ * @return The result of the push.
+ */
+static GstFlowReturn
+gst_insert_logo_push(GstInsertLogo *filter, GstBuffer *buf)
+{
+    GstFlowReturn ret;
+
+    gst_logo_trace_begin(filter->trace, filter, GST_LOGO_TRACE_PUSH);
+    ret = gst_pad_push(filter->srcpad, buf);
+    gst_logo_trace_end(filter->trace, filter, GST_LOGO_TRACE_PUSH);
+    return ret;
+}
+
+/**
+ * @brief Posts the statistics as an element message when they are due.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ */
+static void
+gst_insert_logo_post_stats(GstInsertLogo *filter)
+{
+    gint64 now = g_get_monotonic_time();
+
+    if(now < filter->stats_next){
+    	return;
+    }
+    filter->stats_next = now + (gint64) filter->stats_interval * 1000;
+    gst_element_post_message(GST_ELEMENT(filter), gst_message_new_element(GST_OBJECT(filter),
+    		gst_logo_stats_to_structure(&filter->stats)));
+}
+
+/**
+ * @brief Gives the rotated sprite of a logo surface.
+ *
+ * One sprite is kept per surface, so the logo, its auto-contrast variant
+ * and the logo a playlist crossfades into do not evict each other when
+ * they are queued in the same frame. A sprite is drawn again when the
+ * angle or scale of its surface change; a new surface takes over the
+ * least recently used slot.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ * @param surface The logo surface to rotate.
+ * @param sprite The untransformed sprite of @surface, for its format.
+ * @param angle The rotation in degrees.
+ * @param scale The scale.
+ * @return The rotated sprite, owned by the filter.
+ */
+static const GstLogoSprite *
+gst_insert_logo_get_transformed(GstInsertLogo *filter, cairo_surface_t *surface,
+		const GstLogoSprite *sprite, gfloat angle, gfloat scale)
+{
+    GstInsertLogoTransformed entry;
+    guint i, last = G_N_ELEMENTS(filter->transformed) - 1;
+
+    // Find the slot of the surface and move it to the front
+    for(i = 0; i < last && filter->transformed[i].surface != surface; i++);
+    entry = filter->transformed[i];
+    memmove(&filter->transformed[1], &filter->transformed[0], i * sizeof(entry));
+
+    if(entry.sprite == NULL || entry.surface != surface ||
+    		entry.sprite->format != sprite->format ||
+    		!gst_video_colorimetry_is_equal(&entry.sprite->colorimetry, &sprite->colorimetry) ||
+    		entry.angle != angle || entry.scale != scale){
+    	// The previous sprite may still be queued for this frame
+    	if(entry.sprite != NULL){
+    		g_ptr_array_add(filter->frame_sprites, entry.sprite);
+    		cairo_surface_destroy(entry.surface);
+    	}
+    	gst_logo_trace_begin(filter->trace, filter, GST_LOGO_TRACE_SPRITE);
+    	entry.sprite = gst_logo_sprite_new_transformed(surface, angle, scale,
+    			sprite->format, &sprite->colorimetry);
+    	gst_logo_trace_end(filter->trace, filter, GST_LOGO_TRACE_SPRITE);
+    	gst_logo_stats_add_sprite(&filter->stats, FALSE);
+    	entry.surface = cairo_surface_reference(surface);
+    	entry.angle = angle;
+    	entry.scale = scale;
+    } else {
+    	gst_logo_stats_add_sprite(&filter->stats, TRUE);
+    }
+    filter->transformed[0] = entry;
+    return entry.sprite;
+}
+
+/**
+ * @brief Queues a logo at an animation state.
+ *
+ * Rotated logos are drawn into a sprite centered on the position of the
+ * logo. It is kept and reused while the logo, angle and scale stay the
+ * same, which the coarse step of the QoS ladder makes likely; the static
+ * step draws the logo untransformed. Logos that are only scaled
+ * are resampled from the mip pyramid of the logo sprite while they are
+ * blended, so a zoom costs no sprite per frame.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ * @param frame The mapped video frame.
+ * @param logo The logo prepared for the frame resolution.
+ * @param variant Whether the auto-contrast variant of the logo is queued.
+ * @param state The animation state of the frame.
+ * @param alpha The opacity of the logo, 0 to 255.
+ */
+static void
+gst_insert_logo_add_state(GstInsertLogo *filter, GstVideoFrame *frame, GstLogoImage *logo,
+		gboolean variant, const GstLogoAnimState *state, guint alpha)
+{
+    const GstLogoSprite *sprite = variant ? logo->variant : logo->sprite;
+    cairo_surface_t *surface = variant ? logo->variant_surface : logo->surface;
+    // The effects around the logo start up and to the left of it
+    gint x = state->x - logo->x_offset, y = state->y - logo->y_offset;
+    gfloat angle = state->angle, scale = state->scale;
+
+    gst_logo_qos_quantize(&filter->qos, &angle, &scale);
+    if(angle == 0 && scale != 1){
+    	gint width = lround(sprite->width * scale);
+    	gint height = lround(sprite->height * scale);
+
+    	// Nothing is left of a logo zooming in from nothing
+    	if(width == 0 || height == 0){
+    		return;
+    	}
+    	x -= (width - sprite->width) / 2;
+    	y -= (height - sprite->height) / 2;
+    	gst_insert_logo_add_wrapped(filter, frame, sprite, x, y, width, height, alpha);
+    	return;
+    }
+    if(angle != 0){
+    	sprite = gst_insert_logo_get_transformed(filter, surface, sprite, angle, scale);
+    	x -= (sprite->width - logo->sprite->width) / 2;
+    	y -= (sprite->height - logo->sprite->height) / 2;
+    }
+
+    gst_insert_logo_add_wrapped(filter, frame, sprite, x, y, sprite->width, sprite->height, alpha);
+}
+
+/**
+ * @brief Queues a logo at an animation state, adapted to the video under it.
+ *
+ * The opacity mode scales the opacity of the logo; the variant mode splits
+ * it between the logo and its light or dark variant so one fades into the
+ * other.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ * @param frame The mapped video frame.
+ * @param logo The logo prepared for the frame resolution.
+ * @param state The animation state of the frame.
+ * @param alpha The opacity of the logo, 0 to 255.
+ */
+static void
+gst_insert_logo_add_contrasted(GstInsertLogo *filter, GstVideoFrame *frame, GstLogoImage *logo,
+		const GstLogoAnimState *state, guint alpha)
+{
+    guint mix = 0;
 
-    guint width_logo = cairo_image_surface_get_width(image_surface);
-    guint height_logo = cairo_image_surface_get_height(image_surface);
+    if(filter->contrast.mode == GST_LOGO_CONTRAST_OPACITY){
+    	alpha = lround(alpha * filter->contrast.opacity);
+    } else if(filter->contrast.mode == GST_LOGO_CONTRAST_VARIANT && logo->variant != NULL){
+    	mix = lround(alpha * filter->contrast.variant);
+    }
+    // The variant fades in on top of the logo
+    if(alpha > mix){
+    	gst_insert_logo_add_state(filter, frame, logo, FALSE, state, alpha - mix);
+    }
+    if(mix > 0){
+    	gst_insert_logo_add_state(filter, frame, logo, TRUE, state, mix);
+    }
+}
+
+/**
+ * @brief Queues the logo at its animated position for the current frame.
+ *
+ * Looks up the timeline at the running time of the frame and applies the
+ * current alpha and coordinate to it. While a sponsor playlist crossfades,
+ * the next logo is queued on top at the same state so both are blended in
+ * the same pass. With auto-contrast the light under the logo is measured
+ * every few frames, before anything is blended into the frame.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ * @param frame The mapped video frame.
+ * @param logo The logo prepared for the frame resolution.
+ */
+static void
+gst_insert_logo_add_animated(GstInsertLogo *filter, GstVideoFrame *frame, GstLogoImage *logo)
+{
+    GstLogoAnimState state;
+    GstLogoLightStats stats;
+    gint x, y, width, height;
+    guint alpha;
+
+    gst_logo_trace_begin(filter->trace, filter, GST_LOGO_TRACE_ANIM);
+    gst_insert_logo_update_anim(filter, frame, logo);
+    state = *gst_logo_anim_eval(filter->anim, filter->anim_time);
+    gst_logo_trace_end(filter->trace, filter, GST_LOGO_TRACE_ANIM);
+    filter->degree = state.angle;
+    if(filter->anim_relative){
+    	state.x += filter->coordinate[0];
+    	state.y += filter->coordinate[1];
+    }
+    alpha = state.alpha * filter->alpha / 100;
+
+    // The light is measured under all of the logo as it is drawn
+    gst_insert_logo_get_bounds(logo, &state, &x, &y, &width, &height);
+    if(gst_logo_contrast_due(&filter->contrast, filter->contrast_interval) &&
+    		gst_logo_sprite_measure(frame, x, y, width, height, &stats)){
+    	gst_logo_contrast_update(&filter->contrast, &stats, logo->light,
+    			logo->variant != NULL ? logo->variant_light : logo->light, filter->running_time);
+    }
+
+    if(filter->fade_logo != NULL){
+    	gst_insert_logo_add_contrasted(filter, frame, logo, &state, alpha * (255 - filter->fade_mix) / 255);
+    	gst_insert_logo_add_contrasted(filter, frame, filter->fade_logo, &state, alpha * filter->fade_mix / 255);
+    } else {
+    	gst_insert_logo_add_contrasted(filter, frame, logo, &state, alpha);
+    }
+}
+
+/**
+ * @brief Queues the logo if it fits into the frame, else fits it.
+ *
+ * A logo that is not scaled and is not below one-sixth of the frame size is
+ * scaled down to fit, relative to the frame height so that it keeps fitting
+ * across resolution changes. It is drawn from the next frame, once the cache
+ * holds it at the new size. A scaled logo is sized by the user, so it is
+ * drawn as it is and the blend clips it at the frame edges. In strict mode
+ * both are an error instead.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ * @param frame The mapped video frame.
+ * @param logo The logo prepared for the frame resolution.
+ * @param rotated Whether the logo rotates.
+ * @return GST_FLOW_ERROR if strict mode rejects the logo size.
+ */
+static GstFlowReturn
+gst_insert_logo_add_fitted(GstInsertLogo *filter, GstVideoFrame *frame, GstLogoImage *logo, gboolean rotated)
+{
+    gint height;
+
+    if(gst_insert_logo_check_logo_size(filter, logo, rotated)){
+    	gst_insert_logo_add_animated(filter, frame, logo);
+    	return GST_FLOW_OK;
+    }
+    if(filter->strict){
+    	GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Logo dimensions are too large."),
+    			("The logo size should be less than one-sixth of the frame size, or set logo-scale."));
+    	return GST_FLOW_ERROR;
+    }
+    if(filter->scale.mode != GST_LOGO_SCALE_NONE){
+    	gst_insert_logo_add_animated(filter, frame, logo);
+    	return GST_FLOW_OK;
+    }
+    
+    // The largest height that keeps both sides below one-sixth of the frame
+    height = MIN(filter->frame_height/6 - 1, (filter->frame_width/6 - 1) * logo->height / logo->width);
+    height = MAX(height, 1);
+    g_warning ("Logo dimensions '<%d, %d>' are too large for the frame '<%d, %d>'. Scaling the logo to a height of %d.",
+                    logo->width, logo->height, filter->frame_width, filter->frame_height, height);
+    filter->scale.mode = GST_LOGO_SCALE_RELATIVE;
+    filter->scale.fraction = (gdouble) height / filter->frame_height;
+    gst_insert_logo_update_source(filter);
+    
+    // Pick the default position again for the smaller logo
+    filter->scrl_dflt_cord = FALSE;
+    return GST_FLOW_OK;
+}
+
+/**
+ * @brief Imposes the logo onto the YUV frame at the specified coordinates with rotation and alpha blending.
+ *
+ * This function blends the logo prepared by the logo cache onto the YUV frame
+ * at the specified coordinates with alpha blending.
+ *
+ * @param filter The GstInsertLogo filter instance.
+ * @param frame The mapped video frame.
+ * @param logo The logo prepared for the frame resolution.
+ * @return GST_FLOW_ERROR if strict mode rejects the coordinate or the logo size.
+ */
+static GstFlowReturn
+gst_insert_logo_impose_logo(GstInsertLogo *filter, GstVideoFrame *frame, GstLogoImage *logo)
+{
+    guint width_logo = logo->width;
+    guint height_logo = logo->height;
     
     // If the coordinate values are negative
     if(filter->cord_negative){
 		  
 		  if(filter->strict){
 		      // If strict mode is enabled, raise an error and abort
-			    cairo_surface_destroy(image_surface);
 			    GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid value (negative) for coordinate property."),
 		      ("Valid values are positive integer numbers."));
-		      exit(1);
+		      return GST_FLOW_ERROR;
 		  } else {
 		      // If not in strict mode, issue a warning
 		      g_warning ("Invalid value (negative) '<%d, %d>' for coordinate property. Valid values are positive integer numbers.",
@@ -832,10 +2772,9 @@ gst_insert_logo_impose_logo(GstInsertLogo *filter, guint8 *y_pixels, guint8 *uv_
 		if(!filter->dflt && (filter->coordinate[0] > filter->frame_width || filter->coordinate[1] > filter->frame_height)){
 				if(filter->strict){
 				    // If strict mode is enabled, raise an error and abort
-				    cairo_surface_destroy(image_surface);
 				    GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid coordinates for the coordinate property."),
 				    ("Valid values are within the frame dimensions."));
-				    exit(1);
+				    return GST_FLOW_ERROR;
 				} else {
 				    // If not in strict mode, issue a warning
 				    g_warning ("Coordinates out of bounds '<%d, %d>' for coordinate property. Valid values are within the frame dimensions.",
@@ -850,98 +2789,35 @@ gst_insert_logo_impose_logo(GstInsertLogo *filter, guint8 *y_pixels, guint8 *uv_
 		  filter->coordinate[1] = height_logo/30;		
 		}
     
-    guint8 *data = cairo_image_surface_get_data(image_surface);
-    
-    //setting alpha to 100
-    if(filter->alpha == -1){
-    	filter->alpha = 100;
-    }
-    gdouble Alpha_Factor = (filter->alpha / 100.0);
-    
-    gint j, i;
-		gint wrapped_i, wrapped_j;
-		guint8 *y_pixel, *uv_pixel;
-		guint8 Red, Green, Blue, Alpha;
-		guint8 Y, U, V;
 
-    if((width_logo < (filter->frame_width/6)) && (height_logo < (filter->frame_height/6)))
-    {
-		  for (j = 0; j < height_logo; j++)
-			{
-					for (i = 0; i < width_logo; i++)
-					{
-						  // Calculate the wrapped-around i and j coordinates
-						  wrapped_i = (i + filter->coordinate[0]) % filter->frame_width;
-						  wrapped_j = (j + filter->coordinate[1]) % filter->frame_height;
-
-						  // calculate y and uv pixels address
-						  y_pixel = y_pixels + wrapped_j * y_stride + wrapped_i;
-						  uv_pixel = uv_pixels + (wrapped_j / 2) * uv_stride + (wrapped_i / 2) * 2;
-
-						  // Reading RGBA values from the image file
-						  Red = data[(j * width_logo + i) * 4];
-						  Green = data[(j * width_logo + i) * 4 + 1];
-						  Blue = data[(j * width_logo + i) * 4 + 2];
-						  Alpha = data[(j * width_logo + i) * 4 + 3] * Alpha_Factor;
-
-						  // convert RGB to YUV
-						  Y = (0.257 * Red) + (0.504 * Green) + (0.098 * Blue) + 16;  // Y component
-						  U = (0.439 * Red) - (0.368 * Green) - (0.071 * Blue) + 128;  // U component
-						  V = -(0.148 * Red) - (0.291 * Green) + (0.439 * Blue) + 128;  // V component
-
-						  // Alpha blending
-						  Y = ((255 - Alpha) * (*y_pixel) + Alpha * Y) / 255;
-						  U = ((255 - Alpha) * (uv_pixel[0]) + Alpha * U) / 255;
-						  V = ((255 - Alpha) * (uv_pixel[1]) + Alpha * V) / 255;
-
-						  *y_pixel = Y;
-						  uv_pixel[0] = U;
-						  uv_pixel[1] = V;
-					}
-			}
-			cairo_surface_destroy(image_surface);
-		} else {
-        // Error if the logo dimensions are too large
-        cairo_surface_destroy(image_surface);
-        GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Logo dimensions are too large."),
-				("The logo size should be less than one-sixth of the frame size."));
-				exit(1);
-    }
+    return gst_insert_logo_add_fitted(filter, frame, logo, FALSE);
 }
 
 /**
  * @brief Imposes the logo onto the YUV frame and scroll it from the specified coordinates with alpha blending.
  *
- * This function loads the logo image from the file specified in the filter and imposes it onto the YUV frame
+ * This function blends the logo prepared by the logo cache onto the YUV frame
  * at the specified coordinates with alpha blending and scroll it.
  *
  * @param filter The GstInsertLogo filter instance.
- * @param y_pixels The Y plane pixels of the YUV frame.
- * @param uv_pixels The UV plane pixels of the YUV frame.
- * @param y_stride The stride of the Y plane.
- * @param uv_stride The stride of the UV plane.
+ * @param frame The mapped video frame.
+ * @param logo The logo prepared for the frame resolution.
+ * @return GST_FLOW_ERROR if strict mode rejects the coordinate or the logo size.
  */
-static void
-gst_insert_logo_scroll_logo(GstInsertLogo *filter, guint8 *y_pixels, guint8 *uv_pixels, guint y_stride, guint uv_stride)
+static GstFlowReturn
+gst_insert_logo_scroll_logo(GstInsertLogo *filter, GstVideoFrame *frame, GstLogoImage *logo)
 {
-    cairo_surface_t *image_surface = cairo_image_surface_create_from_png(filter->logo);
-    if (cairo_surface_status(image_surface) != CAIRO_STATUS_SUCCESS) {
-        g_printerr("Error loading logo image: %s\n", cairo_status_to_string(cairo_surface_status(image_surface)));
-        return;
-    }
-
-    guint width_logo = cairo_image_surface_get_width(image_surface);
-    guint height_logo = cairo_image_surface_get_height(image_surface);
+    guint width_logo = logo->width;
+    guint height_logo = logo->height;
     
     // If the coordinate values are negative
     if(filter->cord_negative){
 		  
 		  if(filter->strict){
 		      // If strict mode is enabled, raise an error and abort
-			    cairo_surface_destroy(image_surface);
 			    GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid value (negative) for coordinate property."),
 		      ("Valid values are positive integer numbers."));
-		      exit(1);
+		      return GST_FLOW_ERROR;
 		  } else {
 		      // If not in strict mode, issue a warning
 		      g_warning ("Invalid value (negative) '<%d, %d>' for coordinate property. Valid values are positive integer numbers.",
@@ -967,10 +2843,9 @@ gst_insert_logo_scroll_logo(GstInsertLogo *filter, guint8 *y_pixels, guint8 *uv_
 		if(!filter->dflt && (filter->coordinate[0] > filter->frame_width || filter->coordinate[1] > filter->frame_height)){
 				if(filter->strict){
 				    // If strict mode is enabled, raise an error and abort
-				    cairo_surface_destroy(image_surface);
 				    GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid coordinates for the coordinate property."),
 				    ("Valid values are within the frame dimensions."));
-				    exit(1);
+				    return GST_FLOW_ERROR;
 				} else {
 				    // If not in strict mode, issue a warning
 				    g_warning ("Coordinates out of bounds '<%d, %d>' for coordinate property. Valid values are within the frame dimensions.",
@@ -991,197 +2866,30 @@ gst_insert_logo_scroll_logo(GstInsertLogo *filter, guint8 *y_pixels, guint8 *uv_
 		  filter->scrl_dflt_cord = TRUE;		
 		}
     
-    guint8 *data = cairo_image_surface_get_data(image_surface);
-    
-    //setting alpha to 100
-    if(filter->alpha == -1){
-    	filter->alpha = 100;
-    }
-    gdouble Alpha_Factor = (filter->alpha / 100.0);
-    
-    if (strcmp (filter->scroll, "ltr") == 0 ) {
-			// Scroll from left to right
-			if(strcmp (filter->speed, "slow") == 0){
-		 		filter->coordinate[0] = filter->coordinate[0] + 2;
-		 		if(filter->coordinate[0] >= filter->frame_width + filter->overlay_width){
-   				filter->coordinate[0] = 0 - filter->overlay_width;
-   			}   		
-		 	} else if(strcmp (filter->speed, "medium") == 0){
-		 		filter->coordinate[0] = filter->coordinate[0] + 3;
-		 		if(filter->coordinate[0] >= filter->frame_width + filter->overlay_width){
-   				filter->coordinate[0] = 0 - filter->overlay_width;
-   			}
-		 	} else if(strcmp (filter->speed, "fast") == 0){
-		 		filter->coordinate[0] = filter->coordinate[0] + 4;
-		 		if(filter->coordinate[0] >= filter->frame_width + filter->overlay_width){
-   				filter->coordinate[0] = 0 - filter->overlay_width;
-   			}   		
-		 	} 
-  	} else if(strcmp (filter->scroll, "rtl") == 0 ){
-			// Scroll from right to left
-			if(strcmp (filter->speed, "slow") == 0){
-		 		filter->coordinate[0] = filter->coordinate[0] - 2;
-		 		if(filter->coordinate[0] <= (0 - filter->overlay_width)){
-   				filter->coordinate[0] = filter->frame_width + filter->overlay_width;
-   			}
-		 	} else if(strcmp (filter->speed, "medium") == 0){
-		 		filter->coordinate[0] = filter->coordinate[0] - 3;
-		 		if(filter->coordinate[0] <= (0 - filter->overlay_width)){
-   				filter->coordinate[0] = filter->frame_width + filter->overlay_width;
-   			}
-		 	} else if(strcmp (filter->speed, "fast") == 0){
-		 		filter->coordinate[0] = filter->coordinate[0] - 4;
-		 		if(filter->coordinate[0] <= (0 - filter->overlay_width)){
-   				filter->coordinate[0] = filter->frame_width + filter->overlay_width;
-   			}
-		 	} 
-  	}
     
-    gint j, i;
-		gint wrapped_i, wrapped_j;
-		guint8 *y_pixel, *uv_pixel;
-		guint8 Red, Green, Blue, Alpha;
-		guint8 Y, U, V;
-		    
-		if((width_logo < (filter->frame_width/6)) && (height_logo < (filter->frame_height/6)))
-    {
-		  for (j = 0; j < height_logo; j++)
-			{
-					for (i = 0; i < width_logo; i++)
-					{
-						  // Calculate the wrapped-around i and j coordinates
-						  wrapped_i = (i + filter->coordinate[0]) % filter->frame_width;
-						  wrapped_j = (j + filter->coordinate[1]) % filter->frame_height;
-
-						  // Get pointers to the Y and UV components of the frame at the rotated coordinates
-						  y_pixel = y_pixels + wrapped_j * y_stride + wrapped_i;
-						  uv_pixel = uv_pixels + (wrapped_j / 2) * uv_stride + (wrapped_i / 2) * 2;
-
-						  // Extract RGBA values from the logo image
-						  Red = data[(j * width_logo + i) * 4];
-						  Green = data[(j * width_logo + i) * 4 + 1];
-						  Blue = data[(j * width_logo + i) * 4 + 2];
-						  Alpha = data[(j * width_logo + i) * 4 + 3] * Alpha_Factor;
-
-						  // Convert RGB to YUV
-						  Y = (0.257 * Red) + (0.504 * Green) + (0.098 * Blue) + 16;  // Y component
-						  U = (0.439 * Red) - (0.368 * Green) - (0.071 * Blue) + 128;  // U component
-						  V = -(0.148 * Red) - (0.291 * Green) + (0.439 * Blue) + 128;  // V component
-
-						  // Alpha blending
-						  Y = ((255 - Alpha) * (*y_pixel) + Alpha * Y) / 255;
-						  U = ((255 - Alpha) * (uv_pixel[0]) + Alpha * U) / 255;
-						  V = ((255 - Alpha) * (uv_pixel[1]) + Alpha * V) / 255;
-
-						  *y_pixel = Y;
-						  uv_pixel[0] = U;
-						  uv_pixel[1] = V;
-					}
-			}
-		} else {
-        // Error if the logo dimensions are too large
-        cairo_surface_destroy(image_surface);
-        GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Logo dimensions are too large."),
-				("The logo size should be less than one-sixth of the frame size."));
-				exit(1);
-    }
-    cairo_surface_destroy(image_surface);
+    return gst_insert_logo_add_fitted(filter, frame, logo, FALSE);
 }
 
 /**
  * @brief Imposes the logo onto the YUV frame and rotate it on the specified coordinates with alpha blending.
  *
- * This function loads the logo image from the file specified in the filter and imposes it onto the YUV frame
- * at the specified coordinates with alpha blending and rotate it.
+ * This function rotates the logo prepared by the logo cache and imposes it onto the YUV frame
+ * at the specified coordinates with alpha blending.
  *
  * @param filter The GstInsertLogo filter instance.
- * @param y_pixels The Y plane pixels of the YUV frame.
- * @param uv_pixels The UV plane pixels of the YUV frame.
- * @param y_stride The stride of the Y plane.
- * @param uv_stride The stride of the UV plane.
+ * @param frame The mapped video frame.
+ * @param logo The logo prepared for the frame resolution.
+ * @return GST_FLOW_ERROR if strict mode rejects the coordinate or the logo size.
  */
-static void
-gst_insert_logo_rotate_logo(GstInsertLogo *filter, guint8 *y_pixels, guint8 *uv_pixels, guint y_stride, guint uv_stride)
+static GstFlowReturn
+gst_insert_logo_rotate_logo(GstInsertLogo *filter, GstVideoFrame *frame, GstLogoImage *logo)
 {
           
-    // Check the Rotete direction
-		if (strcmp (filter->rotation, "clockwise") == 0 ) {
-			// Rotate Clockwise
-			if(strcmp (filter->speed, "slow") == 0){
-		 		filter->degree = filter->degree + 0.5;
-		 		if(filter->degree >= 360){
-		 			filter->degree = 0 ;
-		 		}
-		 	} else if(strcmp (filter->speed, "medium") == 0){
-		 		filter->degree = filter->degree + 1.5;
-		 		if(filter->degree >= 360){
-		 			filter->degree = 0 ;
-		 		}
-		 	} else if(strcmp (filter->speed, "fast") == 0){
-		 		filter->degree = filter->degree + 2.5;
-		 		if(filter->degree >= 360){
-		 			filter->degree = 0 ;
-		 		}
-		 	}
-		} else if (strcmp (filter->rotation, "counter-clockwise") == 0 ) {
-			// Rotate AntiClockwise
-			if(strcmp (filter->speed, "slow") == 0){
-		 		filter->degree = filter->degree - 0.5;
-		 		if(filter->degree <= -360){
-		 			filter->degree = 0 ;
-		 		}
-		 	} else if(strcmp (filter->speed, "medium") == 0){
-		 		filter->degree = filter->degree - 1.5;
-		 		if(filter->degree <= -360){
-		 			filter->degree = 0 ;
-		 		}
-		 	} else if(strcmp (filter->speed, "fast") == 0){
-		 		filter->degree = filter->degree - 2.5;
-		 		if(filter->degree <= -360){
-		 			filter->degree = 0 ;
-		 		}
-		 	}
-		}
-		
-    // Load the PNG image
-    cairo_surface_t *image_surface = cairo_image_surface_create_from_png(filter->logo);
-    if (cairo_surface_status(image_surface) != CAIRO_STATUS_SUCCESS)
-    {
-        fprintf(stderr, "Error loading image: %s\n", cairo_status_to_string(cairo_surface_status(image_surface)));
-        return;
-    }
-
-    int width = cairo_image_surface_get_width(image_surface);
-    int height = cairo_image_surface_get_height(image_surface);
-
-    // Determine the size of the rotated image
-    double angle_radians = filter->degree * (M_PI / 180.0);
-    //double cos_theta = fabs(cos(angle_radians));
-    //double sin_theta = fabs(sin(angle_radians));
-    //int width_rotated = ceil(width * cos_theta + height * sin_theta);
-    //int height_rotated = ceil(width * sin_theta + height * cos_theta);
+    int width = logo->width;
+    int height = logo->height;
 
-    // Create a new surface for the rotated image
+    // The rotated logo is drawn into a square of its longer side
     int max_size = width > height ? width : height;
-    cairo_surface_t *rotated_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, max_size, max_size);
-    cairo_t *cr = cairo_create(rotated_surface);
-
-    // Calculate the center of the new surface
-    double center_x = max_size / 2.0;
-    double center_y = max_size / 2.0;
-
-    // Calculate the offset to center the original image
-    double offset_x = (max_size - width) / 2.0;
-    double offset_y = (max_size - height) / 2.0;
-    
-   // Rotate the image around its center
-    cairo_translate(cr, center_x, center_y);
-    cairo_rotate(cr, angle_radians);
-    cairo_translate(cr, -center_x, -center_y);
-
-    // Draw the rotated image
-    cairo_set_source_surface(cr, image_surface, offset_x, offset_y);
-    cairo_paint(cr);
 
     guint width_logo = max_size;
     guint height_logo = max_size;
@@ -1191,11 +2899,9 @@ gst_insert_logo_rotate_logo(GstInsertLogo *filter, guint8 *y_pixels, guint8 *uv_
 		  
 		  if(filter->strict){
 		      // If strict mode is enabled, raise an error and abort
-			    cairo_surface_destroy(image_surface);
-			    cairo_surface_destroy(rotated_surface);
 			    GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid value (negative) for coordinate property."),
 			    ("Valid values are positive integer numbers."));
-			    exit(1);
+			    return GST_FLOW_ERROR;
 		  } else {
 		      // If not in strict mode, issue a warning
 		      g_warning ("Invalid value (negative) '<%d, %d>' for coordinate property. Valid values are positive integer numbers.",
@@ -1221,10 +2927,9 @@ gst_insert_logo_rotate_logo(GstInsertLogo *filter, guint8 *y_pixels, guint8 *uv_
 		if(!filter->dflt && (filter->coordinate[0] > filter->frame_width || filter->coordinate[1] > filter->frame_height)){
 				if(filter->strict){
 				    // If strict mode is enabled, raise an error and abort
-				    cairo_surface_destroy(image_surface);
-			    	cairo_surface_destroy(rotated_surface);
 			    	GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Invalid coordinates for the coordinate property."),
 			    ("Valid values are within the frame dimensions."));
+				    return GST_FLOW_ERROR;
 				} else {
 				    // If not in strict mode, issue a warning
 				    g_warning ("Coordinates out of bounds '<%d, %d>' for coordinate property. Valid values are within the frame dimensions.",
@@ -1242,12 +2947,6 @@ gst_insert_logo_rotate_logo(GstInsertLogo *filter, guint8 *y_pixels, guint8 *uv_
 		  filter->scrl_dflt_cord = TRUE;		
 		}
     
-    guint8 *data = cairo_image_surface_get_data(rotated_surface);
-    
-    //setting alpha to 100
-    if(filter->alpha == -1){
-    	filter->alpha = 100;
-    }
     
     if(!filter->adjust_y_cord){
     	filter->coordinate[1] = filter->coordinate[1] - ((int)max_size / 2);
@@ -1256,57 +2955,8 @@ gst_insert_logo_rotate_logo(GstInsertLogo *filter, guint8 *y_pixels, guint8 *uv_
     	}
     	filter->adjust_y_cord = TRUE;
     }
-    
-    gdouble Alpha_Factor = (filter->alpha / 100.0);
     				
-		if((width < (filter->frame_width/6)) && (height < (filter->frame_height/6)))
-    {		
-			for (gint j = 0; j < height_logo; j++)
-			{
-					// Calculate the wrapped-around j coordinate
-					gint wrapped_j = (j + filter->coordinate[1]) % filter->frame_height;
-
-					for (gint i = 0; i < width_logo; i++)
-					{
-						  // Calculate the wrapped-around i coordinate
-						  gint wrapped_i = (i + filter->coordinate[0]) % filter->frame_width;
-
-						  guint8 *y_pixel = y_pixels + wrapped_j * y_stride + wrapped_i;
-						  guint8 *uv_pixel = uv_pixels + (wrapped_j / 2) * uv_stride + (wrapped_i / 2) * 2;
-
-						  // Extract RGBA values from the logo image
-						  guint8 Red = data[(j * width_logo + i) * 4];
-						  guint8 Green = data[(j * width_logo + i) * 4 + 1];
-						  guint8 Blue = data[(j * width_logo + i) * 4 + 2];
-						  guint8 Alpha = data[(j * width_logo + i) * 4 + 3] * Alpha_Factor;
-
-						  // Convert RGBA to YUV
-						  guint8 Y = (0.257 * Red) + (0.504 * Green) + (0.098 * Blue) + 16;  // Y component
-						  guint8 U = (0.439 * Red) - (0.368 * Green) - (0.071 * Blue) + 128;  // U component
-						  guint8 V = -(0.148 * Red) - (0.291 * Green) + (0.439 * Blue) + 128;  // V component
-
-						  // Alpha blending
-						  Y = ((255 - Alpha) * (*y_pixel) + Alpha * Y) / 255;
-						  U = ((255 - Alpha) * (uv_pixel[0]) + Alpha * U) / 255;
-						  V = ((255 - Alpha) * (uv_pixel[1]) + Alpha * V) / 255;
-
-						  // Update the Y and UV components of the frame with the blended values
-						  *y_pixel = Y;
-						  uv_pixel[0] = U;
-						  uv_pixel[1] = V;
-					}
-			}
-		} else {
-        // Error if the logo dimensions are too large
-        cairo_surface_destroy(image_surface);
-        GST_ELEMENT_ERROR(filter, RESOURCE, NOT_FOUND, ("Logo dimensions are too large."),
-				("The logo size should be less than one-sixth of the frame size."));
-				exit(1);
-    }
-
-		cairo_destroy(cr);
-    cairo_surface_destroy(rotated_surface);
-    cairo_surface_destroy(image_surface);
+    return gst_insert_logo_add_fitted(filter, frame, logo, TRUE);
 }
 
 /**
@@ -56,6 +56,19 @@
 #include <math.h>
 #include <cairo.h>
 
+#include "gstlogoanim.h"
+#include "gstlogocache.h"
+#include "gstlogocontrast.h"
+#include "gstlogocover.h"
+#include "gstlogolayer.h"
+#include "gstlogoplaylist.h"
+#include "gstlogoqos.h"
+#include "gstlogoschedule.h"
+#include "gstlogoseq.h"
+#include "gstlogostats.h"
+#include "gstlogoticker.h"
+#include "gstlogotrace.h"
+
 
 G_BEGIN_DECLS
 
@@ -78,11 +91,57 @@ G_DECLARE_FINAL_TYPE (GstInsertLogo, gst_insert_logo,
 
 #define DFLT_ROTATE		"NoRotate"
 #define DFLT_VAL			-1
+#define DFLT_ALPHA		100
+#define MAX_COORDINATE	8192
 #define DFLT_BOOL 		TRUE
 #define DFLT_NOT_BOOL FALSE
 #define DFLE_ROTATE		0
 #define DFLT_SCROLL		"off"
 #define DFLT_SPEED		"slow"
+#define DFLT_LOGO_SCALE	"off"
+#define DFLT_PATH		"off"
+#define DFLT_REPEAT		"loop"
+#define DFLT_ZOOM		"off"
+#define DFLT_LOGO_FPS		25.0
+#define DFLT_LOGO_MEMORY	64
+#define DFLT_CROSSFADE		0.5
+#define DFLT_QOS			TRUE
+#define DFLT_BLEND_SPACE	GST_LOGO_BLEND_SPACE_GAMMA
+#define DFLT_AUTO_CONTRAST	"off"
+#define DFLT_CONTRAST_INTERVAL	1
+#define DFLT_TICKER_SPEED	120.0
+#define DFLT_TICKER_BACKGROUND	0x00000000
+
+/* Name of the custom downstream event that switches the overlay on and off */
+#define GST_INSERT_LOGO_CONTROL_EVENT "insert-logo-control"
+
+/* The overlay follows the schedule unless a control event overrides it */
+#define GST_INSERT_LOGO_CONTROL_AUTO	-1
+
+/* Number of values the logo animation timeline is built for */
+#define GST_INSERT_LOGO_ANIM_KEY_LEN 11
+
+/* Rotated sprites kept for reuse: the logo and its auto-contrast variant,
+ * and both again for the logo a playlist crossfades into */
+#define GST_INSERT_LOGO_TRANSFORMED 4
+
+/**
+ * GstInsertLogoTransformed:
+ * @sprite: A rotated or scaled logo sprite, NULL if the slot is empty.
+ * @surface: The logo surface @sprite was drawn from.
+ * @angle: The rotation @sprite was drawn with.
+ * @scale: The scale @sprite was drawn with.
+ *
+ * A transformed logo sprite kept for reuse while its surface, angle and
+ * scale stay the same.
+ */
+typedef struct
+{
+  GstLogoSprite *sprite;
+  cairo_surface_t *surface;
+  gfloat angle;
+  gfloat scale;
+} GstInsertLogoTransformed;
 
 /**
  * GST_TYPE_INSERTLOGO:
@@ -158,8 +217,84 @@ G_DECLARE_FINAL_TYPE (GstInsertLogo, gst_insert_logo,
  * @dflt_rotate: Whether default rotation is used.
  * @dflt_speed: Whether default speed is used.
  * @dflt_scrl: Whether default scrolling is used.
- * @dflt_alpha: Whether default alpha value is used.
  * @check_Property_validation: Whether property validation is checked.
+ * @adjust_y_cord: Whether the y coordinate was adjusted for rotation.
+ * @logo_scale: The logo scaling mode as set on the property.
+ * @scale: The parsed logo scaling mode.
+ * @dflt_logo_scale: Whether default logo scaling is used.
+ * @cache: The per-resolution cache of the prepared logo.
+ * @layer_descs: The layer descriptions as set on the layers property.
+ * @layers: The additional overlay layers, swapped under the object lock.
+ * @invalid_layers: Whether a layer description was rejected.
+ * @placements: The sprites to blend into the current frame.
+ * @frame_sprites: Sprites built for the current frame only.
+ * @logo_failed: Whether the logo failed to load, so the failure is reported once.
+ * @segment: The current segment, to convert timestamps to running time.
+ * @running_time: The running time of the current frame.
+ * @n_frames: Number of frames since the last segment, for untimestamped buffers.
+ * @path_str: The path animation as set on the property.
+ * @path: The parsed path animation.
+ * @dflt_path: Whether default path animation is used.
+ * @repeat_str: The repeat mode as set on the property.
+ * @repeat: The parsed repeat mode.
+ * @dflt_repeat: Whether default repeat mode is used.
+ * @zoom_str: The zoom animation as set on the property.
+ * @zoom: The parsed zoom animation.
+ * @dflt_zoom: Whether default zoom animation is used.
+ * @keyframe_descs: The keyframes as set on the keyframes property.
+ * @invalid_keyframes: Whether a keyframe description was rejected.
+ * @anim: The animation timeline of the logo.
+ * @anim_key: The values @anim was built for.
+ * @anim_dirty: Whether @anim has to be built again.
+ * @anim_relative: Whether @anim starts at the origin and is moved to @coordinate.
+ * @logo_fps: The frame rate of numbered logo sequences.
+ * @logo_memory: The memory budget of decoded logo frames in MiB.
+ * @sequence: The player of animated logos.
+ * @animated: Whether the logo is an APNG or a numbered sequence.
+ * @playlist_descs: The entries as set on the playlist property.
+ * @invalid_playlist: Whether a playlist entry was rejected.
+ * @playlist_file: The playlist file as set on the property.
+ * @crossfade: The crossfade between playlist logos in seconds.
+ * @playlist: The sponsor logo playlist, replaces the logo when not empty.
+ * @fade_logo: The playlist logo faded in over the current frame.
+ * @fade_mix: The opacity of @fade_logo, 0 to 255.
+ * @video_info: The negotiated video format.
+ * @schedule_descs: The windows as set on the schedule property.
+ * @schedule: The #GstLogoWindow array, swapped under the object lock.
+ * @invalid_schedule: Whether a window description was rejected.
+ * @cover_descs: The regions as set on the covers property.
+ * @covers: The #GstLogoCover array, swapped under the object lock.
+ * @invalid_covers: Whether a cover description was rejected.
+ * @ticker_path: The ticker strip as set on the ticker property.
+ * @ticker: The news ticker crawling the strip through its band.
+ * @ticker_y: The top of the ticker band, -1 for the bottom of the frame.
+ * @ticker_speed: The speed of the ticker in pixels per second.
+ * @ticker_background: The colour of the ticker band as 0xAARRGGBB.
+ * @control: Whether a control event switched the overlay on (1) or off (0),
+ *     GST_INSERT_LOGO_CONTROL_AUTO to follow the schedule.
+ * @control_fade: The fade duration of the last control event.
+ * @control_start: The running time the last control event took effect.
+ * @control_from: The overlay opacity when the last control event arrived.
+ * @level: The overlay opacity of the last frame, 0 to 255.
+ * @qos_enabled: Whether the animations are degraded when frames are late.
+ * @qos: The degradation ladder.
+ * @qos_proportion: The proportion of the latest QoS event.
+ * @qos_diff: The lateness of the latest QoS event.
+ * @blend_space: Whether luma and RGB are blended in linear light.
+ * @effects: The shadow, outline and glow drawn around the logo.
+ * @auto_contrast_str: The auto-contrast mode as set on the property.
+ * @dflt_auto_contrast: Whether default auto-contrast mode is used.
+ * @contrast: The parsed auto-contrast mode and its smoothed state.
+ * @contrast_interval: Frames from one measurement of the video under the
+ *     logo to the next.
+ * @anim_time: The running time the logo animation is evaluated at.
+ * @transformed: The rotated logo sprites, one per logo surface, most
+ *     recently used first.
+ * @stats: The blend cost statistics of the instance.
+ * @stats_interval: Milliseconds between statistics messages, 0 for none.
+ * @stats_next: Monotonic time of the next statistics message.
+ * @caps_time: Monotonic time the first caps arrived, 0 before.
+ * @trace: The hooks of a tracer for the current buffer, NULL if none.
  */
 struct _GstInsertLogo
 {
@@ -187,9 +322,81 @@ struct _GstInsertLogo
   gboolean dflt_rotate;
   gboolean dflt_speed;
   gboolean dflt_scrl;
-  gboolean dflt_alpha;
   gboolean check_Property_validation;
   gboolean adjust_y_cord;
+  gchar *logo_scale;
+  GstLogoScale scale;
+  gboolean dflt_logo_scale;
+  GstLogoCache *cache;
+  GPtrArray *layer_descs;
+  GPtrArray *layers;
+  gboolean invalid_layers;
+  GArray *placements;
+  GPtrArray *frame_sprites;
+  gboolean logo_failed;
+  GstSegment segment;
+  GstClockTime running_time;
+  guint64 n_frames;
+  gchar *path_str;
+  GstLogoPath path;
+  gboolean dflt_path;
+  gchar *repeat_str;
+  GstLogoRepeat repeat;
+  gboolean dflt_repeat;
+  gchar *zoom_str;
+  GstLogoZoom zoom;
+  gboolean dflt_zoom;
+  GPtrArray *keyframe_descs;
+  gboolean invalid_keyframes;
+  GstLogoAnim *anim;
+  gint anim_key[GST_INSERT_LOGO_ANIM_KEY_LEN];
+  gboolean anim_dirty;
+  gboolean anim_relative;
+  gdouble logo_fps;
+  guint logo_memory;
+  GstLogoSequence *sequence;
+  gboolean animated;
+  GPtrArray *playlist_descs;
+  gboolean invalid_playlist;
+  gchar *playlist_file;
+  gdouble crossfade;
+  GstLogoPlaylist *playlist;
+  GstLogoImage *fade_logo;
+  guint fade_mix;
+  GstVideoInfo video_info;
+  GPtrArray *schedule_descs;
+  GArray *schedule;
+  gboolean invalid_schedule;
+  GPtrArray *cover_descs;
+  GArray *covers;
+  gboolean invalid_covers;
+  gchar *ticker_path;
+  GstLogoTicker *ticker;
+  gint ticker_y;
+  gdouble ticker_speed;
+  guint32 ticker_background;
+  gint control;
+  GstClockTime control_fade;
+  GstClockTime control_start;
+  guint control_from;
+  guint level;
+  gboolean qos_enabled;
+  GstLogoQos qos;
+  gdouble qos_proportion;
+  GstClockTimeDiff qos_diff;
+  GstLogoBlendSpace blend_space;
+  GstLogoEffects effects;
+  gchar *auto_contrast_str;
+  gboolean dflt_auto_contrast;
+  GstLogoContrast contrast;
+  guint contrast_interval;
+  GstClockTime anim_time;
+  GstInsertLogoTransformed transformed[GST_INSERT_LOGO_TRANSFORMED];
+  GstLogoStats stats;
+  guint stats_interval;
+  gint64 stats_next;
+  gint64 caps_time;
+  const GstLogoTraceHooks *trace;
 };
 
 
@@ -0,0 +1,535 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "gstlogoanim.h"
+
+/* Upper bound of the sampled timeline, the step grows for long timelines */
+#define GST_LOGO_ANIM_MAX_STATES 65536
+
+/* Largest size of a pulsing logo relative to its own size */
+#define GST_LOGO_ANIM_PULSE_SCALE 1.15
+
+/**
+ * @brief Parses an easing name (linear, in, out, in-out).
+ */
+gboolean
+gst_logo_easing_parse (const gchar * str, GstLogoEasing * easing)
+{
+  static const gchar *names[] = { "linear", "in", "out", "in-out" };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (names); i++) {
+    if (g_strcmp0 (str, names[i]) == 0) {
+      *easing = i;
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/**
+ * @brief Parses a repeat mode name (once, loop, bounce).
+ */
+gboolean
+gst_logo_repeat_parse (const gchar * str, GstLogoRepeat * repeat)
+{
+  static const gchar *names[] = { "once", "loop", "bounce" };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (names); i++) {
+    if (g_strcmp0 (str, names[i]) == 0) {
+      *repeat = i;
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/**
+ * @brief Parses a path name (off, horizontal, vertical, diagonal).
+ */
+gboolean
+gst_logo_path_parse (const gchar * str, GstLogoPath * path)
+{
+  static const gchar *names[] = { "off", "horizontal", "vertical",
+    "diagonal"
+  };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (names); i++) {
+    if (g_strcmp0 (str, names[i]) == 0) {
+      *path = i;
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/**
+ * @brief Parses a zoom name (off, pulse, in).
+ */
+gboolean
+gst_logo_zoom_parse (const gchar * str, GstLogoZoom * zoom)
+{
+  static const gchar *names[] = { "off", "pulse", "in" };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (names); i++) {
+    if (g_strcmp0 (str, names[i]) == 0) {
+      *zoom = i;
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/**
+ * @brief Looks up the animation speed of a speed name (slow, medium, fast).
+ *
+ * The speeds match the former per-frame steps at 30 frames per second:
+ * 60, 90 or 120 pixels per second when moving and 15, 45 or 75 degrees
+ * per second when rotating.
+ *
+ * @param str The speed name.
+ * @param rotate Whether the speed is for a rotation.
+ * @param speed Return location for the speed per second.
+ * @return TRUE if @str is valid.
+ */
+gboolean
+gst_logo_speed_parse (const gchar * str, gboolean rotate, gdouble * speed)
+{
+  static const gchar *names[] = { "slow", "medium", "fast" };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (names); i++) {
+    if (g_strcmp0 (str, names[i]) == 0) {
+      *speed = rotate ? 15 + 30 * i : 60 + 30 * i;
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/* Reads a number given either as integer or as double */
+static gboolean
+gst_logo_keyframe_get_number (const GstStructure * s, const gchar * field,
+    gdouble * value)
+{
+  gint i;
+
+  if (!gst_structure_has_field (s, field))
+    return TRUE;
+  if (gst_structure_get_double (s, field, value))
+    return TRUE;
+  if (gst_structure_get_int (s, field, &i)) {
+    *value = i;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+/**
+ * @brief Reads a keyframe from its description.
+ *
+ * Known fields are "t" (seconds, required), "x", "y", "angle" (degrees),
+ * "alpha" (0 to 100), "scale" and "ease" (linear, in, out, in-out). Fields
+ * that are not given keep the value of @prev.
+ *
+ * @param s The keyframe description.
+ * @param prev The previous keyframe or the defaults for the first one.
+ * @param kf Return location for the keyframe.
+ * @return TRUE if @s was valid.
+ */
+gboolean
+gst_logo_keyframe_parse (const GstStructure * s, const GstLogoKeyframe * prev,
+    GstLogoKeyframe * kf)
+{
+  gdouble t = -1;
+  const gchar *ease;
+
+  *kf = *prev;
+  kf->easing = GST_LOGO_EASE_LINEAR;
+
+  if (!gst_structure_has_field (s, "t")
+      || !gst_logo_keyframe_get_number (s, "t", &t) || t < 0)
+    return FALSE;
+  kf->time = t * GST_SECOND;
+
+  if (!gst_logo_keyframe_get_number (s, "x", &kf->x)
+      || !gst_logo_keyframe_get_number (s, "y", &kf->y)
+      || !gst_logo_keyframe_get_number (s, "angle", &kf->angle)
+      || !gst_logo_keyframe_get_number (s, "alpha", &kf->alpha)
+      || !gst_logo_keyframe_get_number (s, "scale", &kf->scale))
+    return FALSE;
+  if (kf->alpha < 0 || kf->alpha > 100 || kf->scale <= 0 || kf->scale > 16)
+    return FALSE;
+
+  ease = gst_structure_get_string (s, "ease");
+  if (ease != NULL && !gst_logo_easing_parse (ease, &kf->easing))
+    return FALSE;
+
+  return TRUE;
+}
+
+/**
+ * @brief Creates an empty timeline.
+ */
+GstLogoAnim *
+gst_logo_anim_new (GstLogoRepeat repeat)
+{
+  GstLogoAnim *anim = g_new0 (GstLogoAnim, 1);
+
+  anim->keyframes = g_array_new (FALSE, FALSE, sizeof (GstLogoKeyframe));
+  anim->repeat = repeat;
+
+  return anim;
+}
+
+/**
+ * @brief Frees a timeline.
+ *
+ * @param anim The timeline to free, may be NULL.
+ */
+void
+gst_logo_anim_free (GstLogoAnim * anim)
+{
+  if (anim == NULL)
+    return;
+
+  g_array_free (anim->keyframes, TRUE);
+  g_free (anim->table);
+  g_free (anim);
+}
+
+/**
+ * @brief Adds a keyframe, keeping the keyframes sorted by time.
+ *
+ * The timeline has to be compiled again afterwards.
+ */
+void
+gst_logo_anim_add_keyframe (GstLogoAnim * anim, const GstLogoKeyframe * kf)
+{
+  guint i = anim->keyframes->len;
+
+  while (i > 0 && g_array_index (anim->keyframes, GstLogoKeyframe,
+          i - 1).time > kf->time)
+    i--;
+  g_array_insert_val (anim->keyframes, i, *kf);
+
+  anim->duration = g_array_index (anim->keyframes, GstLogoKeyframe,
+      anim->keyframes->len - 1).time;
+}
+
+/* A keyframe at a position with everything else neutral */
+static GstLogoKeyframe
+gst_logo_anim_keyframe (GstClockTime time, gdouble x, gdouble y, gint alpha)
+{
+  GstLogoKeyframe kf = { time, x, y, 0, alpha, 1.0, GST_LOGO_EASE_LINEAR };
+
+  return kf;
+}
+
+/**
+ * @brief Creates a timeline holding a logo at one position.
+ */
+GstLogoAnim *
+gst_logo_anim_new_static (gint x, gint y, gint alpha)
+{
+  GstLogoAnim *anim = gst_logo_anim_new (GST_LOGO_REPEAT_ONCE);
+  GstLogoKeyframe kf = gst_logo_anim_keyframe (0, x, y, alpha);
+
+  gst_logo_anim_add_keyframe (anim, &kf);
+  return anim;
+}
+
+/**
+ * @brief Creates a looping horizontal scroll.
+ *
+ * The position grows by @distance per cycle, so the caller wraps it into
+ * the scroll range.
+ *
+ * @param x Start position.
+ * @param y Vertical position.
+ * @param alpha Opacity, 0 to 100.
+ * @param distance Length of one cycle in pixels, negative to the left.
+ * @param speed Speed in pixels per second.
+ */
+GstLogoAnim *
+gst_logo_anim_new_scroll (gint x, gint y, gint alpha, gint distance,
+    gdouble speed)
+{
+  GstLogoAnim *anim = gst_logo_anim_new (GST_LOGO_REPEAT_LOOP);
+  GstLogoKeyframe kf = gst_logo_anim_keyframe (0, x, y, alpha);
+
+  gst_logo_anim_add_keyframe (anim, &kf);
+  kf.time = ABS (distance) / speed * GST_SECOND;
+  kf.x = x + distance;
+  gst_logo_anim_add_keyframe (anim, &kf);
+
+  return anim;
+}
+
+/**
+ * @brief Creates a looping rotation.
+ *
+ * @param x Horizontal position.
+ * @param y Vertical position.
+ * @param alpha Opacity, 0 to 100.
+ * @param speed Speed in degrees per second, negative counter-clockwise.
+ */
+GstLogoAnim *
+gst_logo_anim_new_spin (gint x, gint y, gint alpha, gdouble speed)
+{
+  GstLogoAnim *anim = gst_logo_anim_new (GST_LOGO_REPEAT_LOOP);
+  GstLogoKeyframe kf = gst_logo_anim_keyframe (0, x, y, alpha);
+
+  gst_logo_anim_add_keyframe (anim, &kf);
+  kf.time = 360.0 / fabs (speed) * GST_SECOND;
+  kf.angle = speed > 0 ? 360 : -360;
+  gst_logo_anim_add_keyframe (anim, &kf);
+
+  return anim;
+}
+
+/**
+ * @brief Creates a movement between two edges of the frame.
+ *
+ * @param path Which edges to move between.
+ * @param repeat Whether to jump back or to bounce at the end.
+ * @param x Horizontal position kept by a vertical path.
+ * @param y Vertical position kept by a horizontal path.
+ * @param alpha Opacity, 0 to 100.
+ * @param max_x Largest horizontal position, frame width minus logo width.
+ * @param max_y Largest vertical position, frame height minus logo height.
+ * @param speed Speed in pixels per second.
+ */
+GstLogoAnim *
+gst_logo_anim_new_path (GstLogoPath path, GstLogoRepeat repeat, gint x,
+    gint y, gint alpha, gint max_x, gint max_y, gdouble speed)
+{
+  GstLogoAnim *anim = gst_logo_anim_new (repeat);
+  GstLogoKeyframe from = gst_logo_anim_keyframe (0, x, y, alpha);
+  GstLogoKeyframe to = from;
+
+  max_x = MAX (max_x, 0);
+  max_y = MAX (max_y, 0);
+  if (path != GST_LOGO_PATH_VERTICAL) {
+    from.x = 0;
+    to.x = max_x;
+  }
+  if (path != GST_LOGO_PATH_HORIZONTAL) {
+    from.y = 0;
+    to.y = max_y;
+  }
+  to.time = hypot (to.x - from.x, to.y - from.y) / speed * GST_SECOND;
+
+  gst_logo_anim_add_keyframe (anim, &from);
+  gst_logo_anim_add_keyframe (anim, &to);
+
+  return anim;
+}
+
+/**
+ * @brief Creates a zoom around the center of the logo.
+ *
+ * A zoom takes 90 / @speed seconds, so 1.5, 1 or 0.75 seconds at the
+ * moving speeds. A pulse grows to GST_LOGO_ANIM_PULSE_SCALE and back in
+ * two zooms, a zoom in grows the logo from nothing and holds it.
+ *
+ * @param zoom The zoom animation, not GST_LOGO_ZOOM_OFF.
+ * @param x Horizontal position.
+ * @param y Vertical position.
+ * @param alpha Opacity, 0 to 100.
+ * @param speed Speed in pixels per second.
+ */
+GstLogoAnim *
+gst_logo_anim_new_zoom (GstLogoZoom zoom, gint x, gint y, gint alpha,
+    gdouble speed)
+{
+  gboolean pulse = zoom == GST_LOGO_ZOOM_PULSE;
+  GstLogoAnim *anim = gst_logo_anim_new (pulse ?
+      GST_LOGO_REPEAT_BOUNCE : GST_LOGO_REPEAT_ONCE);
+  GstLogoKeyframe from = gst_logo_anim_keyframe (0, x, y, alpha);
+  GstLogoKeyframe to = from;
+
+  if (pulse) {
+    to.scale = GST_LOGO_ANIM_PULSE_SCALE;
+    to.easing = GST_LOGO_EASE_IN_OUT;
+  } else {
+    from.scale = 0;
+    to.easing = GST_LOGO_EASE_OUT;
+  }
+  to.time = 90.0 / speed * GST_SECOND;
+
+  gst_logo_anim_add_keyframe (anim, &from);
+  gst_logo_anim_add_keyframe (anim, &to);
+
+  return anim;
+}
+
+/* Applies an easing curve to a segment position between 0 and 1 */
+static gdouble
+gst_logo_anim_ease (GstLogoEasing easing, gdouble t)
+{
+  switch (easing) {
+    case GST_LOGO_EASE_IN:
+      return t * t;
+    case GST_LOGO_EASE_OUT:
+      return 1 - (1 - t) * (1 - t);
+    case GST_LOGO_EASE_IN_OUT:
+      return t * t * (3 - 2 * t);
+    default:
+      return t;
+  }
+}
+
+/* Stores a keyframe interpolation in a table entry */
+static void
+gst_logo_anim_sample (const GstLogoKeyframe * a, const GstLogoKeyframe * b,
+    gdouble t, GstLogoAnimState * state)
+{
+  state->x = lround (a->x + (b->x - a->x) * t);
+  state->y = lround (a->y + (b->y - a->y) * t);
+  state->angle = a->angle + (b->angle - a->angle) * t;
+  state->scale = a->scale + (b->scale - a->scale) * t;
+  state->alpha = lround ((a->alpha + (b->alpha - a->alpha) * t) * 255 / 100);
+}
+
+/**
+ * @brief Samples the keyframes into the lookup table.
+ *
+ * @param anim The timeline.
+ * @param step Sampling interval, normally the frame duration. It is made
+ *     larger for timelines that would need too many entries.
+ */
+void
+gst_logo_anim_compile (GstLogoAnim * anim, GstClockTime step)
+{
+  const GstLogoKeyframe *kfs = (const GstLogoKeyframe *) anim->keyframes->data;
+  guint n_kfs = anim->keyframes->len;
+  guint64 n_steps;
+  guint i, k = 0;
+
+  g_free (anim->table);
+  anim->table = NULL;
+  anim->n_states = 0;
+  if (n_kfs == 0)
+    return;
+
+  /* Nothing moves, a single entry is enough */
+  if (n_kfs == 1 || anim->duration == 0 || step == 0) {
+    anim->n_states = 1;
+    anim->table = g_new (GstLogoAnimState, 1);
+    gst_logo_anim_sample (&kfs[n_kfs - 1], &kfs[n_kfs - 1], 0, anim->table);
+    return;
+  }
+
+  /* Rounded so that frame aligned keyframes land on table entries */
+  n_steps = (anim->duration + step / 2) / step;
+  n_steps = CLAMP (n_steps, 1, GST_LOGO_ANIM_MAX_STATES - 1);
+  anim->n_states = n_steps + 1;
+  anim->table = g_new (GstLogoAnimState, anim->n_states);
+
+  for (i = 0; i < anim->n_states; i++) {
+    GstClockTime t = gst_util_uint64_scale (anim->duration, i, n_steps);
+    const GstLogoKeyframe *a, *b;
+    gdouble pos = 0;
+
+    /* Sample times only grow, so the segment is found incrementally */
+    while (k + 1 < n_kfs - 1 && kfs[k + 1].time <= t)
+      k++;
+    if (t < kfs[0].time) {
+      a = b = &kfs[0];
+    } else {
+      a = &kfs[k];
+      b = &kfs[k + 1];
+      if (b->time > a->time)
+        pos = gst_logo_anim_ease (b->easing,
+            MIN ((gdouble) (t - a->time) / (b->time - a->time), 1.0));
+      else
+        pos = 1;
+    }
+    gst_logo_anim_sample (a, b, pos, &anim->table[i]);
+  }
+}
+
+/**
+ * @brief Looks up the state of the timeline at a running time.
+ *
+ * @param anim A compiled timeline.
+ * @param running_time Running time of the frame, GST_CLOCK_TIME_NONE for
+ *     the start of the timeline.
+ * @return The sampled state closest before @running_time.
+ */
+const GstLogoAnimState *
+gst_logo_anim_eval (const GstLogoAnim * anim, GstClockTime running_time)
+{
+  guint64 n, idx;
+
+  if (anim->n_states == 1 || !GST_CLOCK_TIME_IS_VALID (running_time))
+    return &anim->table[0];
+
+  n = anim->n_states - 1;
+  idx = gst_util_uint64_scale (running_time, n, anim->duration);
+
+  switch (anim->repeat) {
+    case GST_LOGO_REPEAT_LOOP:
+      idx %= n;
+      break;
+    case GST_LOGO_REPEAT_BOUNCE:
+      idx %= 2 * n;
+      if (idx > n)
+        idx = 2 * n - idx;
+      break;
+    default:
+      idx = MIN (idx, n);
+      break;
+  }
+
+  return &anim->table[idx];
+}
@@ -0,0 +1,203 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_ANIM_H__
+#define __GST_LOGO_ANIM_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GstLogoEasing:
+ * @GST_LOGO_EASE_LINEAR: constant speed.
+ * @GST_LOGO_EASE_IN: starts slow and speeds up.
+ * @GST_LOGO_EASE_OUT: starts fast and slows down.
+ * @GST_LOGO_EASE_IN_OUT: slow at both ends.
+ */
+typedef enum
+{
+  GST_LOGO_EASE_LINEAR,
+  GST_LOGO_EASE_IN,
+  GST_LOGO_EASE_OUT,
+  GST_LOGO_EASE_IN_OUT
+} GstLogoEasing;
+
+/**
+ * GstLogoRepeat:
+ * @GST_LOGO_REPEAT_ONCE: the last keyframe is held.
+ * @GST_LOGO_REPEAT_LOOP: the timeline restarts from the first keyframe.
+ * @GST_LOGO_REPEAT_BOUNCE: the timeline plays forwards and backwards.
+ */
+typedef enum
+{
+  GST_LOGO_REPEAT_ONCE,
+  GST_LOGO_REPEAT_LOOP,
+  GST_LOGO_REPEAT_BOUNCE
+} GstLogoRepeat;
+
+/**
+ * GstLogoPath:
+ * @GST_LOGO_PATH_OFF: no path animation.
+ * @GST_LOGO_PATH_HORIZONTAL: moves between the left and right edges.
+ * @GST_LOGO_PATH_VERTICAL: moves between the top and bottom edges.
+ * @GST_LOGO_PATH_DIAGONAL: moves between the top left and bottom right
+ *     corners.
+ */
+typedef enum
+{
+  GST_LOGO_PATH_OFF,
+  GST_LOGO_PATH_HORIZONTAL,
+  GST_LOGO_PATH_VERTICAL,
+  GST_LOGO_PATH_DIAGONAL
+} GstLogoPath;
+
+/**
+ * GstLogoZoom:
+ * @GST_LOGO_ZOOM_OFF: no zoom animation.
+ * @GST_LOGO_ZOOM_PULSE: the logo grows and shrinks around its size.
+ * @GST_LOGO_ZOOM_IN: the logo grows from nothing to its size once.
+ */
+typedef enum
+{
+  GST_LOGO_ZOOM_OFF,
+  GST_LOGO_ZOOM_PULSE,
+  GST_LOGO_ZOOM_IN
+} GstLogoZoom;
+
+/**
+ * GstLogoKeyframe:
+ * @time: running time of the keyframe relative to the timeline start.
+ * @x: horizontal position in luma pixels.
+ * @y: vertical position in luma pixels.
+ * @angle: rotation in degrees, clockwise.
+ * @alpha: opacity, 0 to 100.
+ * @scale: size relative to the prepared logo.
+ * @easing: easing of the segment ending at this keyframe.
+ */
+typedef struct
+{
+  GstClockTime time;
+  gdouble x;
+  gdouble y;
+  gdouble angle;
+  gdouble alpha;
+  gdouble scale;
+  GstLogoEasing easing;
+} GstLogoKeyframe;
+
+/**
+ * GstLogoAnimState:
+ * @x: horizontal position in luma pixels.
+ * @y: vertical position in luma pixels.
+ * @angle: rotation in degrees, clockwise.
+ * @scale: size relative to the prepared logo.
+ * @alpha: opacity, 0 to 255.
+ *
+ * One sampled entry of a compiled timeline.
+ */
+typedef struct
+{
+  gint32 x;
+  gint32 y;
+  gfloat angle;
+  gfloat scale;
+  guint8 alpha;
+} GstLogoAnimState;
+
+/**
+ * GstLogoAnim:
+ * @keyframes: the keyframes sorted by time.
+ * @repeat: what happens after the last keyframe.
+ * @duration: time of the last keyframe.
+ * @n_states: number of entries in @table.
+ * @table: the timeline sampled at equal steps from 0 to @duration.
+ *
+ * An animation timeline. The state at a running time is a pure function
+ * of that running time, so frames can be rendered in any order and the
+ * speed does not depend on the framerate. The keyframes are sampled into
+ * a table once by gst_logo_anim_compile() so that evaluating a frame is a
+ * single table lookup.
+ */
+typedef struct
+{
+  GArray *keyframes;
+  GstLogoRepeat repeat;
+  GstClockTime duration;
+  guint n_states;
+  GstLogoAnimState *table;
+} GstLogoAnim;
+
+gboolean gst_logo_easing_parse (const gchar * str, GstLogoEasing * easing);
+gboolean gst_logo_repeat_parse (const gchar * str, GstLogoRepeat * repeat);
+gboolean gst_logo_path_parse (const gchar * str, GstLogoPath * path);
+gboolean gst_logo_zoom_parse (const gchar * str, GstLogoZoom * zoom);
+gboolean gst_logo_speed_parse (const gchar * str, gboolean rotate,
+    gdouble * speed);
+gboolean gst_logo_keyframe_parse (const GstStructure * s,
+    const GstLogoKeyframe * prev, GstLogoKeyframe * kf);
+
+GstLogoAnim *gst_logo_anim_new (GstLogoRepeat repeat);
+void gst_logo_anim_free (GstLogoAnim * anim);
+void gst_logo_anim_add_keyframe (GstLogoAnim * anim,
+    const GstLogoKeyframe * kf);
+
+GstLogoAnim *gst_logo_anim_new_static (gint x, gint y, gint alpha);
+GstLogoAnim *gst_logo_anim_new_scroll (gint x, gint y, gint alpha,
+    gint distance, gdouble speed);
+GstLogoAnim *gst_logo_anim_new_spin (gint x, gint y, gint alpha,
+    gdouble speed);
+GstLogoAnim *gst_logo_anim_new_path (GstLogoPath path, GstLogoRepeat repeat,
+    gint x, gint y, gint alpha, gint max_x, gint max_y, gdouble speed);
+GstLogoAnim *gst_logo_anim_new_zoom (GstLogoZoom zoom, gint x, gint y,
+    gint alpha, gdouble speed);
+
+void gst_logo_anim_compile (GstLogoAnim * anim, GstClockTime step);
+const GstLogoAnimState *gst_logo_anim_eval (const GstLogoAnim * anim,
+    GstClockTime running_time);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_ANIM_H__ */
@@ -0,0 +1,574 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:gstlogocache
+ *
+ * The logo cache decodes the logo file once and keeps one resampled,
+ * pre-converted #GstLogoImage per output resolution. Images are built on a
+ * worker thread as soon as a resolution is negotiated, so the streaming
+ * thread only waits if the first buffer overtakes the worker, and a
+ * resolution that was seen before is served straight from the cache.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogocache.h"
+#include <string.h>
+
+/* One cached resolution, format and colorimetry. @done is set once the
+ * worker has finished it, @image stays NULL if the logo could not be
+ * loaded. */
+typedef struct
+{
+  gint frame_width;
+  gint frame_height;
+  GstVideoFormat format;
+  GstVideoColorimetry colorimetry;
+  gboolean done;
+  GstLogoImage *image;
+} GstLogoCacheSlot;
+
+/* A request for the worker thread */
+typedef struct
+{
+  gint frame_width;
+  gint frame_height;
+  GstVideoFormat format;
+  GstVideoColorimetry colorimetry;
+  guint generation;
+} GstLogoCacheJob;
+
+struct _GstLogoCache
+{
+  GMutex lock;
+  GCond cond;
+  GThreadPool *pool;
+
+  /* protected by lock */
+  gchar *path;
+  GstLogoScale scale;
+  GstLogoEffects effects;
+  guint generation;
+  GPtrArray *slots;
+
+  /* only touched by the worker thread */
+  cairo_surface_t *source;
+  gchar *source_path;
+};
+
+/**
+ * @brief Parses the value of the 'logo-scale' property.
+ *
+ * Accepted values are "off", a fraction of the frame height such as "0.1",
+ * or an absolute size "WxH" where either side may be 0 to keep the aspect
+ * ratio of the logo.
+ *
+ * @param str The string to parse.
+ * @param scale Return location for the parsed value.
+ * @return TRUE if @str was valid.
+ */
+gboolean
+gst_logo_scale_parse (const gchar * str, GstLogoScale * scale)
+{
+  gchar *end;
+
+  scale->mode = GST_LOGO_SCALE_NONE;
+  scale->fraction = 0;
+  scale->width = scale->height = 0;
+
+  if (str == NULL || g_ascii_strcasecmp (str, "off") == 0)
+    return TRUE;
+
+  if (strchr (str, 'x') != NULL) {
+    gint64 w, h;
+
+    w = g_ascii_strtoll (str, &end, 10);
+    if (end == str || *end != 'x')
+      return FALSE;
+    str = end + 1;
+    h = g_ascii_strtoll (str, &end, 10);
+    if (end == str || *end != '\0')
+      return FALSE;
+    if (w < 0 || h < 0 || (w == 0 && h == 0) || w > G_MAXINT16
+        || h > G_MAXINT16)
+      return FALSE;
+
+    scale->mode = GST_LOGO_SCALE_ABSOLUTE;
+    scale->width = w;
+    scale->height = h;
+    return TRUE;
+  }
+
+  scale->fraction = g_ascii_strtod (str, &end);
+  if (end == str || *end != '\0' || scale->fraction <= 0
+      || scale->fraction > 1.0)
+    return FALSE;
+
+  scale->mode = GST_LOGO_SCALE_RELATIVE;
+  return TRUE;
+}
+
+/**
+ * @brief Checks whether two scales size the logo the same.
+ *
+ * Only the fields used by the mode are compared.
+ */
+gboolean
+gst_logo_scale_is_equal (const GstLogoScale * a, const GstLogoScale * b)
+{
+  if (a->mode != b->mode)
+    return FALSE;
+  switch (a->mode) {
+    case GST_LOGO_SCALE_RELATIVE:
+      return a->fraction == b->fraction;
+    case GST_LOGO_SCALE_ABSOLUTE:
+      return a->width == b->width && a->height == b->height;
+    case GST_LOGO_SCALE_NONE:
+    default:
+      return TRUE;
+  }
+}
+
+/**
+ * @brief Takes a reference on a logo image.
+ */
+GstLogoImage *
+gst_logo_image_ref (GstLogoImage * image)
+{
+  g_atomic_int_inc (&image->ref_count);
+  return image;
+}
+
+/**
+ * @brief Drops a reference on a logo image, freeing it with the last one.
+ */
+void
+gst_logo_image_unref (GstLogoImage * image)
+{
+  if (image == NULL || !g_atomic_int_dec_and_test (&image->ref_count))
+    return;
+
+  cairo_surface_destroy (image->surface);
+  gst_logo_sprite_free (image->sprite);
+  if (image->variant_surface)
+    cairo_surface_destroy (image->variant_surface);
+  gst_logo_sprite_free (image->variant);
+  g_free (image);
+}
+
+/**
+ * @brief Computes the logo size for a frame size.
+ *
+ * @param scale How the logo is sized per resolution.
+ * @param src_width Width of the decoded logo.
+ * @param src_height Height of the decoded logo.
+ * @param frame_height Negotiated frame height.
+ * @param width Return location for the logo width.
+ * @param height Return location for the logo height.
+ */
+void
+gst_logo_scale_get_size (const GstLogoScale * scale, gint src_width,
+    gint src_height, gint frame_height, gint * width, gint * height)
+{
+  switch (scale->mode) {
+    case GST_LOGO_SCALE_RELATIVE:
+      *height = MAX (1, (gint) (frame_height * scale->fraction + 0.5));
+      *width = MAX (1, (gint) ((gdouble) *height * src_width / src_height
+              + 0.5));
+      break;
+    case GST_LOGO_SCALE_ABSOLUTE:
+      *width = scale->width;
+      *height = scale->height;
+      if (*width == 0)
+        *width = MAX (1, (gint) ((gdouble) *height * src_width / src_height
+                + 0.5));
+      if (*height == 0)
+        *height = MAX (1, (gint) ((gdouble) *width * src_height / src_width
+                + 0.5));
+      break;
+    case GST_LOGO_SCALE_NONE:
+    default:
+      *width = src_width;
+      *height = src_height;
+      break;
+  }
+}
+
+/**
+ * @brief Resamples the decoded logo with cairo's best filter.
+ *
+ * @return A new ARGB32 surface of @width x @height.
+ */
+static cairo_surface_t *
+gst_logo_cache_resample (cairo_surface_t * source, gint width, gint height)
+{
+  cairo_surface_t *surface;
+  cairo_pattern_t *pattern;
+  cairo_t *cr;
+
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+  cr = cairo_create (surface);
+  cairo_scale (cr, (gdouble) width / cairo_image_surface_get_width (source),
+      (gdouble) height / cairo_image_surface_get_height (source));
+  cairo_set_source_surface (cr, source, 0, 0);
+  pattern = cairo_get_source (cr);
+  cairo_pattern_set_filter (pattern, CAIRO_FILTER_BEST);
+  cairo_pattern_set_extend (pattern, CAIRO_EXTEND_PAD);
+  cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+  cairo_paint (cr);
+  cairo_destroy (cr);
+
+  return surface;
+}
+
+/**
+ * @brief Builds a logo image for a frame size from a decoded logo.
+ *
+ * The sprite gets its mip pyramid right away, so a zooming logo is only
+ * resampled while it is blended.
+ *
+ * @param source The decoded logo, referenced by the image if it is used at
+ *     its native size, so it must not be modified afterwards.
+ * @param scale How the logo is sized per resolution.
+ * @param effects The effects drawn around the resampled logo.
+ * @param frame_height Negotiated frame height.
+ * @param format Negotiated video format the sprite is built for.
+ * @param colorimetry Negotiated colorimetry the sprite is built for.
+ * @return A new image with one reference.
+ */
+GstLogoImage *
+gst_logo_image_new_from_surface (cairo_surface_t * source,
+    const GstLogoScale * scale, const GstLogoEffects * effects,
+    gint frame_height, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry)
+{
+  GstLogoImage *image;
+  cairo_surface_t *resampled;
+  gint src_width, src_height, width, height;
+
+  src_width = cairo_image_surface_get_width (source);
+  src_height = cairo_image_surface_get_height (source);
+  gst_logo_scale_get_size (scale, src_width, src_height, frame_height,
+      &width, &height);
+
+  image = g_new0 (GstLogoImage, 1);
+  image->ref_count = 1;
+  image->width = width;
+  image->height = height;
+  if (width == src_width && height == src_height)
+    resampled = cairo_surface_reference (source);
+  else
+    resampled = gst_logo_cache_resample (source, width, height);
+  image->surface = gst_logo_effects_apply (effects, resampled,
+      &image->x_offset, &image->y_offset);
+  cairo_surface_destroy (resampled);
+  image->sprite = gst_logo_sprite_new_from_surface (image->surface, format,
+      colorimetry);
+  gst_logo_sprite_add_mips (image->sprite, image->surface);
+  image->light = gst_logo_sprite_get_light (image->sprite);
+
+  if (effects->contrast_variant) {
+    image->variant_surface = gst_logo_effects_draw_variant (image->surface,
+        image->light);
+    image->variant = gst_logo_sprite_new_from_surface (image->variant_surface,
+        format, colorimetry);
+    gst_logo_sprite_add_mips (image->variant, image->variant_surface);
+    image->variant_light = gst_logo_sprite_get_light (image->variant);
+  }
+
+  return image;
+}
+
+/**
+ * @brief Builds the logo image of one job, runs on the worker thread.
+ */
+static GstLogoImage *
+gst_logo_cache_build (GstLogoCache * cache, const gchar * path,
+    const GstLogoScale * scale, const GstLogoEffects * effects,
+    gint frame_height, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry)
+{
+  if (g_strcmp0 (path, cache->source_path) != 0) {
+    if (cache->source)
+      cairo_surface_destroy (cache->source);
+    g_free (cache->source_path);
+    cache->source_path = g_strdup (path);
+    cache->source = path ? cairo_image_surface_create_from_png (path) : NULL;
+  }
+
+  if (cache->source == NULL
+      || cairo_surface_status (cache->source) != CAIRO_STATUS_SUCCESS)
+    return NULL;
+
+  return gst_logo_image_new_from_surface (cache->source, scale, effects,
+      frame_height, format, colorimetry);
+}
+
+static GstLogoCacheSlot *
+gst_logo_cache_find (GstLogoCache * cache, gint frame_width, gint frame_height,
+    GstVideoFormat format, const GstVideoColorimetry * colorimetry)
+{
+  guint i;
+
+  for (i = 0; i < cache->slots->len; i++) {
+    GstLogoCacheSlot *slot = g_ptr_array_index (cache->slots, i);
+
+    if (slot->frame_width == frame_width && slot->frame_height == frame_height
+        && slot->format == format
+        && gst_video_colorimetry_is_equal (&slot->colorimetry, colorimetry))
+      return slot;
+  }
+  return NULL;
+}
+
+static void
+gst_logo_cache_slot_free (gpointer data)
+{
+  GstLogoCacheSlot *slot = data;
+
+  gst_logo_image_unref (slot->image);
+  g_free (slot);
+}
+
+/**
+ * @brief Worker thread function, builds the image of one slot.
+ */
+static void
+gst_logo_cache_worker (gpointer data, gpointer user_data)
+{
+  GstLogoCacheJob *job = data;
+  GstLogoCache *cache = user_data;
+  GstLogoCacheSlot *slot;
+  GstLogoImage *image;
+  GstLogoScale scale;
+  GstLogoEffects effects;
+  gchar *path;
+
+  g_mutex_lock (&cache->lock);
+  if (job->generation != cache->generation) {
+    g_mutex_unlock (&cache->lock);
+    g_free (job);
+    return;
+  }
+  path = g_strdup (cache->path);
+  scale = cache->scale;
+  effects = cache->effects;
+  g_mutex_unlock (&cache->lock);
+
+  image = gst_logo_cache_build (cache, path, &scale, &effects,
+      job->frame_height, job->format, &job->colorimetry);
+  g_free (path);
+
+  g_mutex_lock (&cache->lock);
+  slot = gst_logo_cache_find (cache, job->frame_width, job->frame_height,
+      job->format, &job->colorimetry);
+  if (job->generation == cache->generation && slot != NULL && !slot->done) {
+    slot->image = image;
+    slot->done = TRUE;
+    image = NULL;
+  }
+  g_cond_broadcast (&cache->cond);
+  g_mutex_unlock (&cache->lock);
+
+  gst_logo_image_unref (image);
+  g_free (job);
+}
+
+/**
+ * @brief Creates an empty logo cache with its own worker thread.
+ */
+GstLogoCache *
+gst_logo_cache_new (void)
+{
+  GstLogoCache *cache = g_new0 (GstLogoCache, 1);
+
+  g_mutex_init (&cache->lock);
+  g_cond_init (&cache->cond);
+  cache->slots = g_ptr_array_new_with_free_func (gst_logo_cache_slot_free);
+  cache->pool = g_thread_pool_new (gst_logo_cache_worker, cache, 1, FALSE,
+      NULL);
+
+  return cache;
+}
+
+/**
+ * @brief Frees the cache, dropping pending jobs and waiting for the worker.
+ */
+void
+gst_logo_cache_free (GstLogoCache * cache)
+{
+  if (cache == NULL)
+    return;
+
+  g_thread_pool_free (cache->pool, TRUE, TRUE);
+  g_ptr_array_free (cache->slots, TRUE);
+  if (cache->source)
+    cairo_surface_destroy (cache->source);
+  g_free (cache->source_path);
+  g_free (cache->path);
+  g_mutex_clear (&cache->lock);
+  g_cond_clear (&cache->cond);
+  g_free (cache);
+}
+
+/**
+ * @brief Sets the logo file, the scaling mode and the effects.
+ *
+ * Drops every cached resolution if any of them changed. Images that are
+ * still referenced by the caller stay valid until they are unreffed.
+ *
+ * @param cache The logo cache.
+ * @param path Path of the PNG logo.
+ * @param scale How the logo is sized per resolution.
+ * @param effects The effects drawn around the logo.
+ */
+void
+gst_logo_cache_set_source (GstLogoCache * cache, const gchar * path,
+    const GstLogoScale * scale, const GstLogoEffects * effects)
+{
+  g_mutex_lock (&cache->lock);
+  if (g_strcmp0 (path, cache->path) != 0
+      || !gst_logo_scale_is_equal (scale, &cache->scale)
+      || !gst_logo_effects_is_equal (effects, &cache->effects)) {
+    g_free (cache->path);
+    cache->path = g_strdup (path);
+    cache->scale = *scale;
+    cache->effects = *effects;
+    cache->generation++;
+    g_ptr_array_set_size (cache->slots, 0);
+    g_cond_broadcast (&cache->cond);
+  }
+  g_mutex_unlock (&cache->lock);
+}
+
+/* Must be called with the lock held */
+static GstLogoCacheSlot *
+gst_logo_cache_request (GstLogoCache * cache, gint frame_width,
+    gint frame_height, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry)
+{
+  GstLogoCacheSlot *slot;
+  GstLogoCacheJob *job;
+
+  slot = gst_logo_cache_find (cache, frame_width, frame_height, format,
+      colorimetry);
+  if (slot != NULL)
+    return slot;
+
+  slot = g_new0 (GstLogoCacheSlot, 1);
+  slot->frame_width = frame_width;
+  slot->frame_height = frame_height;
+  slot->format = format;
+  slot->colorimetry = *colorimetry;
+  g_ptr_array_add (cache->slots, slot);
+
+  job = g_new0 (GstLogoCacheJob, 1);
+  job->frame_width = frame_width;
+  job->frame_height = frame_height;
+  job->format = format;
+  job->colorimetry = *colorimetry;
+  job->generation = cache->generation;
+  g_thread_pool_push (cache->pool, job, NULL);
+
+  return slot;
+}
+
+/**
+ * @brief Starts building the logo for a resolution in the background.
+ *
+ * Does nothing if the resolution is already cached or being built. Slots
+ * of other formats and colorimetries are kept, so switching back to them
+ * reuses their sprites.
+ *
+ * @param cache The logo cache.
+ * @param frame_width Negotiated frame width.
+ * @param frame_height Negotiated frame height.
+ * @param format Negotiated video format.
+ * @param colorimetry Negotiated colorimetry.
+ */
+void
+gst_logo_cache_prepare (GstLogoCache * cache, gint frame_width,
+    gint frame_height, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry)
+{
+  g_mutex_lock (&cache->lock);
+  gst_logo_cache_request (cache, frame_width, frame_height, format,
+      colorimetry);
+  g_mutex_unlock (&cache->lock);
+}
+
+/**
+ * @brief Gets the logo for a resolution, waiting for the worker if needed.
+ *
+ * @param cache The logo cache.
+ * @param frame_width Negotiated frame width.
+ * @param frame_height Negotiated frame height.
+ * @param format Negotiated video format.
+ * @param colorimetry Negotiated colorimetry.
+ * @return A reference to the image, or NULL if the logo could not be
+ *     loaded. Release with gst_logo_image_unref().
+ */
+GstLogoImage *
+gst_logo_cache_get (GstLogoCache * cache, gint frame_width, gint frame_height,
+    GstVideoFormat format, const GstVideoColorimetry * colorimetry)
+{
+  GstLogoCacheSlot *slot;
+  GstLogoImage *image = NULL;
+
+  g_mutex_lock (&cache->lock);
+  /* The slot is looked up again after every wakeup since a concurrent
+   * gst_logo_cache_set_source() frees all slots */
+  while (!(slot = gst_logo_cache_request (cache, frame_width,
+              frame_height, format, colorimetry))->done)
+    g_cond_wait (&cache->cond, &cache->lock);
+  if (slot->image)
+    image = gst_logo_image_ref (slot->image);
+  g_mutex_unlock (&cache->lock);
+
+  return image;
+}
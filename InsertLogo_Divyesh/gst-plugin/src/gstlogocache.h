@@ -0,0 +1,153 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_CACHE_H__
+#define __GST_LOGO_CACHE_H__
+
+#include <gst/gst.h>
+#include <cairo.h>
+
+#include "gstlogoeffect.h"
+#include "gstlogosprite.h"
+
+G_BEGIN_DECLS
+
+/**
+ * GstLogoScaleMode:
+ * @GST_LOGO_SCALE_NONE: the logo is used at its native size.
+ * @GST_LOGO_SCALE_RELATIVE: the logo height is a fraction of the frame height.
+ * @GST_LOGO_SCALE_ABSOLUTE: the logo is resampled to a fixed size.
+ */
+typedef enum
+{
+  GST_LOGO_SCALE_NONE,
+  GST_LOGO_SCALE_RELATIVE,
+  GST_LOGO_SCALE_ABSOLUTE
+} GstLogoScaleMode;
+
+/**
+ * GstLogoScale:
+ * @mode: a #GstLogoScaleMode.
+ * @fraction: logo height relative to the frame height for
+ *     GST_LOGO_SCALE_RELATIVE.
+ * @width: logo width for GST_LOGO_SCALE_ABSOLUTE, 0 keeps the aspect ratio.
+ * @height: logo height for GST_LOGO_SCALE_ABSOLUTE, 0 keeps the aspect ratio.
+ *
+ * How the logo is sized for a given output resolution.
+ */
+typedef struct
+{
+  GstLogoScaleMode mode;
+  gdouble fraction;
+  gint width;
+  gint height;
+} GstLogoScale;
+
+/**
+ * GstLogoImage:
+ * @ref_count: reference count, see gst_logo_image_ref().
+ * @width: width of the resampled logo.
+ * @height: height of the resampled logo.
+ * @x_offset: left edge of the logo in @surface, past the effects.
+ * @y_offset: top edge of the logo in @surface, past the effects.
+ * @surface: the resampled logo with its effects as premultiplied ARGB32.
+ * @sprite: @surface converted for blending into the frame, with its mip
+ *     pyramid for zooming.
+ * @light: light of @sprite from 0 to 1, see gst_logo_sprite_get_light().
+ * @variant_surface: the light or dark variant of @surface for auto-contrast,
+ *     NULL unless the effects ask for it.
+ * @variant: @variant_surface converted like @sprite, or NULL.
+ * @variant_light: light of @variant.
+ *
+ * The logo prepared for one output resolution and format. Images are immutable once
+ * they are handed out by the cache. The logo is laid out with @width and
+ * @height; its effects may make @surface and @sprite larger, so they are
+ * placed @x_offset and @y_offset up and to the left of the logo.
+ */
+typedef struct
+{
+  gint ref_count;
+  gint width;
+  gint height;
+  gint x_offset;
+  gint y_offset;
+  cairo_surface_t *surface;
+  GstLogoSprite *sprite;
+  gdouble light;
+  cairo_surface_t *variant_surface;
+  GstLogoSprite *variant;
+  gdouble variant_light;
+} GstLogoImage;
+
+typedef struct _GstLogoCache GstLogoCache;
+
+gboolean gst_logo_scale_parse (const gchar * str, GstLogoScale * scale);
+void gst_logo_scale_get_size (const GstLogoScale * scale, gint src_width,
+    gint src_height, gint frame_height, gint * width, gint * height);
+gboolean gst_logo_scale_is_equal (const GstLogoScale * a,
+    const GstLogoScale * b);
+
+GstLogoImage *gst_logo_image_new_from_surface (cairo_surface_t * source,
+    const GstLogoScale * scale, const GstLogoEffects * effects,
+    gint frame_height, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry);
+GstLogoImage *gst_logo_image_ref (GstLogoImage * image);
+void gst_logo_image_unref (GstLogoImage * image);
+
+GstLogoCache *gst_logo_cache_new (void);
+void gst_logo_cache_free (GstLogoCache * cache);
+
+void gst_logo_cache_set_source (GstLogoCache * cache, const gchar * path,
+    const GstLogoScale * scale, const GstLogoEffects * effects);
+void gst_logo_cache_prepare (GstLogoCache * cache, gint frame_width,
+    gint frame_height, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry);
+GstLogoImage *gst_logo_cache_get (GstLogoCache * cache, gint frame_width,
+    gint frame_height, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_CACHE_H__ */
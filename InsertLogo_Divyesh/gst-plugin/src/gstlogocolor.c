@@ -0,0 +1,363 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:gstlogocolor
+ *
+ * Conversion of the logo colours to the colorimetry of the frames. Logos
+ * are sRGB; the tables apply the matrix and range of the negotiated
+ * colorimetry and, for HDR and linear transfer functions, re-encode the
+ * components so graphics white lands on the reference white of the
+ * stream. Tables are built once per matrix, range and transfer function
+ * and shared by every sprite of the process.
+ *
+ * The linear light tables serve the linear blend space: they decode the
+ * samples under a logo to linear light and encode the blended result
+ * again, once per range and depth.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogocolor.h"
+#include <math.h>
+
+/* Linear light of graphics white relative to the peak of the transfer
+ * function, as recommended by ITU-R BT.2408: 203 cd/m² for PQ and 75 %
+ * signal for HLG */
+#define GST_LOGO_COLOR_PQ_WHITE (203.0 / 10000.0)
+#define GST_LOGO_COLOR_HLG_WHITE 0.2647
+
+#if GST_CHECK_VERSION(1, 20, 0)
+#define gst_logo_color_decode gst_video_transfer_function_decode
+#define gst_logo_color_encode gst_video_transfer_function_encode
+#else
+#define gst_logo_color_decode gst_video_color_transfer_decode
+#define gst_logo_color_encode gst_video_color_transfer_encode
+#endif
+
+G_LOCK_DEFINE_STATIC (tables);
+static GPtrArray *all_tables;
+static GPtrArray *all_linear;
+
+/**
+ * @brief Fills the transfer lookup table of a set of tables.
+ *
+ * Transfer functions of SDR video are all treated like sRGB, which is how
+ * the logo is shown on any SDR display; only linear, PQ and HLG frames
+ * get their components re-encoded.
+ */
+static void
+gst_logo_color_tables_init_lut (GstLogoColorTables * tables)
+{
+  gdouble white;
+  guint i;
+
+  switch (tables->transfer) {
+    case GST_VIDEO_TRANSFER_GAMMA10:
+      white = 1.0;
+      break;
+    case GST_VIDEO_TRANSFER_SMPTE2084:
+      white = GST_LOGO_COLOR_PQ_WHITE;
+      break;
+    case GST_VIDEO_TRANSFER_ARIB_STD_B67:
+      white = GST_LOGO_COLOR_HLG_WHITE;
+      break;
+    default:
+      tables->has_lut = FALSE;
+      return;
+  }
+
+  tables->has_lut = TRUE;
+  for (i = 0; i < 256; i++) {
+    gdouble v = gst_logo_color_decode (GST_VIDEO_TRANSFER_SRGB, i / 255.0);
+
+    v = gst_logo_color_encode (tables->transfer, v * white);
+    tables->lut[i] = CLAMP (lround (v * 255.0), 0, 255);
+  }
+}
+
+/**
+ * @brief Builds the tables of one colorimetry.
+ */
+static GstLogoColorTables *
+gst_logo_color_tables_new (GstVideoColorMatrix matrix,
+    GstVideoColorRange range, GstVideoTransferFunction transfer,
+    gboolean rgb)
+{
+  GstLogoColorTables *tables = g_new0 (GstLogoColorTables, 1);
+  gdouble m[3][3] = { {1, 0, 0}, {0, 1, 0}, {0, 0, 1} };
+  gdouble off[3], scale[3];
+  gdouble kr, kb, kg;
+  guint o, i, v;
+
+  tables->matrix = matrix;
+  tables->range = range;
+  tables->transfer = transfer;
+  tables->rgb = rgb;
+  gst_logo_color_tables_init_lut (tables);
+
+  if (!rgb) {
+    /* Unknown matrices fall back to BT.601 like the element always did */
+    if (!gst_video_color_matrix_get_Kr_Kb (matrix, &kr, &kb))
+      gst_video_color_matrix_get_Kr_Kb (GST_VIDEO_COLOR_MATRIX_BT601, &kr,
+          &kb);
+    kg = 1.0 - kr - kb;
+    m[0][0] = kr;
+    m[0][1] = kg;
+    m[0][2] = kb;
+    m[1][0] = -kr / (2.0 * (1.0 - kb));
+    m[1][1] = -kg / (2.0 * (1.0 - kb));
+    m[1][2] = 0.5;
+    m[2][0] = 0.5;
+    m[2][1] = -kg / (2.0 * (1.0 - kr));
+    m[2][2] = -kb / (2.0 * (1.0 - kr));
+  }
+
+  for (o = 0; o < 3; o++) {
+    gboolean chroma = !rgb && o > 0;
+
+    if (range == GST_VIDEO_COLOR_RANGE_0_255) {
+      off[o] = chroma ? 128.0 : 0.0;
+      scale[o] = 255.0;
+    } else {
+      off[o] = chroma ? 128.0 : 16.0;
+      scale[o] = chroma ? 224.0 : 219.0;
+    }
+  }
+
+  for (o = 0; o < 3; o++) {
+    for (v = 0; v < 256; v++) {
+      for (i = 0; i < 3; i++)
+        tables->coef[o][i][v] =
+            lround (m[o][i] * scale[o] * v / 255.0 * 65536.0);
+      tables->offset[o][v] = lround (off[o] * v / 255.0 * 65536.0) + 32768;
+    }
+  }
+
+  return tables;
+}
+
+/**
+ * @brief Gets the conversion tables of a colorimetry, building them once.
+ *
+ * Only the matrix, range and transfer function are used. Unknown ranges
+ * are limited for YUV and full for RGB. The tables are never freed, there
+ * are only a handful of colorimetries in practice.
+ *
+ * @param colorimetry The colorimetry of the frames.
+ * @param rgb TRUE if the frames are RGB.
+ * @return The shared tables.
+ */
+const GstLogoColorTables *
+gst_logo_color_tables_get (const GstVideoColorimetry * colorimetry,
+    gboolean rgb)
+{
+  GstVideoColorRange range = colorimetry->range;
+  GstLogoColorTables *tables = NULL;
+  guint i;
+
+  if (range == GST_VIDEO_COLOR_RANGE_UNKNOWN)
+    range = rgb ? GST_VIDEO_COLOR_RANGE_0_255 : GST_VIDEO_COLOR_RANGE_16_235;
+
+  G_LOCK (tables);
+  if (all_tables == NULL)
+    all_tables = g_ptr_array_new ();
+  for (i = 0; i < all_tables->len; i++) {
+    GstLogoColorTables *t = g_ptr_array_index (all_tables, i);
+
+    if (t->rgb == rgb && t->range == range
+        && t->transfer == colorimetry->transfer
+        && (rgb || t->matrix == colorimetry->matrix)) {
+      tables = t;
+      break;
+    }
+  }
+  if (tables == NULL) {
+    tables = gst_logo_color_tables_new (colorimetry->matrix, range,
+        colorimetry->transfer, rgb);
+    g_ptr_array_add (all_tables, tables);
+  }
+  G_UNLOCK (tables);
+
+  return tables;
+}
+
+/**
+ * @brief Converts one premultiplied logo pixel.
+ *
+ * @param tables Tables from gst_logo_color_tables_get().
+ * @param pixel Native endian cairo ARGB32 pixel.
+ * @param out Return location for the three premultiplied components, Y,
+ *     Cb and Cr or R, G and B, followed by the coverage.
+ */
+void
+gst_logo_color_convert (const GstLogoColorTables * tables, guint32 pixel,
+    guint8 * out)
+{
+  guint a = pixel >> 24;
+  guint c[3] = { (pixel >> 16) & 0xff, (pixel >> 8) & 0xff, pixel & 0xff };
+  guint o, i;
+
+  if (tables->has_lut && a > 0) {
+    for (i = 0; i < 3; i++) {
+      guint v = MIN (255, (c[i] * 255 + a / 2) / a);
+
+      c[i] = (tables->lut[v] * a + 127) / 255;
+    }
+  }
+
+  for (o = 0; o < 3; o++) {
+    gint32 v = tables->offset[o][a];
+
+    for (i = 0; i < 3; i++)
+      v += tables->coef[o][i][c[i]];
+    /* Premultiplied, so no component may exceed the coverage */
+    out[o] = MIN (MAX (v, 0) >> 16, (gint32) a);
+  }
+  out[3] = a;
+}
+
+/**
+ * @brief Builds the linear light tables of one range and depth.
+ *
+ * Samples outside of the nominal range are clamped to black or white.
+ * The encode table has 4 more bits than the samples, up to 16, so every
+ * sample value of up to 10 bits comes back unchanged from linear light.
+ * Deeper samples near black are finer than 16 bit linear light and may
+ * move by a few steps of their depth.
+ */
+static GstLogoLinearTables *
+gst_logo_color_linear_new (GstVideoColorRange range, guint depth)
+{
+  GstLogoLinearTables *linear = g_new0 (GstLogoLinearTables, 1);
+  guint max = (1 << depth) - 1;
+  guint steps, i;
+  gdouble off, scale;
+
+  if (range == GST_VIDEO_COLOR_RANGE_0_255) {
+    off = 0.0;
+    scale = max;
+  } else {
+    off = 16 << (depth - 8);
+    scale = 219 << (depth - 8);
+  }
+
+  linear->range = range;
+  linear->depth = depth;
+  linear->encode_shift = depth < 12 ? 12 - depth : 0;
+  linear->decode = g_new (guint16, max + 1);
+  for (i = 0; i <= max; i++) {
+    gdouble v = CLAMP ((i - off) / scale, 0.0, 1.0);
+
+    v = gst_logo_color_decode (GST_VIDEO_TRANSFER_SRGB, v);
+    linear->decode[i] = lround (v * 65535.0);
+  }
+
+  steps = 65536 >> linear->encode_shift;
+  linear->encode = g_new (guint16, steps);
+  for (i = 0; i < steps; i++) {
+    gdouble v = (i + 0.5) * (1 << linear->encode_shift) / 65535.0;
+
+    v = gst_logo_color_encode (GST_VIDEO_TRANSFER_SRGB, MIN (v, 1.0));
+    linear->encode[i] = CLAMP (lround (off + v * scale), 0, (glong) max);
+  }
+
+  return linear;
+}
+
+/**
+ * @brief Gets the linear light tables of a colorimetry, building them once.
+ *
+ * Like the colour conversion, every SDR transfer function is treated as
+ * sRGB. Linear frames are blended in linear light anyway, and PQ and HLG
+ * samples are not decoded as 16 bits of linear light are too coarse near
+ * black for them, so there are no tables for these.
+ *
+ * @param colorimetry The colorimetry of the frames.
+ * @param rgb TRUE if the frames are RGB.
+ * @param depth Bits of the luma or R, G and B samples, 8 to 16.
+ * @return The shared tables, or NULL to blend the samples as they are.
+ */
+const GstLogoLinearTables *
+gst_logo_color_linear_get (const GstVideoColorimetry * colorimetry,
+    gboolean rgb, guint depth)
+{
+  GstVideoColorRange range = colorimetry->range;
+  GstLogoLinearTables *linear = NULL;
+  guint i;
+
+  switch (colorimetry->transfer) {
+    case GST_VIDEO_TRANSFER_GAMMA10:
+    case GST_VIDEO_TRANSFER_SMPTE2084:
+    case GST_VIDEO_TRANSFER_ARIB_STD_B67:
+      return NULL;
+    default:
+      break;
+  }
+
+  if (range == GST_VIDEO_COLOR_RANGE_UNKNOWN)
+    range = rgb ? GST_VIDEO_COLOR_RANGE_0_255 : GST_VIDEO_COLOR_RANGE_16_235;
+
+  G_LOCK (tables);
+  if (all_linear == NULL)
+    all_linear = g_ptr_array_new ();
+  for (i = 0; i < all_linear->len; i++) {
+    GstLogoLinearTables *l = g_ptr_array_index (all_linear, i);
+
+    if (l->range == range && l->depth == depth) {
+      linear = l;
+      break;
+    }
+  }
+  if (linear == NULL) {
+    linear = gst_logo_color_linear_new (range, depth);
+    g_ptr_array_add (all_linear, linear);
+  }
+  G_UNLOCK (tables);
+
+  return linear;
+}
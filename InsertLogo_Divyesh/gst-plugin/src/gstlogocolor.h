@@ -0,0 +1,114 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_COLOR_H__
+#define __GST_LOGO_COLOR_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GstLogoColorTables:
+ * @matrix: the matrix the tables convert to.
+ * @range: the range the tables convert to.
+ * @transfer: the transfer function of the frames.
+ * @rgb: the frames are RGB, the matrix is not applied.
+ * @has_lut: @lut has to be applied to unpremultiplied components.
+ * @lut: maps a sRGB component of the logo to the transfer of the frames.
+ * @coef: 16.16 fixed point contribution of each premultiplied R, G and B
+ *     value to each output component.
+ * @offset: 16.16 fixed point offset of each output component for each
+ *     coverage, with the rounding of the result folded in.
+ *
+ * Lookup tables converting premultiplied sRGB logo pixels to the
+ * premultiplied components of one colorimetry.
+ */
+typedef struct
+{
+  GstVideoColorMatrix matrix;
+  GstVideoColorRange range;
+  GstVideoTransferFunction transfer;
+  gboolean rgb;
+  gboolean has_lut;
+  guint8 lut[256];
+  gint32 coef[3][3][256];
+  gint32 offset[3][256];
+} GstLogoColorTables;
+
+/**
+ * GstLogoLinearTables:
+ * @range: the range of the samples.
+ * @depth: bits of a sample.
+ * @encode_shift: bits a 16 bit linear value is shifted right by to index
+ *     @encode.
+ * @decode: maps each of the 1 << @depth sample values to 16 bit linear
+ *     light.
+ * @encode: maps linear light, shifted right by @encode_shift, back to the
+ *     nearest sample value.
+ *
+ * Lookup tables between the luma or R, G and B samples of one range and
+ * depth and linear light, for blending in linear light.
+ */
+typedef struct
+{
+  GstVideoColorRange range;
+  guint depth;
+  guint encode_shift;
+  guint16 *decode;
+  guint16 *encode;
+} GstLogoLinearTables;
+
+const GstLogoColorTables *gst_logo_color_tables_get (const GstVideoColorimetry
+    * colorimetry, gboolean rgb);
+void gst_logo_color_convert (const GstLogoColorTables * tables,
+    guint32 pixel, guint8 * out);
+const GstLogoLinearTables *gst_logo_color_linear_get (const
+    GstVideoColorimetry * colorimetry, gboolean rgb, guint depth);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_COLOR_H__ */
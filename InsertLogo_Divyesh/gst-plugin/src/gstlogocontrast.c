@@ -0,0 +1,176 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+/**
+ * SECTION:gstlogocontrast
+ *
+ * Adapts the logo to the light of the video under it. The element measures
+ * the mean and spread of the light under the logo every few frames, see
+ * gst_logo_sprite_measure(). In the opacity mode a logo that stands out
+ * from a flat background much more than needed is made more transparent,
+ * so a white logo does not glare on a dark scene; a busy background keeps
+ * it opaque. In the variant mode the logo fades to a light or dark variant
+ * of itself while that contrasts better with the background. Both follow
+ * the video with a time constant, so the logo does not flicker with it.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogocontrast.h"
+#include <math.h>
+
+/* Time constant the opacity and the variant share follow the video with */
+#define GST_LOGO_CONTRAST_TAU (0.5 * GST_SECOND)
+
+/* Contrast above which the logo glares and is made more transparent */
+#define GST_LOGO_CONTRAST_GLARE 0.4
+
+/* The logo never gets more transparent than this factor of its opacity */
+#define GST_LOGO_CONTRAST_MIN_OPACITY 0.5
+
+/* Contrast the logo or its variant has to gain before they are swapped */
+#define GST_LOGO_CONTRAST_HYSTERESIS 0.05
+
+/**
+ * @brief Parses an auto-contrast mode.
+ *
+ * @param str "off", "opacity" or "variant".
+ * @param mode Return location for the mode.
+ * @return FALSE if @str is not a mode.
+ */
+gboolean
+gst_logo_contrast_parse (const gchar * str, GstLogoContrastMode * mode)
+{
+  if (g_strcmp0 (str, "off") == 0)
+    *mode = GST_LOGO_CONTRAST_OFF;
+  else if (g_strcmp0 (str, "opacity") == 0)
+    *mode = GST_LOGO_CONTRAST_OPACITY;
+  else if (g_strcmp0 (str, "variant") == 0)
+    *mode = GST_LOGO_CONTRAST_VARIANT;
+  else
+    return FALSE;
+  return TRUE;
+}
+
+/**
+ * @brief Forgets the measurements, the next frame is measured.
+ *
+ * Keeps the mode, the logo starts opaque and without its variant.
+ *
+ * @param contrast The state to reset.
+ */
+void
+gst_logo_contrast_reset (GstLogoContrast * contrast)
+{
+  contrast->opacity = 1.0;
+  contrast->variant = 0.0;
+  contrast->measured = GST_CLOCK_TIME_NONE;
+  contrast->frames = 0;
+}
+
+/**
+ * @brief Counts a frame and tells whether it is measured.
+ *
+ * @param contrast The state.
+ * @param interval Frames from one measurement to the next, at least 1.
+ * @return TRUE if the video under the logo is measured on this frame.
+ */
+gboolean
+gst_logo_contrast_due (GstLogoContrast * contrast, guint interval)
+{
+  if (contrast->mode == GST_LOGO_CONTRAST_OFF)
+    return FALSE;
+  if (GST_CLOCK_TIME_IS_VALID (contrast->measured)
+      && ++contrast->frames < MAX (interval, 1))
+    return FALSE;
+  contrast->frames = 0;
+  return TRUE;
+}
+
+/**
+ * @brief Moves the opacity and the variant share towards a measurement.
+ *
+ * The first measurement after a reset is taken as it is; later ones are
+ * followed with GST_LOGO_CONTRAST_TAU, whatever the measuring interval.
+ *
+ * @param contrast The state.
+ * @param stats The light under the logo.
+ * @param light Light of the logo.
+ * @param variant_light Light of the variant of the logo.
+ * @param running_time Running time of the measured frame.
+ */
+void
+gst_logo_contrast_update (GstLogoContrast * contrast,
+    const GstLogoLightStats * stats, gdouble light, gdouble variant_light,
+    GstClockTime running_time)
+{
+  gdouble opacity = 1.0, variant, gain, k = 1.0;
+
+  /* A busy background hides the logo as much as a background of the same
+   * light, so the spread counts against the contrast */
+  gdouble contrast_logo = fabs (light - stats->mean) - stats->stddev;
+
+  if (contrast_logo > GST_LOGO_CONTRAST_GLARE)
+    opacity = MAX (GST_LOGO_CONTRAST_MIN_OPACITY,
+        GST_LOGO_CONTRAST_GLARE / contrast_logo);
+
+  gain = fabs (variant_light - stats->mean) - fabs (light - stats->mean);
+  if (contrast->variant >= 0.5)
+    variant = gain > -GST_LOGO_CONTRAST_HYSTERESIS ? 1.0 : 0.0;
+  else
+    variant = gain > GST_LOGO_CONTRAST_HYSTERESIS ? 1.0 : 0.0;
+
+  if (GST_CLOCK_TIME_IS_VALID (contrast->measured)
+      && GST_CLOCK_TIME_IS_VALID (running_time)) {
+    gdouble dt = running_time > contrast->measured ?
+        (gdouble) (running_time - contrast->measured) : 0.0;
+
+    k = 1.0 - exp (-dt / GST_LOGO_CONTRAST_TAU);
+  }
+  contrast->opacity += (opacity - contrast->opacity) * k;
+  contrast->variant += (variant - contrast->variant) * k;
+  contrast->measured = running_time;
+}
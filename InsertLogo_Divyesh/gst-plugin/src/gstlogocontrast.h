@@ -0,0 +1,102 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_CONTRAST_H__
+#define __GST_LOGO_CONTRAST_H__
+
+#include <gst/gst.h>
+
+#include "gstlogosprite.h"
+
+G_BEGIN_DECLS
+
+/**
+ * GstLogoContrastMode:
+ * @GST_LOGO_CONTRAST_OFF: the logo is drawn as it is.
+ * @GST_LOGO_CONTRAST_OPACITY: the logo is made more transparent where it
+ *     stands out too much from the video, to avoid glare.
+ * @GST_LOGO_CONTRAST_VARIANT: the logo fades to a light or dark variant
+ *     where that stands out better from the video.
+ *
+ * How the logo adapts to the light of the video under it.
+ */
+typedef enum
+{
+  GST_LOGO_CONTRAST_OFF,
+  GST_LOGO_CONTRAST_OPACITY,
+  GST_LOGO_CONTRAST_VARIANT
+} GstLogoContrastMode;
+
+/**
+ * GstLogoContrast:
+ * @mode: a #GstLogoContrastMode.
+ * @opacity: smoothed factor of the logo opacity, 0 to 1.
+ * @variant: smoothed share of the variant in the logo, 0 to 1.
+ * @measured: running time of the last measurement.
+ * @frames: frames since the last measurement.
+ *
+ * Turns measurements of the video under the logo into an opacity and a
+ * variant share that follow the video smoothly.
+ */
+typedef struct
+{
+  GstLogoContrastMode mode;
+  gdouble opacity;
+  gdouble variant;
+  GstClockTime measured;
+  guint frames;
+} GstLogoContrast;
+
+gboolean gst_logo_contrast_parse (const gchar * str,
+    GstLogoContrastMode * mode);
+void gst_logo_contrast_reset (GstLogoContrast * contrast);
+gboolean gst_logo_contrast_due (GstLogoContrast * contrast, guint interval);
+void gst_logo_contrast_update (GstLogoContrast * contrast,
+    const GstLogoLightStats * stats, gdouble light, gdouble variant_light,
+    GstClockTime running_time);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_CONTRAST_H__ */
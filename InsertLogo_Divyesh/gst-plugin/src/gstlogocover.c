@@ -0,0 +1,344 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+/**
+ * SECTION:gstlogocover
+ *
+ * Regions of the video that are blurred or pixelated in place before the
+ * logo is blended, in the same mapping of the frame. Only the rows of a
+ * region are read and written. Every colour component is copied out of
+ * the frame once, whatever its layout, blurred or pixelated in a scratch
+ * buffer and copied back; the blur is a number of separable box passes
+ * with running sums, so its cost does not grow with the radius.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogocover.h"
+#include "gstlogosprite.h"
+#include <string.h>
+
+/* One colour component of a mapped frame, tiled or not */
+typedef struct
+{
+  guint8 *data;
+  gint stride;
+  gint pstride;
+  gint offset;
+  guint bytes;
+  guint shift;
+  gboolean tiled;
+  GstLogoTiling tiling;
+} GstLogoCoverComp;
+
+/* Reads an optional size field of 1 to @max */
+static gboolean
+gst_logo_cover_get_size (const GstStructure * s, const gchar * field,
+    guint max, guint * value)
+{
+  gint v;
+
+  if (!gst_structure_has_field (s, field))
+    return TRUE;
+  if (!gst_structure_get_int (s, field, &v) || v < 1 || v > max)
+    return FALSE;
+  *value = v;
+  return TRUE;
+}
+
+/**
+ * @brief Parses one cover region.
+ *
+ * Takes "x", "y", "width" and "height" in luma pixels, "mode" as "blur"
+ * (default) or "pixelate", and "radius" and "passes" of the blur or
+ * "block" of the pixelation. The structure name is free.
+ *
+ * @param s The region description.
+ * @param cover Return location for the region.
+ * @return TRUE if @s was valid, FALSE with a warning otherwise.
+ */
+gboolean
+gst_logo_cover_parse (const GstStructure * s, GstLogoCover * cover)
+{
+  const gchar *name = gst_structure_get_name (s);
+  const gchar *mode = gst_structure_get_string (s, "mode");
+
+  memset (cover, 0, sizeof (GstLogoCover));
+  cover->radius = GST_LOGO_COVER_RADIUS;
+  cover->passes = GST_LOGO_COVER_PASSES;
+  cover->block = GST_LOGO_COVER_BLOCK;
+
+  if (!gst_structure_get_int (s, "x", &cover->x)
+      || !gst_structure_get_int (s, "y", &cover->y)
+      || !gst_structure_get_int (s, "width", &cover->width)
+      || !gst_structure_get_int (s, "height", &cover->height)
+      || cover->x < 0 || cover->y < 0 || cover->width <= 0
+      || cover->height <= 0) {
+    g_warning ("Invalid cover '%s'. Expected x and y of 0 or more and width and height above 0.", name);
+    return FALSE;
+  }
+
+  if (mode == NULL || g_strcmp0 (mode, "blur") == 0)
+    cover->mode = GST_LOGO_COVER_BLUR;
+  else if (g_strcmp0 (mode, "pixelate") == 0)
+    cover->mode = GST_LOGO_COVER_PIXELATE;
+  else {
+    g_warning ("Invalid mode '%s' for cover '%s'. Valid values are 'blur' or 'pixelate'.", mode, name);
+    return FALSE;
+  }
+
+  if (!gst_logo_cover_get_size (s, "radius", GST_LOGO_COVER_MAX_SIZE,
+          &cover->radius)
+      || !gst_logo_cover_get_size (s, "passes", GST_LOGO_COVER_MAX_PASSES,
+          &cover->passes)
+      || !gst_logo_cover_get_size (s, "block", GST_LOGO_COVER_MAX_SIZE,
+          &cover->block)) {
+    g_warning ("Invalid size for cover '%s'. Valid radius and block are 1 to %d, passes 1 to %d.", name, GST_LOGO_COVER_MAX_SIZE, GST_LOGO_COVER_MAX_PASSES);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* Finds a sample of a component */
+static inline guint8 *
+gst_logo_cover_sample (const GstLogoCoverComp * comp, gint col, gint row)
+{
+  gint x = col * comp->pstride + comp->offset;
+
+  if (comp->tiled)
+    return gst_logo_sprite_tiling_get (&comp->tiling, comp->data, x, row);
+  return comp->data + (gsize) row * comp->stride + x;
+}
+
+/* Copies a rectangle of a component out of the frame */
+static void
+gst_logo_cover_read (const GstLogoCoverComp * comp, gint x, gint y,
+    gint width, gint height, guint16 * buf)
+{
+  gint col, row;
+
+  for (row = 0; row < height; row++) {
+    guint16 *line = buf + (gsize) row * width;
+
+    if (comp->bytes == 2) {
+      for (col = 0; col < width; col++)
+        line[col] = *(guint16 *) gst_logo_cover_sample (comp, x + col,
+            y + row) >> comp->shift;
+    } else {
+      for (col = 0; col < width; col++)
+        line[col] = *gst_logo_cover_sample (comp, x + col, y + row);
+    }
+  }
+}
+
+/* Copies a rectangle of a component back into the frame */
+static void
+gst_logo_cover_write (const GstLogoCoverComp * comp, gint x, gint y,
+    gint width, gint height, const guint16 * buf)
+{
+  gint col, row;
+
+  for (row = 0; row < height; row++) {
+    const guint16 *line = buf + (gsize) row * width;
+
+    if (comp->bytes == 2) {
+      for (col = 0; col < width; col++)
+        *(guint16 *) gst_logo_cover_sample (comp, x + col, y + row) =
+            line[col] << comp->shift;
+    } else {
+      for (col = 0; col < width; col++)
+        *gst_logo_cover_sample (comp, x + col, y + row) = line[col];
+    }
+  }
+}
+
+/* One box blur pass over @n samples @step apart. The edge samples are
+ * repeated, so the region does not fade into black at its border. */
+static void
+gst_logo_cover_box (guint16 * line, gint n, gint step, gint r, guint16 * tmp)
+{
+  guint sum, size = 2 * r + 1;
+  gint i;
+
+  for (i = 0; i < n; i++)
+    tmp[i] = line[(gsize) i * step];
+  sum = tmp[0] * (r + 1);
+  for (i = 1; i <= r; i++)
+    sum += tmp[MIN (i, n - 1)];
+  for (i = 0; i < n; i++) {
+    line[(gsize) i * step] = (sum + size / 2) / size;
+    sum += tmp[MIN (i + r + 1, n - 1)];
+    sum -= tmp[MAX (i - r, 0)];
+  }
+}
+
+/**
+ * @brief Blurs a rectangle of samples in place.
+ *
+ * The radius is split over the passes, so the blur reaches about @rx and
+ * @ry samples whatever the number of passes.
+ */
+static void
+gst_logo_cover_blur (guint16 * buf, gint width, gint height, gint rx,
+    gint ry, guint passes, guint16 * tmp)
+{
+  gint r_x = (rx + passes - 1) / passes, r_y = (ry + passes - 1) / passes;
+  guint pass;
+  gint i;
+
+  for (pass = 0; pass < passes; pass++) {
+    for (i = 0; i < height; i++)
+      gst_logo_cover_box (buf + (gsize) i * width, width, 1, r_x, tmp);
+    for (i = 0; i < width; i++)
+      gst_logo_cover_box (buf + i, height, width, r_y, tmp);
+  }
+}
+
+/**
+ * @brief Replaces blocks of a rectangle of samples by their mean.
+ */
+static void
+gst_logo_cover_pixelate (guint16 * buf, gint width, gint height, gint bx,
+    gint by)
+{
+  gint x, y, i, j;
+
+  for (y = 0; y < height; y += by) {
+    gint h = MIN (by, height - y);
+
+    for (x = 0; x < width; x += bx) {
+      gint w = MIN (bx, width - x);
+      guint64 sum = 0;
+      guint mean;
+
+      for (j = 0; j < h; j++)
+        for (i = 0; i < w; i++)
+          sum += buf[(gsize) (y + j) * width + x + i];
+      mean = (sum + w * h / 2) / (w * h);
+      for (j = 0; j < h; j++)
+        for (i = 0; i < w; i++)
+          buf[(gsize) (y + j) * width + x + i] = mean;
+    }
+  }
+}
+
+/**
+ * @brief Blurs or pixelates the cover regions of a frame in place.
+ *
+ * Regions are clipped against the frame and applied in order, so later
+ * ones see the result of earlier ones where they overlap. Chroma is
+ * covered over the chroma samples the region touches. Alpha is kept.
+ *
+ * @param covers The regions.
+ * @param n_covers Number of regions in @covers.
+ * @param frame A frame mapped for writing in a format sprites can be built
+ *     for.
+ */
+void
+gst_logo_cover_apply (const GstLogoCover * covers, guint n_covers,
+    GstVideoFrame * frame)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  guint n_comps = MIN (GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo), 3);
+  guint depth = GST_VIDEO_FORMAT_INFO_DEPTH (finfo, 0);
+  GstLogoCoverComp comps[3];
+  guint16 *buf = NULL, *tmp = NULL;
+  gsize buf_size = 0;
+  guint i, c;
+
+  for (c = 0; c < n_comps; c++) {
+    guint plane = GST_VIDEO_FORMAT_INFO_PLANE (finfo, c);
+    GstLogoCoverComp *comp = &comps[c];
+
+    comp->data = GST_VIDEO_FRAME_PLANE_DATA (frame, plane);
+    comp->stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, plane);
+    comp->pstride = GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, c);
+    comp->offset = GST_VIDEO_FORMAT_INFO_POFFSET (finfo, c);
+    comp->bytes = depth > 8 ? 2 : 1;
+    comp->shift = GST_VIDEO_FORMAT_INFO_SHIFT (finfo, c);
+    comp->tiled = GST_VIDEO_FORMAT_INFO_IS_TILED (finfo);
+    if (comp->tiled)
+      gst_logo_sprite_tiling_init (&comp->tiling, frame, plane);
+  }
+
+  for (i = 0; i < n_covers; i++) {
+    const GstLogoCover *cover = &covers[i];
+    gint x0 = cover->x, y0 = cover->y;
+    gint x1 = MIN (cover->x + cover->width, GST_VIDEO_FRAME_WIDTH (frame));
+    gint y1 = MIN (cover->y + cover->height, GST_VIDEO_FRAME_HEIGHT (frame));
+
+    if (x0 >= x1 || y0 >= y1)
+      continue;
+
+    for (c = 0; c < n_comps; c++) {
+      guint w_sub = GST_VIDEO_FORMAT_INFO_W_SUB (finfo, c);
+      guint h_sub = GST_VIDEO_FORMAT_INFO_H_SUB (finfo, c);
+      gint cx = x0 >> w_sub, cy = y0 >> h_sub;
+      gint w = GST_VIDEO_SUB_SCALE (w_sub, x1) - cx;
+      gint h = GST_VIDEO_SUB_SCALE (h_sub, y1) - cy;
+
+      if ((gsize) w * h > buf_size) {
+        buf_size = (gsize) w * h;
+        g_free (buf);
+        buf = g_new (guint16, buf_size);
+      }
+      tmp = g_renew (guint16, tmp, MAX (w, h));
+
+      gst_logo_cover_read (&comps[c], cx, cy, w, h, buf);
+      if (cover->mode == GST_LOGO_COVER_BLUR)
+        gst_logo_cover_blur (buf, w, h, MAX (cover->radius >> w_sub, 1),
+            MAX (cover->radius >> h_sub, 1), cover->passes, tmp);
+      else
+        gst_logo_cover_pixelate (buf, w, h, MAX (cover->block >> w_sub, 1),
+            MAX (cover->block >> h_sub, 1));
+      gst_logo_cover_write (&comps[c], cx, cy, w, h, buf);
+    }
+  }
+
+  g_free (tmp);
+  g_free (buf);
+}
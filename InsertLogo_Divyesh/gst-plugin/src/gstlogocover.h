@@ -0,0 +1,105 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_COVER_H__
+#define __GST_LOGO_COVER_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+/* Defaults and limits of the cover fields, in luma pixels */
+#define GST_LOGO_COVER_RADIUS		16
+#define GST_LOGO_COVER_PASSES		3
+#define GST_LOGO_COVER_MAX_PASSES	6
+#define GST_LOGO_COVER_BLOCK		16
+#define GST_LOGO_COVER_MAX_SIZE		256
+
+/**
+ * GstLogoCoverMode:
+ * @GST_LOGO_COVER_BLUR: the region is blurred.
+ * @GST_LOGO_COVER_PIXELATE: the region is replaced by blocks of its mean
+ *     colour.
+ */
+typedef enum
+{
+  GST_LOGO_COVER_BLUR,
+  GST_LOGO_COVER_PIXELATE
+} GstLogoCoverMode;
+
+/**
+ * GstLogoCover:
+ * @mode: a #GstLogoCoverMode.
+ * @x: left edge of the region in luma pixels.
+ * @y: top edge of the region in luma pixels.
+ * @width: width of the region in luma pixels.
+ * @height: height of the region in luma pixels.
+ * @radius: blur radius in luma pixels.
+ * @passes: number of box blur passes, more come closer to a gaussian.
+ * @block: size of the pixelate blocks in luma pixels.
+ *
+ * A region of the video hidden before the logo is blended, typically over
+ * a logo burned into the video upstream.
+ */
+typedef struct
+{
+  GstLogoCoverMode mode;
+  gint x;
+  gint y;
+  gint width;
+  gint height;
+  guint radius;
+  guint passes;
+  guint block;
+} GstLogoCover;
+
+gboolean gst_logo_cover_parse (const GstStructure * s, GstLogoCover * cover);
+void gst_logo_cover_apply (const GstLogoCover * covers, guint n_covers,
+    GstVideoFrame * frame);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_COVER_H__ */
@@ -0,0 +1,501 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:gstlogoeffect
+ *
+ * Drop shadow, outline and glow drawn around a logo. The effects are
+ * rendered once into a larger logo surface when the logo is prepared for
+ * a resolution, so the sprite built from it carries them and blending a
+ * frame costs nothing more than the larger sprite rectangle.
+ *
+ * All effects are derived from the coverage of the logo: the outline
+ * dilates it, the glow and the shadow blur the outlined coverage, and the
+ * layers are composited below the logo in the order shadow, glow,
+ * outline.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogoeffect.h"
+#include <math.h>
+#include <string.h>
+
+/* Number of box blur passes approximating a gaussian */
+#define GST_LOGO_EFFECT_BLUR_PASSES 3
+
+/* Share of the way towards black or white the colours of a contrast
+ * variant are pulled, of 256 */
+#define GST_LOGO_EFFECT_VARIANT_PULL 192
+
+/* Rounded x / 255 for 0 <= x <= 65535 */
+static inline guint
+gst_logo_effect_div255 (guint x)
+{
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+/**
+ * @brief Sets the effects to none with the default colours.
+ */
+void
+gst_logo_effects_init (GstLogoEffects * effects)
+{
+  memset (effects, 0, sizeof (GstLogoEffects));
+  effects->shadow_color = GST_LOGO_EFFECT_SHADOW_COLOR;
+  effects->outline_color = GST_LOGO_EFFECT_OUTLINE_COLOR;
+  effects->glow_color = GST_LOGO_EFFECT_GLOW_COLOR;
+}
+
+static gboolean
+gst_logo_effects_has_shadow (const GstLogoEffects * effects)
+{
+  return (effects->shadow_x != 0 || effects->shadow_y != 0
+      || effects->shadow_blur > 0) && (effects->shadow_color >> 24) > 0;
+}
+
+/**
+ * @brief Checks whether the effects leave the logo as it is.
+ */
+gboolean
+gst_logo_effects_is_none (const GstLogoEffects * effects)
+{
+  return !gst_logo_effects_has_shadow (effects)
+      && (effects->outline_width == 0 || (effects->outline_color >> 24) == 0)
+      && (effects->glow_radius == 0 || (effects->glow_color >> 24) == 0);
+}
+
+/**
+ * @brief Checks whether two sets of effects draw the same logo.
+ */
+gboolean
+gst_logo_effects_is_equal (const GstLogoEffects * a, const GstLogoEffects * b)
+{
+  return a->shadow_x == b->shadow_x && a->shadow_y == b->shadow_y
+      && a->shadow_blur == b->shadow_blur
+      && a->shadow_color == b->shadow_color
+      && a->outline_width == b->outline_width
+      && a->outline_color == b->outline_color
+      && a->glow_radius == b->glow_radius && a->glow_color == b->glow_color
+      && a->contrast_variant == b->contrast_variant;
+}
+
+/* Reads an optional size field of at most GST_LOGO_EFFECT_MAX_SIZE */
+static gboolean
+gst_logo_effects_get_size (const GstStructure * s, const gchar * field,
+    gint min, gint * value)
+{
+  if (!gst_structure_has_field (s, field))
+    return TRUE;
+  return gst_structure_get_int (s, field, value) && *value >= min
+      && *value <= GST_LOGO_EFFECT_MAX_SIZE;
+}
+
+/* Reads an optional 0xAARRGGBB field, which parses as unsigned above
+ * G_MAXINT and as signed below */
+static gboolean
+gst_logo_effects_get_color (const GstStructure * s, const gchar * field,
+    guint32 * color)
+{
+  guint value;
+
+  if (!gst_structure_has_field (s, field))
+    return TRUE;
+  if (!gst_structure_get_uint (s, field, &value)
+      && !gst_structure_get_int (s, field, (gint *) & value))
+    return FALSE;
+  *color = value;
+  return TRUE;
+}
+
+/**
+ * @brief Reads the effect fields of a description.
+ *
+ * The fields are "shadow-x", "shadow-y", "shadow-blur", "outline-width"
+ * and "glow-radius" in pixels, up to GST_LOGO_EFFECT_MAX_SIZE, and
+ * "shadow-color", "outline-color" and "glow-color" as 0xAARRGGBB, with
+ * the meaning of the element properties of the same name. Missing fields
+ * keep their value.
+ *
+ * @param effects The effects to update.
+ * @param s The description.
+ * @return FALSE if a field is invalid.
+ */
+gboolean
+gst_logo_effects_parse_structure (GstLogoEffects * effects,
+    const GstStructure * s)
+{
+  gint shadow_x = effects->shadow_x, shadow_y = effects->shadow_y;
+  gint shadow_blur = effects->shadow_blur;
+  gint outline_width = effects->outline_width;
+  gint glow_radius = effects->glow_radius;
+
+  if (!gst_logo_effects_get_size (s, "shadow-x", -GST_LOGO_EFFECT_MAX_SIZE,
+          &shadow_x)
+      || !gst_logo_effects_get_size (s, "shadow-y",
+          -GST_LOGO_EFFECT_MAX_SIZE, &shadow_y)
+      || !gst_logo_effects_get_size (s, "shadow-blur", 0, &shadow_blur)
+      || !gst_logo_effects_get_size (s, "outline-width", 0, &outline_width)
+      || !gst_logo_effects_get_size (s, "glow-radius", 0, &glow_radius)
+      || !gst_logo_effects_get_color (s, "shadow-color",
+          &effects->shadow_color)
+      || !gst_logo_effects_get_color (s, "outline-color",
+          &effects->outline_color)
+      || !gst_logo_effects_get_color (s, "glow-color",
+          &effects->glow_color))
+    return FALSE;
+
+  effects->shadow_x = shadow_x;
+  effects->shadow_y = shadow_y;
+  effects->shadow_blur = shadow_blur;
+  effects->outline_width = outline_width;
+  effects->glow_radius = glow_radius;
+  return TRUE;
+}
+
+/* Distance a blur of @radius reaches, a whole number of box passes */
+static gint
+gst_logo_effect_reach (guint radius)
+{
+  return radius > 0 ? GST_LOGO_EFFECT_BLUR_PASSES * ((radius + 2) / 3) : 0;
+}
+
+/**
+ * @brief Grows a coverage mask by a disc of @radius pixels.
+ *
+ * The rim of the disc has partial weight so the outline keeps an
+ * anti-aliased edge.
+ */
+static guint8 *
+gst_logo_effect_dilate (const guint8 * mask, gint width, gint height,
+    guint radius)
+{
+  gint r = radius + 1, n = 0, x, y, dx, dy, k;
+  gint *offsets = g_new (gint, 3 * (2 * r + 1) * (2 * r + 1));
+  guint8 *out = g_malloc0 ((gsize) width * height);
+
+  for (dy = -r; dy <= r; dy++) {
+    for (dx = -r; dx <= r; dx++) {
+      gdouble w = CLAMP (radius + 1.0 - sqrt (dx * dx + dy * dy), 0.0, 1.0);
+
+      if (w > 0) {
+        offsets[3 * n] = dx;
+        offsets[3 * n + 1] = dy;
+        offsets[3 * n++ + 2] = lround (w * 256);
+      }
+    }
+  }
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x++) {
+      guint best = 0;
+
+      for (k = 0; k < n && best < 255; k++) {
+        gint sx = x + offsets[3 * k], sy = y + offsets[3 * k + 1];
+        guint v;
+
+        if (sx < 0 || sy < 0 || sx >= width || sy >= height)
+          continue;
+        v = (mask[(gsize) sy * width + sx] * offsets[3 * k + 2]) >> 8;
+        best = MAX (best, v);
+      }
+      out[(gsize) y * width + x] = best;
+    }
+  }
+
+  g_free (offsets);
+  return out;
+}
+
+/* One box blur pass over @n samples @step apart, outside is transparent */
+static void
+gst_logo_effect_box (guint8 * line, gint n, gint step, gint r, guint8 * tmp)
+{
+  guint sum = 0, size = 2 * r + 1;
+  gint i;
+
+  for (i = 0; i < n; i++)
+    tmp[i] = line[(gsize) i * step];
+  for (i = 0; i < MIN (r, n); i++)
+    sum += tmp[i];
+  for (i = 0; i < n; i++) {
+    if (i + r < n)
+      sum += tmp[i + r];
+    line[(gsize) i * step] = (sum + size / 2) / size;
+    if (i - r >= 0)
+      sum -= tmp[i - r];
+  }
+}
+
+/**
+ * @brief Blurs a coverage mask in place, close to a gaussian of @radius.
+ */
+static void
+gst_logo_effect_blur (guint8 * mask, gint width, gint height, guint radius)
+{
+  gint r = (radius + 2) / 3;
+  guint8 *tmp = g_malloc (MAX (width, height));
+  gint pass, i;
+
+  if (radius == 0) {
+    g_free (tmp);
+    return;
+  }
+
+  for (pass = 0; pass < GST_LOGO_EFFECT_BLUR_PASSES; pass++) {
+    for (i = 0; i < height; i++)
+      gst_logo_effect_box (mask + (gsize) i * width, width, 1, r, tmp);
+    for (i = 0; i < width; i++)
+      gst_logo_effect_box (mask + i, height, width, r, tmp);
+  }
+  g_free (tmp);
+}
+
+/* Composites a colour at a coverage over a premultiplied pixel */
+static inline guint32
+gst_logo_effect_over (guint32 dst, guint32 color, guint coverage)
+{
+  guint a = gst_logo_effect_div255 ((color >> 24) * coverage);
+  guint inv = 255 - a;
+  guint32 out;
+  guint shift;
+
+  out = (a + gst_logo_effect_div255 ((dst >> 24) * inv)) << 24;
+  for (shift = 0; shift < 24; shift += 8)
+    out |= (gst_logo_effect_div255 (((color >> shift) & 0xff) * a)
+        + gst_logo_effect_div255 (((dst >> shift) & 0xff) * inv)) << shift;
+  return out;
+}
+
+/**
+ * @brief Draws the effects around a logo.
+ *
+ * The result is larger than @surface by the reach of the effects on each
+ * side; the logo keeps its pixels and is found at @x_offset, @y_offset.
+ *
+ * @param effects The effects to draw.
+ * @param surface The logo as premultiplied ARGB32.
+ * @param x_offset Return location for the left edge of the logo in the
+ *     result.
+ * @param y_offset Return location for the top edge of the logo in the
+ *     result.
+ * @return A new surface, or a new reference to @surface if there are no
+ *     effects.
+ */
+cairo_surface_t *
+gst_logo_effects_apply (const GstLogoEffects * effects,
+    cairo_surface_t * surface, gint * x_offset, gint * y_offset)
+{
+  gint width = cairo_image_surface_get_width (surface);
+  gint height = cairo_image_surface_get_height (surface);
+  gint src_stride = cairo_image_surface_get_stride (surface);
+  gboolean shadow = gst_logo_effects_has_shadow (effects);
+  gboolean outline = effects->outline_width > 0
+      && (effects->outline_color >> 24) > 0;
+  gboolean glow = effects->glow_radius > 0 && (effects->glow_color >> 24) > 0;
+  gint spread = outline ? effects->outline_width + 1 : 0;
+  gint left, right, top, bottom, w, h, stride, x, y;
+  guint8 *mask, *blurred = NULL, *glowing = NULL;
+  const guint8 *src;
+  cairo_surface_t *result;
+  guint8 *data;
+
+  *x_offset = *y_offset = 0;
+  if (gst_logo_effects_is_none (effects))
+    return cairo_surface_reference (surface);
+
+  left = right = top = bottom = spread;
+  if (glow) {
+    gint reach = spread + gst_logo_effect_reach (effects->glow_radius);
+
+    left = right = top = bottom = reach;
+  }
+  if (shadow) {
+    gint reach = spread + gst_logo_effect_reach (effects->shadow_blur);
+
+    left = MAX (left, reach - effects->shadow_x);
+    right = MAX (right, reach + effects->shadow_x);
+    top = MAX (top, reach - effects->shadow_y);
+    bottom = MAX (bottom, reach + effects->shadow_y);
+  }
+  w = width + left + right;
+  h = height + top + bottom;
+
+  /* The coverage of the logo, grown by the outline */
+  cairo_surface_flush (surface);
+  src = cairo_image_surface_get_data (surface);
+  mask = g_malloc0 ((gsize) w * h);
+  for (y = 0; y < height; y++)
+    for (x = 0; x < width; x++)
+      mask[(gsize) (y + top) * w + x + left] =
+          ((const guint32 *) (src + (gsize) y * src_stride))[x] >> 24;
+  if (outline) {
+    guint8 *grown = gst_logo_effect_dilate (mask, w, h,
+        effects->outline_width);
+
+    g_free (mask);
+    mask = grown;
+  }
+  if (shadow) {
+    blurred = g_malloc ((gsize) w * h);
+    memcpy (blurred, mask, (gsize) w * h);
+    gst_logo_effect_blur (blurred, w, h, effects->shadow_blur);
+  }
+  if (glow) {
+    glowing = g_malloc ((gsize) w * h);
+    memcpy (glowing, mask, (gsize) w * h);
+    gst_logo_effect_blur (glowing, w, h, effects->glow_radius);
+  }
+
+  result = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, w, h);
+  cairo_surface_flush (result);
+  data = cairo_image_surface_get_data (result);
+  stride = cairo_image_surface_get_stride (result);
+  for (y = 0; y < h; y++) {
+    guint32 *dst = (guint32 *) (data + (gsize) y * stride);
+
+    for (x = 0; x < w; x++) {
+      guint32 px = 0;
+
+      if (shadow) {
+        gint sx = x - effects->shadow_x, sy = y - effects->shadow_y;
+
+        if (sx >= 0 && sy >= 0 && sx < w && sy < h)
+          px = gst_logo_effect_over (px, effects->shadow_color,
+              blurred[(gsize) sy * w + sx]);
+      }
+      /* The glow is twice as strong as the blur so it hugs the edge */
+      if (glow)
+        px = gst_logo_effect_over (px, effects->glow_color,
+            MIN (255, 2 * glowing[(gsize) y * w + x]));
+      if (outline)
+        px = gst_logo_effect_over (px, effects->outline_color,
+            mask[(gsize) y * w + x]);
+      if (x >= left && y >= top && x < left + width && y < top + height) {
+        guint32 logo = ((const guint32 *) (src + (gsize) (y - top)
+                * src_stride))[x - left];
+        guint inv = 255 - (logo >> 24);
+        guint shift;
+        guint32 out = 0;
+
+        for (shift = 0; shift < 32; shift += 8)
+          out |= (((logo >> shift) & 0xff)
+              + gst_logo_effect_div255 (((px >> shift) & 0xff) * inv))
+              << shift;
+        px = out;
+      }
+      dst[x] = px;
+    }
+  }
+  cairo_surface_mark_dirty (result);
+
+  g_free (glowing);
+  g_free (blurred);
+  g_free (mask);
+
+  *x_offset = left;
+  *y_offset = top;
+  return result;
+}
+
+/**
+ * @brief Draws a variant of a logo for backgrounds the logo is lost on.
+ *
+ * A light logo gets a dark variant and a dark logo a light one. The
+ * colours are pulled most of the way towards black or white while the
+ * coverage is kept, so the variant has the shape of the logo and can be
+ * cross-faded with it.
+ *
+ * @param surface The logo with its effects as premultiplied ARGB32.
+ * @param light Light of the logo, 0 for black to 1 for white.
+ * @return A new surface of the size of @surface.
+ */
+cairo_surface_t *
+gst_logo_effects_draw_variant (cairo_surface_t * surface, gdouble light)
+{
+  gint width = cairo_image_surface_get_width (surface);
+  gint height = cairo_image_surface_get_height (surface);
+  gint src_stride = cairo_image_surface_get_stride (surface);
+  gboolean darken = light > 0.5;
+  const guint8 *src;
+  cairo_surface_t *result;
+  guint8 *data;
+  gint stride, x, y;
+
+  cairo_surface_flush (surface);
+  src = cairo_image_surface_get_data (surface);
+  result = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+  cairo_surface_flush (result);
+  data = cairo_image_surface_get_data (result);
+  stride = cairo_image_surface_get_stride (result);
+  for (y = 0; y < height; y++) {
+    const guint32 *in = (const guint32 *) (src + (gsize) y * src_stride);
+    guint32 *out = (guint32 *) (data + (gsize) y * stride);
+
+    for (x = 0; x < width; x++) {
+      guint a = in[x] >> 24;
+      guint32 px = in[x] & 0xff000000;
+      guint shift;
+
+      for (shift = 0; shift < 24; shift += 8) {
+        guint c = (in[x] >> shift) & 0xff;
+
+        /* Premultiplied, so white at this coverage is a, not 255 */
+        if (darken)
+          c -= (c * GST_LOGO_EFFECT_VARIANT_PULL + 128) >> 8;
+        else
+          c += ((a - c) * GST_LOGO_EFFECT_VARIANT_PULL + 128) >> 8;
+        px |= c << shift;
+      }
+      out[x] = px;
+    }
+  }
+  cairo_surface_mark_dirty (result);
+
+  return result;
+}
@@ -0,0 +1,106 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_EFFECT_H__
+#define __GST_LOGO_EFFECT_H__
+
+#include <gst/gst.h>
+#include <cairo.h>
+
+G_BEGIN_DECLS
+
+/* Default effect colours as 0xAARRGGBB */
+#define GST_LOGO_EFFECT_SHADOW_COLOR	0xa0000000
+#define GST_LOGO_EFFECT_OUTLINE_COLOR	0xff000000
+#define GST_LOGO_EFFECT_GLOW_COLOR	0xc0ffffff
+
+/* Largest shadow offset, blur, outline width and glow radius in pixels */
+#define GST_LOGO_EFFECT_MAX_SIZE	64
+
+/**
+ * GstLogoEffects:
+ * @shadow_x: horizontal offset of the drop shadow in pixels.
+ * @shadow_y: vertical offset of the drop shadow in pixels.
+ * @shadow_blur: blur radius of the drop shadow in pixels.
+ * @shadow_color: colour of the drop shadow as 0xAARRGGBB.
+ * @outline_width: width of the outline around the logo in pixels, 0 for
+ *     none.
+ * @outline_color: colour of the outline as 0xAARRGGBB.
+ * @glow_radius: radius of the glow around the logo in pixels, 0 for none.
+ * @glow_color: colour of the glow as 0xAARRGGBB.
+ * @contrast_variant: whether a light or dark variant of the logo with its
+ *     effects is prepared as well, see gst_logo_effects_draw_variant().
+ *
+ * Effects drawn around the logo once, when it is prepared for a
+ * resolution. There is a shadow if it is offset or blurred. Structures
+ * are compared bytewise, so always start from gst_logo_effects_init().
+ */
+typedef struct
+{
+  gint shadow_x;
+  gint shadow_y;
+  guint shadow_blur;
+  guint32 shadow_color;
+  guint outline_width;
+  guint32 outline_color;
+  guint glow_radius;
+  guint32 glow_color;
+  gboolean contrast_variant;
+} GstLogoEffects;
+
+void gst_logo_effects_init (GstLogoEffects * effects);
+gboolean gst_logo_effects_is_none (const GstLogoEffects * effects);
+gboolean gst_logo_effects_is_equal (const GstLogoEffects * a,
+    const GstLogoEffects * b);
+gboolean gst_logo_effects_parse_structure (GstLogoEffects * effects,
+    const GstStructure * s);
+cairo_surface_t *gst_logo_effects_apply (const GstLogoEffects * effects,
+    cairo_surface_t * surface, gint * x_offset, gint * y_offset);
+cairo_surface_t *gst_logo_effects_draw_variant (cairo_surface_t * surface,
+    gdouble light);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_EFFECT_H__ */
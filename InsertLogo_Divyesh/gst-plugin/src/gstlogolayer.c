@@ -0,0 +1,520 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "gstlogolayer.h"
+
+/**
+ * @brief Creates a layer from its description.
+ *
+ * The structure name is the layer name. Known fields are "logo-file",
+ * "x", "y", "alpha" (0 to 100), "scrolling" (off, ltr, rtl), "rotation"
+ * (no-rotate, clockwise, counter-clockwise), "speed" (slow, medium, fast)
+ * "logo-scale" (see gst_logo_scale_parse()), "path" (off, horizontal,
+ * vertical, diagonal) and "repeat" (once, loop, bounce), with the same
+ * meaning as the element properties of the same name. Logo layers also
+ * take the effect fields of gst_logo_effects_parse_structure().
+ *
+ * A layer with a "text" field instead of "logo-file" is a text layer, see
+ * gst_logo_text_expand() for its placeholders. It takes "font" (family,
+ * optionally followed by Bold and/or Italic), "font-size" in pixels and
+ * "color" as 0xAARRGGBB. Text layers can scroll but not rotate.
+ *
+ * @param s The layer description.
+ * @return A new layer, or NULL with a warning if @s is invalid.
+ */
+GstLogoLayer *
+gst_logo_layer_new_from_structure (const GstStructure * s)
+{
+  const gchar *name = gst_structure_get_name (s);
+  const gchar *logo, *text, *font, *str, *ext;
+  GstLogoLayer *layer;
+  GstLogoScale scale;
+  GstLogoEffects effects;
+  gdouble speed = 0;
+  GstLogoMotion motion = GST_LOGO_MOTION_NONE;
+  GstLogoPath path = GST_LOGO_PATH_OFF;
+  GstLogoRepeat repeat = GST_LOGO_REPEAT_LOOP;
+  gint x = -1, y = -1, alpha = 100, font_size = 32;
+  guint color = 0xffffffff;
+
+  logo = gst_structure_get_string (s, "logo-file");
+  text = gst_structure_get_string (s, "text");
+  if ((logo == NULL) == (text == NULL)) {
+    g_warning ("Layer '%s' needs either a logo-file or a text.", name);
+    return NULL;
+  }
+  ext = logo ? strrchr (logo, '.') : NULL;
+  if (logo != NULL && (ext == NULL || strcmp (ext, ".png") != 0)) {
+    g_warning ("Invalid logo file format '%s' for layer '%s'. Only files with the extension .png are valid.", logo, name);
+    return NULL;
+  }
+
+  if ((gst_structure_has_field (s, "x")
+          && !gst_structure_get_int (s, "x", &x))
+      || (gst_structure_has_field (s, "y")
+          && !gst_structure_get_int (s, "y", &y)) || x < -1 || y < -1) {
+    g_warning ("Invalid position for layer '%s'. Valid values are positive integer numbers.", name);
+    return NULL;
+  }
+
+  if (gst_structure_has_field (s, "alpha")
+      && (!gst_structure_get_int (s, "alpha", &alpha) || alpha < 0
+          || alpha > 100)) {
+    g_warning ("Invalid alpha for layer '%s'. Valid values are '0 to 100 (integer)'.", name);
+    return NULL;
+  }
+
+  str = gst_structure_get_string (s, "scrolling");
+  if (str != NULL && strcmp (str, "off") != 0) {
+    if (strcmp (str, "ltr") == 0) {
+      motion = GST_LOGO_MOTION_SCROLL_LTR;
+    } else if (strcmp (str, "rtl") == 0) {
+      motion = GST_LOGO_MOTION_SCROLL_RTL;
+    } else {
+      g_warning ("Invalid value '%s' for scrolling of layer '%s'. Valid values are 'off', 'ltr', or 'rtl'.", str, name);
+      return NULL;
+    }
+  }
+
+  str = gst_structure_get_string (s, "rotation");
+  if (str != NULL && strcmp (str, "no-rotate") != 0) {
+    if (motion != GST_LOGO_MOTION_NONE) {
+      g_warning ("Rotation and Scroll Both are Enabled on layer '%s'.", name);
+      return NULL;
+    }
+    if (text != NULL) {
+      g_warning ("Text layer '%s' cannot rotate.", name);
+      return NULL;
+    }
+    if (strcmp (str, "clockwise") == 0) {
+      motion = GST_LOGO_MOTION_CLOCKWISE;
+    } else if (strcmp (str, "counter-clockwise") == 0) {
+      motion = GST_LOGO_MOTION_COUNTER_CLOCKWISE;
+    } else {
+      g_warning ("Invalid value '%s' for rotation of layer '%s'. Valid values are 'no-rotate', 'clockwise', or 'counter-clockwise'.", str, name);
+      return NULL;
+    }
+  }
+
+  str = gst_structure_get_string (s, "speed");
+  if (!gst_logo_speed_parse (str ? str : "slow",
+          motion >= GST_LOGO_MOTION_CLOCKWISE, &speed)) {
+    g_warning ("Invalid value '%s' for speed of layer '%s'. Valid values are 'slow', 'medium', or 'fast'.", str, name);
+    return NULL;
+  }
+
+  str = gst_structure_get_string (s, "path");
+  if (str != NULL && !gst_logo_path_parse (str, &path)) {
+    g_warning ("Invalid value '%s' for path of layer '%s'. Valid values are 'off', 'horizontal', 'vertical', or 'diagonal'.", str, name);
+    return NULL;
+  }
+  if (path != GST_LOGO_PATH_OFF && motion != GST_LOGO_MOTION_NONE) {
+    g_warning ("Path and Scroll or Rotation are Enabled on layer '%s'. At a particular time, only one animation will work.", name);
+    return NULL;
+  }
+
+  str = gst_structure_get_string (s, "repeat");
+  if (str != NULL && !gst_logo_repeat_parse (str, &repeat)) {
+    g_warning ("Invalid value '%s' for repeat of layer '%s'. Valid values are 'once', 'loop', or 'bounce'.", str, name);
+    return NULL;
+  }
+
+  str = gst_structure_get_string (s, "logo-scale");
+  if (!gst_logo_scale_parse (str, &scale)) {
+    g_warning ("Invalid value '%s' for logo-scale of layer '%s'. Valid values are 'off', a fraction of the frame height (0 to 1) or 'WxH'.", str, name);
+    return NULL;
+  }
+
+  gst_logo_effects_init (&effects);
+  if (!gst_logo_effects_parse_structure (&effects, s)) {
+    g_warning ("Invalid effect for layer '%s'. Valid values are '-64 to 64' for shadow-x and shadow-y, '0 to 64' for shadow-blur, outline-width and glow-radius, and 0xAARRGGBB for the colours.", name);
+    return NULL;
+  }
+  if (text != NULL && !gst_logo_effects_is_none (&effects)) {
+    g_warning ("Text layer '%s' cannot have effects.", name);
+    return NULL;
+  }
+
+  font = gst_structure_get_string (s, "font");
+  if (font == NULL)
+    font = "Sans";
+  if (gst_structure_has_field (s, "font-size")
+      && (!gst_structure_get_int (s, "font-size", &font_size)
+          || font_size < 4 || font_size > 512)) {
+    g_warning ("Invalid font-size for layer '%s'. Valid values are '4 to 512 (integer)'.", name);
+    return NULL;
+  }
+  /* A colour above G_MAXINT parses as unsigned, below as signed */
+  if (gst_structure_has_field (s, "color")
+      && !gst_structure_get_uint (s, "color", &color)
+      && !gst_structure_get_int (s, "color", (gint *) & color)) {
+    g_warning ("Invalid color for layer '%s'. Valid values are 0xAARRGGBB.", name);
+    return NULL;
+  }
+
+  layer = g_new0 (GstLogoLayer, 1);
+  layer->name = g_strdup (name);
+  layer->x = x;
+  layer->y = y;
+  layer->alpha = alpha;
+  layer->motion = motion;
+  layer->speed = speed;
+  layer->path = path;
+  layer->repeat = repeat;
+
+  if (text != NULL) {
+    layer->text = g_strdup (text);
+    layer->font = g_strdup (font);
+    layer->font_size = font_size;
+    layer->color = color;
+    layer->line = g_string_new (NULL);
+    return layer;
+  }
+
+  layer->logo = g_strdup (logo);
+  layer->scale = scale;
+  layer->effects = effects;
+  layer->cache = gst_logo_cache_new ();
+  gst_logo_cache_set_source (layer->cache, layer->logo, &layer->scale,
+      &layer->effects);
+
+  return layer;
+}
+
+/**
+ * @brief Frees a layer and its logo cache.
+ *
+ * @param layer The layer to free, may be NULL.
+ */
+void
+gst_logo_layer_free (GstLogoLayer * layer)
+{
+  if (layer == NULL)
+    return;
+
+  gst_logo_anim_free (layer->anim);
+  gst_logo_sprite_free (layer->transformed);
+  if (layer->transformed_surface)
+    cairo_surface_destroy (layer->transformed_surface);
+  gst_logo_image_unref (layer->image);
+  gst_logo_cache_free (layer->cache);
+  gst_logo_glyph_atlas_unref (layer->atlas);
+  if (layer->line)
+    g_string_free (layer->line, TRUE);
+  g_free (layer->font);
+  g_free (layer->text);
+  g_free (layer->logo);
+  g_free (layer->name);
+  g_free (layer);
+}
+
+/**
+ * @brief Rasterizes the glyphs of a text layer.
+ *
+ * The glyph atlas of a layer in @previous with the same font, size,
+ * colour, format and colorimetry is shared instead, so replacing the layers
+ * to change a text does not rasterize the font again. An atlas of another
+ * format or colorimetry is replaced, nothing is rasterized before the
+ * format is known.
+ *
+ * @param layer The layer, nothing is done for logo layers.
+ * @param previous The layers that are replaced, may be NULL.
+ * @param format The negotiated video format.
+ * @param colorimetry The negotiated colorimetry.
+ */
+void
+gst_logo_layer_load_atlas (GstLogoLayer * layer, GPtrArray * previous,
+    GstVideoFormat format, const GstVideoColorimetry * colorimetry)
+{
+  guint i;
+
+  if (layer->text == NULL || !gst_logo_sprite_supports_format (format))
+    return;
+  if (layer->atlas != NULL) {
+    if (layer->atlas->format == format
+        && gst_video_colorimetry_is_equal (&layer->atlas->colorimetry,
+            colorimetry))
+      return;
+    gst_logo_glyph_atlas_unref (layer->atlas);
+    layer->atlas = NULL;
+  }
+
+  for (i = 0; previous != NULL && i < previous->len; i++) {
+    GstLogoLayer *old = g_ptr_array_index (previous, i);
+
+    if (old->atlas != NULL && gst_logo_glyph_atlas_matches (old->atlas,
+            layer->font, layer->font_size, layer->color, format,
+            colorimetry)) {
+      layer->atlas = gst_logo_glyph_atlas_ref (old->atlas);
+      return;
+    }
+  }
+
+  layer->atlas = gst_logo_glyph_atlas_new (layer->font, layer->font_size,
+      layer->color, format, colorimetry);
+}
+
+/**
+ * @brief Starts building the logo or the glyphs of a layer for a
+ * resolution and format.
+ *
+ * @param layer The layer.
+ * @param frame_width Negotiated frame width.
+ * @param frame_height Negotiated frame height.
+ * @param format Negotiated video format.
+ * @param colorimetry Negotiated colorimetry.
+ */
+void
+gst_logo_layer_prepare (GstLogoLayer * layer, gint frame_width,
+    gint frame_height, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry)
+{
+  if (layer->cache != NULL)
+    gst_logo_cache_prepare (layer->cache, frame_width, frame_height, format,
+        colorimetry);
+  gst_logo_layer_load_atlas (layer, NULL, format, colorimetry);
+}
+
+/**
+ * @brief Builds the animation timeline of a layer.
+ *
+ * The timeline only depends on the frame size and the size of the layer
+ * content, so it is built again only when one of them changes.
+ *
+ * @param layer The layer.
+ * @param info The video info of the frame.
+ * @param width The width of the layer content.
+ * @param height The height of the layer content.
+ */
+static void
+gst_logo_layer_update_anim (GstLogoLayer * layer, const GstVideoInfo * info,
+    gint width, gint height)
+{
+  gint frame_width = GST_VIDEO_INFO_WIDTH (info);
+  gint frame_height = GST_VIDEO_INFO_HEIGHT (info);
+  gint key[4] = { frame_width, frame_height, width, height };
+  GstClockTime step = GST_SECOND / 60;
+  gint x, y;
+
+  if (layer->anim != NULL && memcmp (key, layer->anim_key, sizeof (key)) == 0)
+    return;
+  memcpy (layer->anim_key, key, sizeof (key));
+  gst_logo_anim_free (layer->anim);
+
+  /* Default position is the top right corner like the element */
+  x = layer->x >= 0 ? layer->x : frame_width - width - (height / 30);
+  y = layer->y >= 0 ? layer->y : MAX (height / 30, 1);
+
+  switch (layer->motion) {
+    case GST_LOGO_MOTION_SCROLL_LTR:
+      layer->anim = gst_logo_anim_new_scroll (x, y, layer->alpha,
+          frame_width + width, layer->speed);
+      break;
+    case GST_LOGO_MOTION_SCROLL_RTL:
+      layer->anim = gst_logo_anim_new_scroll (x, y, layer->alpha,
+          -(frame_width + width), layer->speed);
+      break;
+    case GST_LOGO_MOTION_CLOCKWISE:
+      layer->anim = gst_logo_anim_new_spin (x, y, layer->alpha, layer->speed);
+      break;
+    case GST_LOGO_MOTION_COUNTER_CLOCKWISE:
+      layer->anim = gst_logo_anim_new_spin (x, y, layer->alpha,
+          -layer->speed);
+      break;
+    default:
+      if (layer->path != GST_LOGO_PATH_OFF)
+        layer->anim = gst_logo_anim_new_path (layer->path, layer->repeat, x,
+            y, layer->alpha, frame_width - width, frame_height - height,
+            layer->speed);
+      else
+        layer->anim = gst_logo_anim_new_static (x, y, layer->alpha);
+      break;
+  }
+
+  /* One table entry per frame */
+  if (GST_VIDEO_INFO_FPS_N (info) > 0)
+    step = gst_util_uint64_scale_int (GST_SECOND, GST_VIDEO_INFO_FPS_D (info),
+        GST_VIDEO_INFO_FPS_N (info));
+  gst_logo_anim_compile (layer->anim, step);
+}
+
+/**
+ * @brief Gives the rotated sprite of a layer logo.
+ *
+ * The last sprite is kept and reused while the logo, angle and scale stay
+ * the same. The cache builds a new logo surface for another resolution or
+ * format, which draws the sprite again.
+ *
+ * @param layer The layer.
+ * @param image The logo of the frame.
+ * @param angle The rotation in degrees.
+ * @param scale The scale factor.
+ * @return The sprite, owned by @layer.
+ */
+static const GstLogoSprite *
+gst_logo_layer_get_transformed (GstLogoLayer * layer,
+    const GstLogoImage * image, gfloat angle, gfloat scale)
+{
+  const GstLogoSprite *sprite = image->sprite;
+
+  if (layer->transformed != NULL && layer->transformed_surface == image->surface
+      && layer->transformed->format == sprite->format
+      && gst_video_colorimetry_is_equal (&layer->transformed->colorimetry,
+          &sprite->colorimetry) && layer->transformed_angle == angle
+      && layer->transformed_scale == scale)
+    return layer->transformed;
+
+  gst_logo_sprite_free (layer->transformed);
+  if (layer->transformed_surface)
+    cairo_surface_destroy (layer->transformed_surface);
+  layer->transformed = gst_logo_sprite_new_transformed (image->surface, angle,
+      scale, sprite->format, &sprite->colorimetry);
+  layer->transformed_surface = cairo_surface_reference (image->surface);
+  layer->transformed_angle = angle;
+  layer->transformed_scale = scale;
+
+  return layer->transformed;
+}
+
+/**
+ * @brief Queues the sprites of a layer for a frame.
+ *
+ * The position, angle and opacity are looked up in the animation timeline
+ * at @running_time, and the angle and scale are coarsened by the QoS
+ * ladder like those of the logo. The sprites stay valid until the next call
+ * or until the layer is freed. Nothing is queued if the logo could not be
+ * loaded.
+ *
+ * @param layer The layer.
+ * @param info The video info of the frame.
+ * @param pts Presentation timestamp of the frame, used for timecodes.
+ * @param running_time Running time of the frame.
+ * @param qos The QoS ladder of the element.
+ * @param placements Array of #GstLogoPlacement to append to.
+ */
+void
+gst_logo_layer_place (GstLogoLayer * layer, const GstVideoInfo * info,
+    GstClockTime pts, GstClockTime running_time, const GstLogoQos * qos,
+    GArray * placements)
+{
+  gint frame_width = GST_VIDEO_INFO_WIDTH (info);
+  gint frame_height = GST_VIDEO_INFO_HEIGHT (info);
+  GstVideoFormat format = GST_VIDEO_INFO_FORMAT (info);
+  const GstVideoColorimetry *colorimetry = &GST_VIDEO_INFO_COLORIMETRY (info);
+  const GstLogoAnimState *state;
+  GstLogoPlacement placement;
+  GstLogoImage *image = NULL;
+  gint width, height;
+  gfloat angle, scale;
+
+  if (layer->text != NULL) {
+    gst_logo_layer_load_atlas (layer, NULL, format, colorimetry);
+    gst_logo_text_expand (layer->text, pts, GST_VIDEO_INFO_FPS_N (info),
+        GST_VIDEO_INFO_FPS_D (info), layer->line);
+    width = gst_logo_glyph_atlas_measure (layer->atlas, layer->line->str);
+    height = layer->atlas->height;
+  } else {
+    image = gst_logo_cache_get (layer->cache, frame_width, frame_height,
+        format, colorimetry);
+    gst_logo_image_unref (layer->image);
+    layer->image = image;
+    if (image == NULL)
+      return;
+    width = image->width;
+    height = image->height;
+  }
+
+  gst_logo_layer_update_anim (layer, info, width, height);
+  state = gst_logo_anim_eval (layer->anim, running_time);
+
+  placement.x = state->x;
+  placement.y = state->y;
+  placement.alpha = state->alpha;
+  placement.width = 0;
+  placement.height = 0;
+
+  /* Scrolling wraps around once the content left the frame */
+  if (layer->motion == GST_LOGO_MOTION_SCROLL_LTR
+      || layer->motion == GST_LOGO_MOTION_SCROLL_RTL) {
+    gint range = frame_width + width;
+
+    placement.x = ((placement.x + width) % range + range) % range - width;
+  }
+
+  if (layer->text != NULL) {
+    gst_logo_glyph_atlas_layout (layer->atlas, layer->line->str,
+        placement.x, placement.y, placement.alpha, placements);
+    return;
+  }
+
+  /* The effects around the logo start up and to the left of it */
+  placement.sprite = image->sprite;
+  placement.x -= image->x_offset;
+  placement.y -= image->y_offset;
+  angle = state->angle;
+  scale = state->scale;
+  gst_logo_qos_quantize (qos, &angle, &scale);
+
+  /* A logo that is only scaled is resampled from its mip pyramid while it
+   * is blended; the transformed sprites stay centered on the logo */
+  if (angle == 0 && scale != 1) {
+    placement.width = lround (image->sprite->width * scale);
+    placement.height = lround (image->sprite->height * scale);
+    if (placement.width == 0 || placement.height == 0)
+      return;
+    placement.x -= (placement.width - image->sprite->width) / 2;
+    placement.y -= (placement.height - image->sprite->height) / 2;
+  } else if (angle != 0) {
+    placement.sprite = gst_logo_layer_get_transformed (layer, image, angle,
+        scale);
+    placement.x -= (placement.sprite->width - image->sprite->width) / 2;
+    placement.y -= (placement.sprite->height - image->sprite->height) / 2;
+  }
+
+  g_array_append_val (placements, placement);
+}
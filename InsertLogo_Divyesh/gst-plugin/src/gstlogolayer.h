@@ -0,0 +1,152 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_LAYER_H__
+#define __GST_LOGO_LAYER_H__
+
+#include <gst/gst.h>
+
+#include <gst/video/video.h>
+
+#include "gstlogoanim.h"
+#include "gstlogocache.h"
+#include "gstlogoqos.h"
+#include "gstlogotext.h"
+
+G_BEGIN_DECLS
+
+/**
+ * GstLogoMotion:
+ * @GST_LOGO_MOTION_NONE: the layer stays at its position.
+ * @GST_LOGO_MOTION_SCROLL_LTR: the layer scrolls from left to right.
+ * @GST_LOGO_MOTION_SCROLL_RTL: the layer scrolls from right to left.
+ * @GST_LOGO_MOTION_CLOCKWISE: the layer rotates clockwise.
+ * @GST_LOGO_MOTION_COUNTER_CLOCKWISE: the layer rotates counter-clockwise.
+ */
+typedef enum
+{
+  GST_LOGO_MOTION_NONE,
+  GST_LOGO_MOTION_SCROLL_LTR,
+  GST_LOGO_MOTION_SCROLL_RTL,
+  GST_LOGO_MOTION_CLOCKWISE,
+  GST_LOGO_MOTION_COUNTER_CLOCKWISE
+} GstLogoMotion;
+
+/**
+ * GstLogoLayer:
+ * @name: the layer name, taken from the structure name.
+ * @logo: path of the PNG logo, NULL for a text layer.
+ * @text: the text with placeholders, NULL for a logo layer.
+ * @font: the font of a text layer.
+ * @font_size: the font size of a text layer in pixels.
+ * @color: the text colour as 0xAARRGGBB.
+ * @x: horizontal position, -1 for the top right corner.
+ * @y: vertical position, -1 for the top right corner.
+ * @alpha: opacity of the layer, 0 to 100.
+ * @motion: how the layer is animated.
+ * @speed: animation speed in pixels or degrees per second.
+ * @path: the edges a path animation moves between.
+ * @repeat: the repeat mode of a path animation.
+ * @scale: how the logo is sized per resolution.
+ * @effects: the effects drawn around the logo.
+ * @cache: the per-resolution cache of the prepared logo.
+ * @atlas: the glyphs of a text layer.
+ * @line: the text of the current frame.
+ * @image: the logo used for the current frame.
+ * @transformed: the last rotated sprite, kept for reuse.
+ * @transformed_surface: the logo surface @transformed was drawn from.
+ * @transformed_angle: the rotation @transformed was drawn with.
+ * @transformed_scale: the scale @transformed was drawn with.
+ * @anim: the animation timeline.
+ * @anim_key: frame width, frame height, content width and content height
+ *     the timeline was built for.
+ *
+ * One overlay of a layer stack. Layers are only touched from the streaming
+ * thread once they are handed to the element.
+ */
+typedef struct
+{
+  gchar *name;
+  gchar *logo;
+  gchar *text;
+  gchar *font;
+  gint font_size;
+  guint32 color;
+  gint x;
+  gint y;
+  gint alpha;
+  GstLogoMotion motion;
+  gdouble speed;
+  GstLogoPath path;
+  GstLogoRepeat repeat;
+  GstLogoScale scale;
+  GstLogoEffects effects;
+  GstLogoCache *cache;
+  GstLogoGlyphAtlas *atlas;
+  GString *line;
+  GstLogoImage *image;
+  GstLogoSprite *transformed;
+  cairo_surface_t *transformed_surface;
+  gfloat transformed_angle;
+  gfloat transformed_scale;
+  GstLogoAnim *anim;
+  gint anim_key[4];
+} GstLogoLayer;
+
+GstLogoLayer *gst_logo_layer_new_from_structure (const GstStructure * s);
+void gst_logo_layer_free (GstLogoLayer * layer);
+void gst_logo_layer_load_atlas (GstLogoLayer * layer, GPtrArray * previous,
+    GstVideoFormat format, const GstVideoColorimetry * colorimetry);
+
+void gst_logo_layer_prepare (GstLogoLayer * layer, gint frame_width,
+    gint frame_height, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry);
+void gst_logo_layer_place (GstLogoLayer * layer, const GstVideoInfo * info,
+    GstClockTime pts, GstClockTime running_time, const GstLogoQos * qos,
+    GArray * placements);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_LAYER_H__ */
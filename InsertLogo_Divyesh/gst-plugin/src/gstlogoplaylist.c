@@ -0,0 +1,721 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:gstlogoplaylist
+ *
+ * A playlist of sponsor logos that are shown one after the other by
+ * running time and start over at the end. A worker thread decodes the
+ * logo of the current entry and prefetches the next one as soon as the
+ * current one is on screen, so only two logos are ever resident no matter
+ * how long the playlist is. The last part of every entry can crossfade
+ * into the next one.
+ *
+ * The entries either come from the element property or from a playlist
+ * file, which the worker checks once a second and reads again when it was
+ * modified.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogoplaylist.h"
+#include <glib/gstdio.h>
+#include <string.h>
+
+/* How often the playlist file is checked for changes */
+#define GST_LOGO_PLAYLIST_POLL (G_USEC_PER_SEC)
+
+/* A resident logo. @done is set once the worker has finished @entry,
+ * @image stays NULL if the logo could not be loaded. */
+typedef struct
+{
+  gint entry;
+  gboolean done;
+  GstLogoImage *image;
+} GstLogoPlaylistSlot;
+
+struct _GstLogoPlaylist
+{
+  GMutex lock;
+  GCond cond;
+  GThread *thread;
+
+  /* protected by lock */
+  gboolean quit;
+  GArray *entries;
+  gchar *file;
+  GArray *file_entries;
+  gint64 file_mtime;
+  GstLogoScale scale;
+  GstLogoEffects effects;
+  GstClockTime crossfade;
+  gint frame_height;
+  GstVideoFormat format;
+  GstVideoColorimetry colorimetry;
+  guint generation;
+  guint want;
+  GstLogoPlaylistSlot slots[2];
+  GstLogoImage *last;
+};
+
+static void
+gst_logo_playlist_entry_clear (gpointer data)
+{
+  GstLogoPlaylistEntry *entry = data;
+
+  g_free (entry->file);
+}
+
+/**
+ * @brief Creates an empty array of #GstLogoPlaylistEntry.
+ */
+GArray *
+gst_logo_playlist_entries_new (void)
+{
+  GArray *entries;
+
+  entries = g_array_new (FALSE, TRUE, sizeof (GstLogoPlaylistEntry));
+  g_array_set_clear_func (entries, gst_logo_playlist_entry_clear);
+  return entries;
+}
+
+static gboolean
+gst_logo_playlist_check_entry (const gchar * file, gdouble seconds)
+{
+  const gchar *ext = file ? strrchr (file, '.') : NULL;
+
+  if (ext == NULL || strcmp (ext, ".png") != 0) {
+    g_warning ("Invalid playlist logo '%s'. Only files with the extension .png are valid.", file);
+    return FALSE;
+  }
+  if (seconds <= 0) {
+    g_warning ("Invalid duration for playlist logo '%s'. Valid values are above 0 seconds.", file);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/**
+ * @brief Parses one playlist entry from the element property.
+ *
+ * Known fields are "logo-file" and "duration" in seconds, the structure
+ * name is free.
+ *
+ * @param s The entry description.
+ * @param entry Return location for the entry, @file is newly allocated.
+ * @return TRUE if @s was valid, FALSE with a warning otherwise.
+ */
+gboolean
+gst_logo_playlist_entry_parse (const GstStructure * s,
+    GstLogoPlaylistEntry * entry)
+{
+  const gchar *file = gst_structure_get_string (s, "logo-file");
+  gdouble seconds = -1;
+  gint i;
+
+  if (!gst_structure_get_double (s, "duration", &seconds)
+      && gst_structure_get_int (s, "duration", &i))
+    seconds = i;
+  if (!gst_logo_playlist_check_entry (file, seconds))
+    return FALSE;
+
+  entry->file = g_strdup (file);
+  entry->duration = seconds * GST_SECOND;
+  entry->start = 0;
+  return TRUE;
+}
+
+/**
+ * @brief Reads a playlist file.
+ *
+ * Every line holds the path of a PNG logo followed by its duration in
+ * seconds, separated by whitespace. Empty lines and lines starting with
+ * '#' are ignored and relative paths are relative to the playlist file.
+ *
+ * @param path Path of the playlist file.
+ * @return The entries, or NULL with a warning if the file could not be
+ *     read or has an invalid line.
+ */
+GArray *
+gst_logo_playlist_read_file (const gchar * path)
+{
+  GArray *entries;
+  gchar *contents, *dir, **lines;
+  GError *error = NULL;
+  guint i;
+
+  if (!g_file_get_contents (path, &contents, NULL, &error)) {
+    g_warning ("Could not read playlist '%s': %s", path, error->message);
+    g_error_free (error);
+    return NULL;
+  }
+
+  entries = gst_logo_playlist_entries_new ();
+  dir = g_path_get_dirname (path);
+  lines = g_strsplit (contents, "\n", -1);
+  g_free (contents);
+
+  for (i = 0; lines[i] != NULL; i++) {
+    GstLogoPlaylistEntry entry;
+    gchar *line = g_strstrip (lines[i]), *sep, *end;
+    gdouble seconds;
+
+    if (*line == '\0' || *line == '#')
+      continue;
+
+    sep = line + strlen (line);
+    while (sep > line && !g_ascii_isspace (sep[-1]))
+      sep--;
+    seconds = g_ascii_strtod (sep, &end);
+    if (sep == line || end == sep || *end != '\0') {
+      g_warning ("Invalid line %u in playlist '%s'. Expected a logo file and its duration in seconds.", i + 1, path);
+      goto error;
+    }
+    sep[-1] = '\0';
+    line = g_strchomp (line);
+    if (!gst_logo_playlist_check_entry (line, seconds))
+      goto error;
+
+    entry.file = g_path_is_absolute (line) ? g_strdup (line) :
+        g_build_filename (dir, line, NULL);
+    entry.duration = seconds * GST_SECOND;
+    entry.start = 0;
+    g_array_append_val (entries, entry);
+  }
+
+  g_strfreev (lines);
+  g_free (dir);
+  return entries;
+
+error:
+  g_strfreev (lines);
+  g_free (dir);
+  g_array_unref (entries);
+  return NULL;
+}
+
+/* Must be called with the lock held */
+static GArray *
+gst_logo_playlist_active (GstLogoPlaylist * playlist)
+{
+  GArray *entries = playlist->file ? playlist->file_entries : playlist->entries;
+
+  return entries != NULL && entries->len > 0 ? entries : NULL;
+}
+
+/* Must be called with the lock held. Drops the resident logos. The logo
+ * shown last is kept, so the playlist goes on showing it while the logos
+ * are decoded again instead of waiting for them. */
+static void
+gst_logo_playlist_reset (GstLogoPlaylist * playlist)
+{
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (playlist->slots); i++) {
+    gst_logo_image_unref (playlist->slots[i].image);
+    playlist->slots[i].image = NULL;
+    playlist->slots[i].entry = -1;
+    playlist->slots[i].done = FALSE;
+  }
+  playlist->want = 0;
+  playlist->generation++;
+  g_cond_broadcast (&playlist->cond);
+}
+
+/* Must be called with the lock held. Returns the logo shown last if it can
+ * still be blended, a logo converted for another format cannot. */
+static GstLogoImage *
+gst_logo_playlist_last (GstLogoPlaylist * playlist)
+{
+  GstLogoImage *last = playlist->last;
+
+  if (last == NULL || last->sprite == NULL
+      || last->sprite->format != playlist->format
+      || !gst_video_colorimetry_is_equal (&last->sprite->colorimetry,
+          &playlist->colorimetry))
+    return NULL;
+  return last;
+}
+
+/* Must be called with the lock held. Takes @entries and computes the
+ * start offset of every entry. */
+static GArray *
+gst_logo_playlist_install (GArray * old, GArray * entries)
+{
+  GstClockTime start = 0;
+  guint i;
+
+  if (old)
+    g_array_unref (old);
+  for (i = 0; entries && i < entries->len; i++) {
+    GstLogoPlaylistEntry *entry =
+        &g_array_index (entries, GstLogoPlaylistEntry, i);
+
+    entry->start = start;
+    start += entry->duration;
+  }
+  return entries;
+}
+
+/* Must be called with the lock held */
+static GstLogoPlaylistSlot *
+gst_logo_playlist_find (GstLogoPlaylist * playlist, gint entry)
+{
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (playlist->slots); i++) {
+    if (playlist->slots[i].entry == entry)
+      return &playlist->slots[i];
+  }
+  return NULL;
+}
+
+/**
+ * @brief Picks the logo to decode next and claims a slot for it.
+ *
+ * Must be called with the lock held. The current entry comes first, then
+ * the next one is prefetched into the slot the previous entry used.
+ *
+ * @return The slot, or NULL if both logos are resident.
+ */
+static GstLogoPlaylistSlot *
+gst_logo_playlist_next_job (GstLogoPlaylist * playlist)
+{
+  GArray *entries = gst_logo_playlist_active (playlist);
+  GstLogoPlaylistSlot *slot = NULL;
+  gint wanted[2], entry = -1;
+  guint i;
+
+  if (entries == NULL || playlist->frame_height <= 0)
+    return NULL;
+
+  wanted[0] = playlist->want;
+  wanted[1] = (playlist->want + 1) % entries->len;
+  for (i = 0; i < 2 && entry < 0; i++) {
+    if (gst_logo_playlist_find (playlist, wanted[i]) == NULL)
+      entry = wanted[i];
+  }
+  if (entry < 0)
+    return NULL;
+
+  for (i = 0; i < G_N_ELEMENTS (playlist->slots) && slot == NULL; i++) {
+    if (playlist->slots[i].entry != wanted[0]
+        && playlist->slots[i].entry != wanted[1])
+      slot = &playlist->slots[i];
+  }
+
+  gst_logo_image_unref (slot->image);
+  slot->image = NULL;
+  slot->entry = entry;
+  slot->done = FALSE;
+  return slot;
+}
+
+/**
+ * @brief Reads the playlist file again if it was modified.
+ *
+ * Must be called with the lock held, which is released while reading. A
+ * file that became invalid keeps the previous entries playing.
+ */
+static void
+gst_logo_playlist_poll_file (GstLogoPlaylist * playlist)
+{
+  GArray *entries = NULL;
+  GStatBuf st;
+  gchar *path;
+
+  path = g_strdup (playlist->file);
+  g_mutex_unlock (&playlist->lock);
+  if (g_stat (path, &st) != 0)
+    st.st_mtime = 0;
+  else if (st.st_mtime != playlist->file_mtime)
+    entries = gst_logo_playlist_read_file (path);
+  g_mutex_lock (&playlist->lock);
+
+  if (g_strcmp0 (path, playlist->file) == 0 && entries != NULL) {
+    playlist->file_mtime = st.st_mtime;
+    playlist->file_entries =
+        gst_logo_playlist_install (playlist->file_entries, entries);
+    gst_logo_playlist_reset (playlist);
+    entries = NULL;
+  }
+  if (entries)
+    g_array_unref (entries);
+  g_free (path);
+}
+
+/**
+ * @brief Worker thread function, keeps the current and next logo resident.
+ */
+static gpointer
+gst_logo_playlist_worker (gpointer data)
+{
+  GstLogoPlaylist *playlist = data;
+  gint64 next_poll = 0;
+
+  g_mutex_lock (&playlist->lock);
+  while (!playlist->quit) {
+    GstLogoPlaylistSlot *slot;
+    GstLogoPlaylistEntry *entry;
+    GstLogoImage *image = NULL;
+    cairo_surface_t *surface;
+    GstLogoScale scale;
+    GstLogoEffects effects;
+    gint index, frame_height;
+    GstVideoFormat format;
+    GstVideoColorimetry colorimetry;
+    guint generation;
+    gchar *file;
+
+    if (playlist->file && g_get_monotonic_time () >= next_poll) {
+      gst_logo_playlist_poll_file (playlist);
+      next_poll = g_get_monotonic_time () + GST_LOGO_PLAYLIST_POLL;
+      continue;
+    }
+
+    slot = gst_logo_playlist_next_job (playlist);
+    if (slot == NULL) {
+      if (playlist->file)
+        g_cond_wait_until (&playlist->cond, &playlist->lock, next_poll);
+      else
+        g_cond_wait (&playlist->cond, &playlist->lock);
+      continue;
+    }
+    index = slot->entry;
+    entry = &g_array_index (gst_logo_playlist_active (playlist),
+        GstLogoPlaylistEntry, index);
+    file = g_strdup (entry->file);
+    scale = playlist->scale;
+    effects = playlist->effects;
+    frame_height = playlist->frame_height;
+    format = playlist->format;
+    colorimetry = playlist->colorimetry;
+    generation = playlist->generation;
+    g_mutex_unlock (&playlist->lock);
+
+    surface = cairo_image_surface_create_from_png (file);
+    if (cairo_surface_status (surface) == CAIRO_STATUS_SUCCESS)
+      image = gst_logo_image_new_from_surface (surface, &scale, &effects,
+          frame_height, format, &colorimetry);
+    else
+      g_warning ("Could not load playlist logo '%s'.", file);
+    cairo_surface_destroy (surface);
+    g_free (file);
+
+    g_mutex_lock (&playlist->lock);
+    if (generation == playlist->generation && slot->entry == index
+        && !slot->done) {
+      slot->image = image;
+      slot->done = TRUE;
+      image = NULL;
+    }
+    g_cond_broadcast (&playlist->cond);
+    g_mutex_unlock (&playlist->lock);
+
+    gst_logo_image_unref (image);
+    g_mutex_lock (&playlist->lock);
+  }
+  g_mutex_unlock (&playlist->lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Creates an empty playlist with its own worker thread.
+ */
+GstLogoPlaylist *
+gst_logo_playlist_new (void)
+{
+  GstLogoPlaylist *playlist = g_new0 (GstLogoPlaylist, 1);
+
+  g_mutex_init (&playlist->lock);
+  g_cond_init (&playlist->cond);
+  gst_logo_playlist_reset (playlist);
+  playlist->thread = g_thread_new ("logoplaylist", gst_logo_playlist_worker,
+      playlist);
+
+  return playlist;
+}
+
+/**
+ * @brief Stops the worker and frees the playlist.
+ */
+void
+gst_logo_playlist_free (GstLogoPlaylist * playlist)
+{
+  if (playlist == NULL)
+    return;
+
+  g_mutex_lock (&playlist->lock);
+  playlist->quit = TRUE;
+  g_cond_broadcast (&playlist->cond);
+  g_mutex_unlock (&playlist->lock);
+  g_thread_join (playlist->thread);
+
+  gst_logo_playlist_reset (playlist);
+  gst_logo_image_unref (playlist->last);
+  if (playlist->entries)
+    g_array_unref (playlist->entries);
+  if (playlist->file_entries)
+    g_array_unref (playlist->file_entries);
+  g_free (playlist->file);
+  g_mutex_clear (&playlist->lock);
+  g_cond_clear (&playlist->cond);
+  g_free (playlist);
+}
+
+/**
+ * @brief Sets the entries from the element property.
+ *
+ * They are played unless a playlist file is set.
+ *
+ * @param playlist The playlist.
+ * @param entries The entries, taken by the playlist, or NULL.
+ */
+void
+gst_logo_playlist_set_entries (GstLogoPlaylist * playlist, GArray * entries)
+{
+  g_mutex_lock (&playlist->lock);
+  playlist->entries = gst_logo_playlist_install (playlist->entries, entries);
+  if (playlist->file == NULL)
+    gst_logo_playlist_reset (playlist);
+  g_mutex_unlock (&playlist->lock);
+}
+
+/**
+ * @brief Sets the playlist file, which takes precedence over the entries.
+ *
+ * The file is read by the worker thread and read again whenever it is
+ * modified.
+ *
+ * @param playlist The playlist.
+ * @param path Path of the playlist file, or NULL to play the entries.
+ */
+void
+gst_logo_playlist_set_file (GstLogoPlaylist * playlist, const gchar * path)
+{
+  g_mutex_lock (&playlist->lock);
+  if (g_strcmp0 (path, playlist->file) != 0) {
+    g_free (playlist->file);
+    playlist->file = g_strdup (path);
+    playlist->file_entries =
+        gst_logo_playlist_install (playlist->file_entries, NULL);
+    playlist->file_mtime = 0;
+    gst_logo_playlist_reset (playlist);
+  }
+  g_mutex_unlock (&playlist->lock);
+}
+
+/**
+ * @brief Sets how the logos are sized and decorated and how long the
+ * crossfade lasts.
+ *
+ * @param playlist The playlist.
+ * @param scale How the logos are sized per resolution.
+ * @param effects The effects drawn around every logo.
+ * @param crossfade Duration of the crossfade into the next logo, 0 cuts.
+ */
+void
+gst_logo_playlist_configure (GstLogoPlaylist * playlist,
+    const GstLogoScale * scale, const GstLogoEffects * effects,
+    GstClockTime crossfade)
+{
+  g_mutex_lock (&playlist->lock);
+  playlist->crossfade = crossfade;
+  if (!gst_logo_scale_is_equal (scale, &playlist->scale)
+      || !gst_logo_effects_is_equal (effects, &playlist->effects)) {
+    playlist->scale = *scale;
+    playlist->effects = *effects;
+    gst_logo_playlist_reset (playlist);
+  }
+  g_mutex_unlock (&playlist->lock);
+}
+
+/**
+ * @brief Sets the negotiated resolution, format and colorimetry and starts
+ * decoding for them.
+ *
+ * @param playlist The playlist.
+ * @param frame_width Negotiated frame width.
+ * @param frame_height Negotiated frame height.
+ * @param format Negotiated video format.
+ * @param colorimetry Negotiated colorimetry.
+ */
+void
+gst_logo_playlist_set_size (GstLogoPlaylist * playlist, gint frame_width,
+    gint frame_height, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry)
+{
+  g_mutex_lock (&playlist->lock);
+  if (frame_height != playlist->frame_height || format != playlist->format
+      || !gst_video_colorimetry_is_equal (colorimetry,
+          &playlist->colorimetry)) {
+    playlist->frame_height = frame_height;
+    playlist->format = format;
+    playlist->colorimetry = *colorimetry;
+    gst_logo_playlist_reset (playlist);
+  }
+  g_mutex_unlock (&playlist->lock);
+}
+
+/**
+ * @brief Forgets the logo shown last when the stream stops.
+ *
+ * The next stream waits for its first logo again.
+ *
+ * @param playlist The playlist.
+ */
+void
+gst_logo_playlist_stop (GstLogoPlaylist * playlist)
+{
+  g_mutex_lock (&playlist->lock);
+  gst_logo_image_unref (playlist->last);
+  playlist->last = NULL;
+  g_mutex_unlock (&playlist->lock);
+}
+
+/* Binary search for the entry shown at @time within the cycle */
+static guint
+gst_logo_playlist_entry_at (GArray * entries, GstClockTime time)
+{
+  guint lo = 0, hi = entries->len - 1;
+
+  while (lo < hi) {
+    guint mid = (lo + hi + 1) / 2;
+
+    if (g_array_index (entries, GstLogoPlaylistEntry, mid).start <= time)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+/**
+ * @brief Gets the logos to show at a running time.
+ *
+ * Only the very first logo is waited for. If the current logo is not
+ * decoded yet, after a seek, a new playlist or a resolution change for
+ * example, the previous one stays on screen.
+ * The crossfade is skipped if the next logo was not prefetched in time.
+ *
+ * @param playlist The playlist.
+ * @param running_time Running time of the buffer.
+ * @param current Return location for the current logo, may be set to NULL
+ *     if it could not be loaded.
+ * @param next Return location for the logo faded in, or NULL.
+ * @param mix Return location for the opacity of @next, 0 to 255.
+ * @return FALSE if the playlist is empty. The logos are references that
+ *     are released with gst_logo_image_unref().
+ */
+gboolean
+gst_logo_playlist_get (GstLogoPlaylist * playlist, GstClockTime running_time,
+    GstLogoImage ** current, GstLogoImage ** next, guint * mix)
+{
+  const GstLogoPlaylistEntry *entry, *last;
+  GstLogoPlaylistSlot *slot;
+  GArray *entries;
+  GstClockTime time, offset, fade;
+  guint index, generation;
+
+  *current = *next = NULL;
+  *mix = 0;
+
+  g_mutex_lock (&playlist->lock);
+again:
+  entries = gst_logo_playlist_active (playlist);
+  if (entries == NULL || playlist->frame_height <= 0) {
+    g_mutex_unlock (&playlist->lock);
+    return entries != NULL;
+  }
+
+  last = &g_array_index (entries, GstLogoPlaylistEntry, entries->len - 1);
+  time = GST_CLOCK_TIME_IS_VALID (running_time) ? running_time : 0;
+  time %= last->start + last->duration;
+  index = gst_logo_playlist_entry_at (entries, time);
+  entry = &g_array_index (entries, GstLogoPlaylistEntry, index);
+  offset = time - entry->start;
+  if (index != playlist->want) {
+    playlist->want = index;
+    g_cond_broadcast (&playlist->cond);
+  }
+
+  /* A new playlist file may arrive while waiting */
+  generation = playlist->generation;
+  while (!playlist->quit && gst_logo_playlist_last (playlist) == NULL
+      && ((slot = gst_logo_playlist_find (playlist, index)) == NULL
+          || !slot->done)) {
+    g_cond_wait (&playlist->cond, &playlist->lock);
+    if (generation != playlist->generation)
+      goto again;
+  }
+
+  slot = gst_logo_playlist_find (playlist, index);
+  if (slot != NULL && slot->done && slot->image != NULL) {
+    *current = gst_logo_image_ref (slot->image);
+    if (slot->image != playlist->last) {
+      gst_logo_image_unref (playlist->last);
+      playlist->last = gst_logo_image_ref (slot->image);
+    }
+  } else if (gst_logo_playlist_last (playlist) != NULL) {
+    *current = gst_logo_image_ref (playlist->last);
+  }
+
+  /* Crossfade over the end of the entry */
+  fade = MIN (playlist->crossfade, entry->duration);
+  if (entries->len > 1 && fade > 0 && offset + fade > entry->duration) {
+    slot = gst_logo_playlist_find (playlist, (index + 1) % entries->len);
+    if (slot != NULL && slot->done && slot->image != NULL) {
+      *next = gst_logo_image_ref (slot->image);
+      *mix = gst_util_uint64_scale (offset + fade - entry->duration, 255,
+          fade);
+    }
+  }
+  g_mutex_unlock (&playlist->lock);
+
+  return TRUE;
+}
@@ -0,0 +1,222 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:gstlogoqos
+ *
+ * A degradation ladder for the logo animations. The element reports how
+ * long it took to render each frame together with the latest QoS event
+ * from downstream. While frames are late and the element takes a notable
+ * share of the frame duration, it steps down one rung at a time: first
+ * rotation and scaling are quantized so transformed sprites are reused,
+ * then the animation is frozen, then the logo is drawn from its cached
+ * sprite without any transformation. Once downstream keeps up again it
+ * steps back up, more slowly than it stepped down.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogoqos.h"
+#include <math.h>
+
+/* Minimum time between two steps down and two steps up */
+#define GST_LOGO_QOS_DEGRADE_HOLD (GST_SECOND)
+#define GST_LOGO_QOS_RECOVER_HOLD (3 * GST_SECOND)
+
+/* Frames are late, but degrading only helps if the element takes at least
+ * this fraction of the frame duration */
+#define GST_LOGO_QOS_SHARE 8
+
+/* Downstream keeps up with room to spare below this proportion */
+#define GST_LOGO_QOS_RELAXED 0.8
+
+/* Quantization of the coarse step */
+#define GST_LOGO_QOS_ANGLE_STEP 5.0
+#define GST_LOGO_QOS_SCALE_STEPS 20.0
+
+static const gchar *step_names[GST_LOGO_QOS_N_STEPS] = {
+  "full", "coarse", "frozen", "static"
+};
+
+/**
+ * @brief Goes back to full quality and forgets the measurements.
+ *
+ * @param qos The ladder.
+ */
+void
+gst_logo_qos_reset (GstLogoQos * qos)
+{
+  qos->step = GST_LOGO_QOS_FULL;
+  qos->changed = GST_CLOCK_TIME_NONE;
+  qos->frozen = GST_CLOCK_TIME_NONE;
+  qos->avg_process = 0;
+  qos->processed = 0;
+}
+
+/**
+ * @brief Accounts a rendered frame and moves along the ladder.
+ *
+ * Moves at most one step per call and holds every step for a while, so a
+ * single late frame does not drop the quality.
+ *
+ * @param qos The ladder.
+ * @param running_time Running time of the frame.
+ * @param frame_duration Duration of a frame, 0 if unknown.
+ * @param process_time Time the element took to render the frame.
+ * @param proportion Proportion of the latest QoS event, 1.0 without one.
+ * @param diff Lateness of the latest QoS event, 0 without one.
+ * @return TRUE if the step changed.
+ */
+gboolean
+gst_logo_qos_update (GstLogoQos * qos, GstClockTime running_time,
+    GstClockTime frame_duration, GstClockTime process_time,
+    gdouble proportion, GstClockTimeDiff diff)
+{
+  GstLogoQosStep step = qos->step;
+  gboolean late, overloaded, relaxed;
+
+  qos->processed++;
+  if (qos->avg_process == 0)
+    qos->avg_process = process_time;
+  else
+    qos->avg_process = (qos->avg_process * 7 + process_time) / 8;
+
+  if (!GST_CLOCK_TIME_IS_VALID (running_time))
+    return FALSE;
+  if (!GST_CLOCK_TIME_IS_VALID (qos->changed) || running_time < qos->changed)
+    qos->changed = running_time;
+
+  late = proportion > 1.0 || diff > 0;
+  if (frame_duration > 0) {
+    overloaded = qos->avg_process > frame_duration ||
+        (late && qos->avg_process * GST_LOGO_QOS_SHARE >= frame_duration);
+    relaxed = !late && proportion < GST_LOGO_QOS_RELAXED &&
+        qos->avg_process * 2 < frame_duration;
+  } else {
+    overloaded = late;
+    relaxed = !late && proportion < GST_LOGO_QOS_RELAXED;
+  }
+
+  if (overloaded && step < GST_LOGO_QOS_STATIC &&
+      running_time >= qos->changed + GST_LOGO_QOS_DEGRADE_HOLD)
+    step++;
+  else if (relaxed && step > GST_LOGO_QOS_FULL &&
+      running_time >= qos->changed + GST_LOGO_QOS_RECOVER_HOLD)
+    step--;
+
+  if (step == qos->step)
+    return FALSE;
+
+  if (step >= GST_LOGO_QOS_FROZEN && qos->step < GST_LOGO_QOS_FROZEN)
+    qos->frozen = running_time;
+  qos->step = step;
+  qos->changed = running_time;
+  return TRUE;
+}
+
+/**
+ * @brief Gives the time to evaluate the logo animation at.
+ *
+ * @param qos The ladder.
+ * @param running_time Running time of the frame.
+ * @return @running_time, or the time the animation was frozen at.
+ */
+GstClockTime
+gst_logo_qos_anim_time (const GstLogoQos * qos, GstClockTime running_time)
+{
+  if (qos->step >= GST_LOGO_QOS_FROZEN && GST_CLOCK_TIME_IS_VALID (qos->frozen))
+    return qos->frozen;
+  return running_time;
+}
+
+/**
+ * @brief Reduces the rotation and scale of the logo for the current step.
+ *
+ * @param qos The ladder.
+ * @param angle The rotation in degrees, changed in place.
+ * @param scale The scale factor, changed in place.
+ */
+void
+gst_logo_qos_quantize (const GstLogoQos * qos, gfloat * angle, gfloat * scale)
+{
+  switch (qos->step) {
+    case GST_LOGO_QOS_FULL:
+      break;
+    case GST_LOGO_QOS_STATIC:
+      *angle = 0;
+      *scale = 1;
+      break;
+    default:
+      *angle = roundf (*angle / GST_LOGO_QOS_ANGLE_STEP) *
+          GST_LOGO_QOS_ANGLE_STEP;
+      *scale = roundf (*scale * GST_LOGO_QOS_SCALE_STEPS) /
+          GST_LOGO_QOS_SCALE_STEPS;
+      break;
+  }
+}
+
+/**
+ * @brief Gives the name of a step for messages and logs.
+ */
+const gchar *
+gst_logo_qos_step_name (GstLogoQosStep step)
+{
+  return step < GST_LOGO_QOS_N_STEPS ? step_names[step] : "unknown";
+}
+
+/**
+ * @brief Gives the quality of the current step for QoS messages.
+ *
+ * @param qos The ladder.
+ * @return The quality, 1000000 at full quality down to 0 at the last step.
+ */
+guint
+gst_logo_qos_quality (const GstLogoQos * qos)
+{
+  return 1000000 * (GST_LOGO_QOS_N_STEPS - 1 - qos->step) /
+      (GST_LOGO_QOS_N_STEPS - 1);
+}
@@ -0,0 +1,106 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_QOS_H__
+#define __GST_LOGO_QOS_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GstLogoQosStep:
+ * @GST_LOGO_QOS_FULL: everything is rendered at full quality.
+ * @GST_LOGO_QOS_COARSE: rotation and scaling are quantized so transformed
+ *     sprites are reused over several frames.
+ * @GST_LOGO_QOS_FROZEN: the logo animation stops at its current state.
+ * @GST_LOGO_QOS_STATIC: the logo is drawn from its cached sprite without
+ *     any rotation or scaling.
+ *
+ * The steps of the degradation ladder, cheapest last.
+ */
+typedef enum
+{
+  GST_LOGO_QOS_FULL,
+  GST_LOGO_QOS_COARSE,
+  GST_LOGO_QOS_FROZEN,
+  GST_LOGO_QOS_STATIC,
+  GST_LOGO_QOS_N_STEPS
+} GstLogoQosStep;
+
+/**
+ * GstLogoQos:
+ * @step: the current step of the ladder.
+ * @changed: running time of the last step change.
+ * @frozen: running time the animation is frozen at.
+ * @avg_process: moving average of the processing time of a frame.
+ * @processed: number of frames rendered since the last reset.
+ *
+ * Tracks the processing time of the element against the lateness reported
+ * by QoS events and picks a step of the degradation ladder.
+ */
+typedef struct
+{
+  GstLogoQosStep step;
+  GstClockTime changed;
+  GstClockTime frozen;
+  GstClockTime avg_process;
+  guint64 processed;
+} GstLogoQos;
+
+void gst_logo_qos_reset (GstLogoQos * qos);
+gboolean gst_logo_qos_update (GstLogoQos * qos, GstClockTime running_time,
+    GstClockTime frame_duration, GstClockTime process_time,
+    gdouble proportion, GstClockTimeDiff diff);
+GstClockTime gst_logo_qos_anim_time (const GstLogoQos * qos,
+    GstClockTime running_time);
+void gst_logo_qos_quantize (const GstLogoQos * qos, gfloat * angle,
+    gfloat * scale);
+const gchar *gst_logo_qos_step_name (GstLogoQosStep step);
+guint gst_logo_qos_quality (const GstLogoQos * qos);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_QOS_H__ */
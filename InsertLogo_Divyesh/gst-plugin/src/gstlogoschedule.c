@@ -0,0 +1,256 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:gstlogoschedule
+ *
+ * Time windows in which the overlay is shown, either by running time or by
+ * local time of day. The schedule evaluates to an opacity per buffer, so
+ * the element can skip buffers outside every window without touching them
+ * and fade the overlay in and out at the window edges.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogoschedule.h"
+#include <stdio.h>
+#include <string.h>
+
+#define GST_LOGO_SCHEDULE_DAY (24 * 3600 * GST_SECOND)
+
+/* Reads a duration in seconds given as a double or an int, leaving
+ * @value untouched if the field is missing */
+static gboolean
+gst_logo_window_get_seconds (const GstStructure * s, const gchar * field,
+    GstClockTime * value)
+{
+  gdouble seconds;
+  gint i;
+
+  if (!gst_structure_has_field (s, field))
+    return TRUE;
+  if (gst_structure_get_int (s, field, &i))
+    seconds = i;
+  else if (!gst_structure_get_double (s, field, &seconds))
+    return FALSE;
+  if (seconds < 0)
+    return FALSE;
+
+  *value = seconds * GST_SECOND;
+  return TRUE;
+}
+
+/* Parses a local time of day "HH:MM" or "HH:MM:SS" */
+static gboolean
+gst_logo_window_get_time_of_day (const GstStructure * s, const gchar * field,
+    GstClockTime * value)
+{
+  const gchar *str = gst_structure_get_string (s, field);
+  guint h, m, sec = 0;
+  gint n = 0, k = 0;
+
+  if (str == NULL || sscanf (str, "%u:%u%n", &h, &m, &n) != 2)
+    return FALSE;
+  if (str[n] == ':') {
+    if (sscanf (str + n, ":%u%n", &sec, &k) != 1)
+      return FALSE;
+    n += k;
+  }
+  if (str[n] != '\0')
+    return FALSE;
+  if (h > 23 || m > 59 || sec > 59)
+    return FALSE;
+
+  *value = ((h * 60 + m) * 60 + sec) * GST_SECOND;
+  return TRUE;
+}
+
+/**
+ * @brief Parses one window of the schedule.
+ *
+ * Running time windows take "start" and optionally "end" in seconds, wall
+ * clock windows take "from" and "to" as local times "HH:MM[:SS]" and may
+ * span midnight. Both take "fade-in" and "fade-out" in seconds, or "fade"
+ * for both. The structure name is free.
+ *
+ * @param s The window description.
+ * @param window Return location for the window.
+ * @return TRUE if @s was valid, FALSE with a warning otherwise.
+ */
+gboolean
+gst_logo_window_parse (const GstStructure * s, GstLogoWindow * window)
+{
+  const gchar *name = gst_structure_get_name (s);
+  GstClockTime fade = 0;
+
+  memset (window, 0, sizeof (GstLogoWindow));
+  window->end = GST_CLOCK_TIME_NONE;
+
+  if (gst_structure_has_field (s, "from") || gst_structure_has_field (s, "to")) {
+    window->wall_clock = TRUE;
+    if (gst_structure_has_field (s, "start")
+        || gst_structure_has_field (s, "end")
+        || !gst_logo_window_get_time_of_day (s, "from", &window->start)
+        || !gst_logo_window_get_time_of_day (s, "to", &window->end)) {
+      g_warning ("Invalid wall clock window '%s'. Expected from and to as HH:MM or HH:MM:SS.", name);
+      return FALSE;
+    }
+  } else if (!gst_structure_has_field (s, "start")
+      || !gst_logo_window_get_seconds (s, "start", &window->start)
+      || !gst_logo_window_get_seconds (s, "end", &window->end)
+      || window->end <= window->start) {
+    g_warning ("Invalid window '%s'. Expected start and an optional later end in seconds.", name);
+    return FALSE;
+  }
+
+  if (!gst_logo_window_get_seconds (s, "fade", &fade)) {
+    g_warning ("Invalid fade for window '%s'. Valid values are 0 seconds or more.", name);
+    return FALSE;
+  }
+  window->fade_in = window->fade_out = fade;
+  if (!gst_logo_window_get_seconds (s, "fade-in", &window->fade_in)
+      || !gst_logo_window_get_seconds (s, "fade-out", &window->fade_out)) {
+    g_warning ("Invalid fade for window '%s'. Valid values are 0 seconds or more.", name);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Checks whether the schedule needs the time of day.
+ */
+gboolean
+gst_logo_schedule_uses_wall_clock (const GArray * windows)
+{
+  guint i;
+
+  for (i = 0; windows != NULL && i < windows->len; i++) {
+    if (g_array_index (windows, GstLogoWindow, i).wall_clock)
+      return TRUE;
+  }
+  return FALSE;
+}
+
+/**
+ * @brief Gets the current local time of day.
+ */
+GstClockTime
+gst_logo_schedule_time_of_day (void)
+{
+  GDateTime *now = g_date_time_new_now_local ();
+  GstClockTime time;
+
+  time = (g_date_time_get_hour (now) * 3600 +
+      g_date_time_get_minute (now) * 60 +
+      g_date_time_get_second (now)) * GST_SECOND +
+      g_date_time_get_microsecond (now) * GST_USECOND;
+  g_date_time_unref (now);
+
+  return time;
+}
+
+/* Opacity of one window, 0 outside of it */
+static guint
+gst_logo_window_eval (const GstLogoWindow * window, GstClockTime time)
+{
+  GstClockTime in, out;
+  guint level = 255;
+
+  if (!GST_CLOCK_TIME_IS_VALID (time))
+    return 0;
+
+  if (window->wall_clock) {
+    GstClockTime length;
+
+    /* Equal times are a window of a whole day */
+    length = (window->end + GST_LOGO_SCHEDULE_DAY - window->start) %
+        GST_LOGO_SCHEDULE_DAY;
+    if (length == 0)
+      length = GST_LOGO_SCHEDULE_DAY;
+    in = (time + GST_LOGO_SCHEDULE_DAY - window->start) % GST_LOGO_SCHEDULE_DAY;
+    if (in >= length)
+      return 0;
+    out = length - in;
+  } else {
+    if (time < window->start || time >= window->end)
+      return 0;
+    in = time - window->start;
+    out = GST_CLOCK_TIME_IS_VALID (window->end) ? window->end - time :
+        GST_CLOCK_TIME_NONE;
+  }
+
+  if (in < window->fade_in)
+    level = gst_util_uint64_scale (in, 255, window->fade_in);
+  if (out < window->fade_out)
+    level = MIN (level, gst_util_uint64_scale (out, 255, window->fade_out));
+  return level;
+}
+
+/**
+ * @brief Evaluates the schedule at a point in time.
+ *
+ * @param windows The #GstLogoWindow array.
+ * @param running_time Running time of the buffer.
+ * @param time_of_day Local time of day, only used by wall clock windows.
+ * @return The opacity of the overlay, 0 to 255. Overlapping windows take
+ *     the highest.
+ */
+guint
+gst_logo_schedule_eval (const GArray * windows, GstClockTime running_time,
+    GstClockTime time_of_day)
+{
+  guint i, level = 0;
+
+  for (i = 0; i < windows->len && level < 255; i++) {
+    const GstLogoWindow *window = &g_array_index (windows, GstLogoWindow, i);
+
+    level = MAX (level, gst_logo_window_eval (window,
+            window->wall_clock ? time_of_day : running_time));
+  }
+  return level;
+}
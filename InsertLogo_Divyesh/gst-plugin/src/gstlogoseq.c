@@ -0,0 +1,1115 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:gstlogoseq
+ *
+ * Animated logos, either an APNG file or a numbered PNG sequence given as a
+ * printf style pattern such as "logo_%03d.png". Frames are decoded ahead of
+ * time by a worker thread into a ring of prepared #GstLogoImage entries and
+ * the streaming thread only picks the entry for the running time of the
+ * buffer. If the whole animation fits into the memory budget every frame is
+ * decoded once and kept, otherwise the ring holds a window of the upcoming
+ * frames that the worker keeps refilling while the animation plays.
+ *
+ * APNG frames are stored as zlib streams in fdAT chunks which cairo cannot
+ * read on its own, so every frame is rewrapped into a standalone PNG in
+ * memory, decoded with cairo and composited onto a canvas according to its
+ * dispose and blend operations.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogoseq.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Patterns are probed for at most this many files */
+#define GST_LOGO_SEQ_MAX_FILES 100000
+
+/* Rough number of bytes a prepared image takes per pixel: the ARGB surface
+ * plus the luma and chroma planes of the sprite with their alpha, and a
+ * third of that for the mip levels */
+#define GST_LOGO_SEQ_BYTES_PER_PIXEL 8
+
+/* APNG dispose and blend operations, see the fcTL chunk */
+enum
+{
+  GST_LOGO_SEQ_DISPOSE_NONE,
+  GST_LOGO_SEQ_DISPOSE_BACKGROUND,
+  GST_LOGO_SEQ_DISPOSE_PREVIOUS
+};
+
+enum
+{
+  GST_LOGO_SEQ_BLEND_SOURCE,
+  GST_LOGO_SEQ_BLEND_OVER
+};
+
+/* One frame of the animation. The region and operations are only used for
+ * APNG, @data is the offset of its first IDAT or fdAT chunk in the file. */
+typedef struct
+{
+  GstClockTime start;
+  gint x, y, width, height;
+  guint8 dispose;
+  guint8 blend;
+  gsize data;
+} GstLogoSeqFrame;
+
+/* A parsed animation, shared between the element and the worker thread
+ * and never modified once created */
+typedef struct
+{
+  gint ref_count;
+  /* PNG sequence */
+  gchar *prefix;
+  gchar *suffix;
+  gint digits;
+  gint first_index;
+  /* APNG */
+  GMappedFile *file;
+  guint8 ihdr[13];
+  GByteArray *header;
+  guint num_plays;
+
+  gint width, height;
+  GArray *frames;
+  GstClockTime duration;
+} GstLogoSeqSource;
+
+/* One entry of the frame ring. @done is set once the worker has finished
+ * @frame, @image stays NULL if it could not be decoded. */
+typedef struct
+{
+  gint frame;
+  gboolean done;
+  GstLogoImage *image;
+} GstLogoSeqSlot;
+
+struct _GstLogoSequence
+{
+  GMutex lock;
+  GCond cond;
+  GThread *thread;
+
+  /* protected by lock */
+  gboolean quit;
+  gchar *location;
+  gdouble fps;
+  guint64 max_bytes;
+  GstLogoScale scale;
+  GstLogoEffects effects;
+  GstLogoSeqSource *source;
+  gint frame_width;
+  gint frame_height;
+  GstVideoFormat format;
+  GstVideoColorimetry colorimetry;
+  guint generation;
+  GstLogoSeqSlot *ring;
+  guint ring_size;
+  guint want;
+  GstLogoImage *last;
+
+  /* only touched by the worker thread */
+  GstLogoSeqSource *canvas_source;
+  cairo_surface_t *canvas;
+  cairo_surface_t *saved;
+  guint next;
+  guint8 pending_dispose;
+  cairo_rectangle_int_t pending_rect;
+};
+
+static guint32 gst_logo_seq_crc_table[256];
+
+static guint32
+gst_logo_seq_read_be32 (const guint8 * data)
+{
+  return ((guint32) data[0] << 24) | ((guint32) data[1] << 16) |
+      ((guint32) data[2] << 8) | data[3];
+}
+
+static void
+gst_logo_seq_write_be32 (guint8 * data, guint32 value)
+{
+  data[0] = value >> 24;
+  data[1] = value >> 16;
+  data[2] = value >> 8;
+  data[3] = value;
+}
+
+static gpointer
+gst_logo_seq_crc_init (gpointer data)
+{
+  guint32 c;
+  gint n, k;
+
+  for (n = 0; n < 256; n++) {
+    c = n;
+    for (k = 0; k < 8; k++)
+      c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+    gst_logo_seq_crc_table[n] = c;
+  }
+  return NULL;
+}
+
+static guint32
+gst_logo_seq_crc_update (guint32 crc, const guint8 * data, gsize len)
+{
+  gsize i;
+
+  for (i = 0; i < len; i++)
+    crc = gst_logo_seq_crc_table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+  return crc;
+}
+
+/* Appends a chunk with its length and CRC to @png */
+static void
+gst_logo_seq_put_chunk (GByteArray * png, const gchar * type,
+    const guint8 * data, guint32 len)
+{
+  guint8 be[4];
+  guint32 crc;
+
+  gst_logo_seq_write_be32 (be, len);
+  g_byte_array_append (png, be, 4);
+  g_byte_array_append (png, (const guint8 *) type, 4);
+  if (len > 0)
+    g_byte_array_append (png, data, len);
+
+  crc = gst_logo_seq_crc_update (0xffffffff, (const guint8 *) type, 4);
+  crc = gst_logo_seq_crc_update (crc, data, len) ^ 0xffffffff;
+  gst_logo_seq_write_be32 (be, crc);
+  g_byte_array_append (png, be, 4);
+}
+
+/**
+ * @brief Splits a printf style pattern around its only %d conversion.
+ *
+ * Only "%d" and zero padded "%0Nd" are accepted, the pattern is never
+ * handed to printf itself.
+ */
+static gboolean
+gst_logo_seq_split_pattern (const gchar * location, gchar ** prefix,
+    gint * digits, gchar ** suffix)
+{
+  const gchar *p, *conv;
+  gint width = 0;
+
+  if (location == NULL || (conv = strchr (location, '%')) == NULL)
+    return FALSE;
+
+  p = conv + 1;
+  if (*p == '0') {
+    while (g_ascii_isdigit (*p))
+      width = width * 10 + (*p++ - '0');
+  }
+  if (*p != 'd' || width > 9 || strchr (p, '%') != NULL)
+    return FALSE;
+
+  if (prefix)
+    *prefix = g_strndup (location, conv - location);
+  if (digits)
+    *digits = width;
+  if (suffix)
+    *suffix = g_strdup (p + 1);
+  return TRUE;
+}
+
+static gchar *
+gst_logo_seq_source_file (const GstLogoSeqSource * src, gint index)
+{
+  return g_strdup_printf ("%s%0*d%s", src->prefix, src->digits, index,
+      src->suffix);
+}
+
+/**
+ * @brief Checks whether a logo location is a numbered PNG sequence.
+ *
+ * @param location The logo-file property value.
+ * @return TRUE if @location contains a single %d or %0Nd conversion.
+ */
+gboolean
+gst_logo_sequence_is_pattern (const gchar * location)
+{
+  return gst_logo_seq_split_pattern (location, NULL, NULL, NULL);
+}
+
+/**
+ * @brief Gets the first existing file of a numbered PNG sequence.
+ *
+ * Sequences may start at index 0 or 1.
+ *
+ * @param location The logo-file property value.
+ * @return The path of the first file, @location itself if it is not a
+ *     pattern, or NULL if no file of the sequence exists. Free with g_free().
+ */
+gchar *
+gst_logo_sequence_first_file (const gchar * location)
+{
+  GstLogoSeqSource src = { 0, };
+  gchar *path = NULL;
+  gint i;
+
+  if (!gst_logo_seq_split_pattern (location, &src.prefix, &src.digits,
+          &src.suffix))
+    return g_strdup (location);
+
+  for (i = 0; i <= 1 && path == NULL; i++) {
+    path = gst_logo_seq_source_file (&src, i);
+    if (!g_file_test (path, G_FILE_TEST_IS_REGULAR)) {
+      g_free (path);
+      path = NULL;
+    }
+  }
+
+  g_free (src.prefix);
+  g_free (src.suffix);
+  return path;
+}
+
+static void
+gst_logo_seq_source_unref (GstLogoSeqSource * src)
+{
+  if (src == NULL || !g_atomic_int_dec_and_test (&src->ref_count))
+    return;
+
+  g_free (src->prefix);
+  g_free (src->suffix);
+  if (src->file)
+    g_mapped_file_unref (src->file);
+  if (src->header)
+    g_byte_array_unref (src->header);
+  g_array_unref (src->frames);
+  g_free (src);
+}
+
+static GstLogoSeqSource *
+gst_logo_seq_source_ref (GstLogoSeqSource * src)
+{
+  g_atomic_int_inc (&src->ref_count);
+  return src;
+}
+
+/* Reads the image size from the IHDR chunk without decoding the file */
+static gboolean
+gst_logo_seq_read_size (const gchar * path, gint * width, gint * height)
+{
+  guint8 head[24];
+  gboolean ret;
+  FILE *fp;
+
+  fp = fopen (path, "rb");
+  if (fp == NULL)
+    return FALSE;
+  ret = fread (head, 1, sizeof (head), fp) == sizeof (head)
+      && memcmp (head + 12, "IHDR", 4) == 0;
+  fclose (fp);
+
+  if (ret) {
+    *width = gst_logo_seq_read_be32 (head + 16);
+    *height = gst_logo_seq_read_be32 (head + 20);
+    ret = *width > 0 && *width <= G_MAXINT16 && *height > 0
+        && *height <= G_MAXINT16;
+  }
+  return ret;
+}
+
+/**
+ * @brief Indexes a numbered PNG sequence, every file is shown for 1/fps.
+ */
+static GstLogoSeqSource *
+gst_logo_seq_source_new_pattern (const gchar * location, gdouble fps)
+{
+  GstLogoSeqSource *src;
+  GstLogoSeqFrame frame = { 0, };
+  GstClockTime step;
+  gchar *path;
+  gint i;
+
+  src = g_new0 (GstLogoSeqSource, 1);
+  src->ref_count = 1;
+  src->frames = g_array_new (FALSE, TRUE, sizeof (GstLogoSeqFrame));
+  gst_logo_seq_split_pattern (location, &src->prefix, &src->digits,
+      &src->suffix);
+
+  /* Sequences may start at index 0 or 1 */
+  for (i = 0, path = NULL; i <= 1 && path == NULL; i++) {
+    path = gst_logo_seq_source_file (src, i);
+    src->first_index = i;
+    if (!g_file_test (path, G_FILE_TEST_IS_REGULAR)) {
+      g_free (path);
+      path = NULL;
+    }
+  }
+  if (path == NULL || !gst_logo_seq_read_size (path, &src->width,
+          &src->height)) {
+    g_free (path);
+    gst_logo_seq_source_unref (src);
+    return NULL;
+  }
+  g_free (path);
+
+  step = (GstClockTime) (GST_SECOND / fps);
+  for (i = src->first_index; i < GST_LOGO_SEQ_MAX_FILES; i++) {
+    path = gst_logo_seq_source_file (src, i);
+    if (!g_file_test (path, G_FILE_TEST_IS_REGULAR)) {
+      g_free (path);
+      break;
+    }
+    g_free (path);
+    frame.start = src->duration;
+    g_array_append_val (src->frames, frame);
+    src->duration += step;
+  }
+
+  return src;
+}
+
+/**
+ * @brief Indexes the frames of an APNG file.
+ *
+ * Only the chunk layout is parsed here, the frame data is decoded on
+ * demand by the worker thread.
+ *
+ * @return The animation, or NULL if @location is not an animated PNG.
+ */
+static GstLogoSeqSource *
+gst_logo_seq_source_new_apng (const gchar * location, gdouble fps)
+{
+  static const guint8 signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+  GstLogoSeqSource *src;
+  GstLogoSeqFrame *frame = NULL;
+  GMappedFile *file;
+  const guint8 *data;
+  gboolean animated = FALSE, have_ihdr = FALSE, in_data = FALSE;
+  gsize size, pos;
+
+  file = g_mapped_file_new (location, FALSE, NULL);
+  if (file == NULL)
+    return NULL;
+  data = (const guint8 *) g_mapped_file_get_contents (file);
+  size = g_mapped_file_get_length (file);
+  if (size < 8 || memcmp (data, signature, 8) != 0) {
+    g_mapped_file_unref (file);
+    return NULL;
+  }
+
+  src = g_new0 (GstLogoSeqSource, 1);
+  src->ref_count = 1;
+  src->file = file;
+  src->header = g_byte_array_new ();
+  src->frames = g_array_new (FALSE, TRUE, sizeof (GstLogoSeqFrame));
+
+  for (pos = 8; pos + 12 <= size;) {
+    guint32 len = gst_logo_seq_read_be32 (data + pos);
+    const guint8 *type = data + pos + 4;
+    const guint8 *body = data + pos + 8;
+    gboolean is_data;
+
+    if (len > size - pos - 12)
+      break;
+    is_data = memcmp (type, "IDAT", 4) == 0 || memcmp (type, "fdAT", 4) == 0;
+
+    if (memcmp (type, "IHDR", 4) == 0 && len == 13) {
+      memcpy (src->ihdr, body, 13);
+      src->width = gst_logo_seq_read_be32 (body);
+      src->height = gst_logo_seq_read_be32 (body + 4);
+      have_ihdr = TRUE;
+    } else if (memcmp (type, "acTL", 4) == 0 && len == 8) {
+      animated = TRUE;
+      src->num_plays = gst_logo_seq_read_be32 (body + 4);
+    } else if (memcmp (type, "fcTL", 4) == 0 && len == 26) {
+      guint delay_num = (body[20] << 8) | body[21];
+      guint delay_den = (body[22] << 8) | body[23];
+
+      g_array_set_size (src->frames, src->frames->len + 1);
+      frame = &g_array_index (src->frames, GstLogoSeqFrame,
+          src->frames->len - 1);
+      frame->start = src->duration;
+      frame->width = gst_logo_seq_read_be32 (body + 4);
+      frame->height = gst_logo_seq_read_be32 (body + 8);
+      frame->x = gst_logo_seq_read_be32 (body + 12);
+      frame->y = gst_logo_seq_read_be32 (body + 16);
+      frame->dispose = body[24];
+      frame->blend = body[25];
+
+      /* A zero delay means as fast as possible, which is one video frame */
+      if (delay_den == 0)
+        delay_den = 100;
+      if (delay_num == 0)
+        src->duration += (GstClockTime) (GST_SECOND / fps);
+      else
+        src->duration += gst_util_uint64_scale_int (GST_SECOND, delay_num,
+            delay_den);
+
+      if (frame->width <= 0 || frame->height <= 0 || frame->x < 0
+          || frame->y < 0 || frame->x > src->width
+          || frame->width > src->width - frame->x
+          || frame->y > src->height
+          || frame->height > src->height - frame->y
+          || frame->dispose > GST_LOGO_SEQ_DISPOSE_PREVIOUS
+          || frame->blend > GST_LOGO_SEQ_BLEND_OVER)
+        break;
+    } else if (memcmp (type, "IEND", 4) == 0) {
+      break;
+    } else if (!is_data && !in_data && frame == NULL) {
+      /* Palette, transparency and colour chunks apply to every frame */
+      g_byte_array_append (src->header, data + pos, len + 12);
+    }
+
+    if (is_data) {
+      /* IDAT is only part of the animation if an fcTL came before it */
+      if (frame != NULL && frame->data == 0)
+        frame->data = pos;
+      in_data = TRUE;
+    }
+
+    pos += len + 12;
+  }
+
+  /* Frames without data are dropped, an animation needs at least two */
+  while (src->frames->len > 0 && g_array_index (src->frames,
+          GstLogoSeqFrame, src->frames->len - 1).data == 0)
+    g_array_set_size (src->frames, src->frames->len - 1);
+
+  if (!animated || !have_ihdr || src->frames->len < 2 || src->width <= 0
+      || src->height <= 0 || src->width > G_MAXINT16
+      || src->height > G_MAXINT16) {
+    gst_logo_seq_source_unref (src);
+    return NULL;
+  }
+
+  return src;
+}
+
+/* Reads a PNG from memory for cairo */
+typedef struct
+{
+  const guint8 *data;
+  gsize size;
+  gsize pos;
+} GstLogoSeqReader;
+
+static cairo_status_t
+gst_logo_seq_read_func (void *closure, unsigned char *data,
+    unsigned int length)
+{
+  GstLogoSeqReader *reader = closure;
+
+  if (length > reader->size - reader->pos)
+    return CAIRO_STATUS_READ_ERROR;
+  memcpy (data, reader->data + reader->pos, length);
+  reader->pos += length;
+  return CAIRO_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Decodes the region of one APNG frame as a standalone PNG.
+ */
+static cairo_surface_t *
+gst_logo_seq_source_decode (const GstLogoSeqSource * src,
+    const GstLogoSeqFrame * frame)
+{
+  static const guint8 signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+  const guint8 *data;
+  cairo_surface_t *surface;
+  GstLogoSeqReader reader;
+  GByteArray *png;
+  guint8 ihdr[13];
+  gsize size, pos;
+
+  data = (const guint8 *) g_mapped_file_get_contents (src->file);
+  size = g_mapped_file_get_length (src->file);
+
+  png = g_byte_array_new ();
+  g_byte_array_append (png, signature, 8);
+  memcpy (ihdr, src->ihdr, 13);
+  gst_logo_seq_write_be32 (ihdr, frame->width);
+  gst_logo_seq_write_be32 (ihdr + 4, frame->height);
+  gst_logo_seq_put_chunk (png, "IHDR", ihdr, 13);
+  g_byte_array_append (png, src->header->data, src->header->len);
+
+  /* fdAT is IDAT with a sequence number in front of the data */
+  for (pos = frame->data; pos + 12 <= size;) {
+    guint32 len = gst_logo_seq_read_be32 (data + pos);
+    const guint8 *type = data + pos + 4;
+
+    /* A truncated file may claim more data than it holds */
+    if (len > size - pos - 12)
+      break;
+    if (memcmp (type, "IDAT", 4) == 0)
+      gst_logo_seq_put_chunk (png, "IDAT", data + pos + 8, len);
+    else if (memcmp (type, "fdAT", 4) == 0 && len >= 4)
+      gst_logo_seq_put_chunk (png, "IDAT", data + pos + 12, len - 4);
+    else
+      break;
+    pos += len + 12;
+  }
+  gst_logo_seq_put_chunk (png, "IEND", NULL, 0);
+
+  reader.data = png->data;
+  reader.size = png->len;
+  reader.pos = 0;
+  surface = cairo_image_surface_create_from_png_stream (gst_logo_seq_read_func,
+      &reader);
+  g_byte_array_unref (png);
+
+  if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS) {
+    cairo_surface_destroy (surface);
+    return NULL;
+  }
+  return surface;
+}
+
+static cairo_surface_t *
+gst_logo_seq_copy_surface (cairo_surface_t * source)
+{
+  cairo_surface_t *copy;
+  cairo_t *cr;
+
+  copy = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+      cairo_image_surface_get_width (source),
+      cairo_image_surface_get_height (source));
+  cr = cairo_create (copy);
+  cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+  cairo_set_source_surface (cr, source, 0, 0);
+  cairo_paint (cr);
+  cairo_destroy (cr);
+
+  return copy;
+}
+
+/**
+ * @brief Composites the next APNG frame onto the canvas.
+ *
+ * The dispose operation of a frame is applied before the following frame
+ * is drawn, so the canvas always shows the frame that was composited last.
+ */
+static void
+gst_logo_sequence_composite (GstLogoSequence * seq, const GstLogoSeqSource * src,
+    guint index)
+{
+  const GstLogoSeqFrame *frame;
+  cairo_surface_t *image;
+  cairo_t *cr;
+
+  frame = &g_array_index (src->frames, GstLogoSeqFrame, index);
+
+  cr = cairo_create (seq->canvas);
+  if (seq->pending_dispose == GST_LOGO_SEQ_DISPOSE_BACKGROUND) {
+    cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+    cairo_rectangle (cr, seq->pending_rect.x, seq->pending_rect.y,
+        seq->pending_rect.width, seq->pending_rect.height);
+    cairo_fill (cr);
+  } else if (seq->pending_dispose == GST_LOGO_SEQ_DISPOSE_PREVIOUS
+      && seq->saved != NULL) {
+    cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+    cairo_set_source_surface (cr, seq->saved, 0, 0);
+    cairo_paint (cr);
+  }
+  cairo_destroy (cr);
+
+  if (seq->saved) {
+    cairo_surface_destroy (seq->saved);
+    seq->saved = NULL;
+  }
+  seq->pending_dispose = frame->dispose;
+  seq->pending_rect.x = frame->x;
+  seq->pending_rect.y = frame->y;
+  seq->pending_rect.width = frame->width;
+  seq->pending_rect.height = frame->height;
+  /* The first frame has nothing to go back to */
+  if (frame->dispose == GST_LOGO_SEQ_DISPOSE_PREVIOUS) {
+    if (index == 0)
+      seq->pending_dispose = GST_LOGO_SEQ_DISPOSE_BACKGROUND;
+    else
+      seq->saved = gst_logo_seq_copy_surface (seq->canvas);
+  }
+
+  image = gst_logo_seq_source_decode (src, frame);
+  if (image == NULL)
+    return;
+
+  cr = cairo_create (seq->canvas);
+  cairo_rectangle (cr, frame->x, frame->y, frame->width, frame->height);
+  cairo_clip (cr);
+  if (frame->blend == GST_LOGO_SEQ_BLEND_SOURCE)
+    cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+  cairo_set_source_surface (cr, image, frame->x, frame->y);
+  cairo_paint (cr);
+  cairo_destroy (cr);
+  cairo_surface_destroy (image);
+}
+
+/**
+ * @brief Renders one frame of the animation, runs on the worker thread.
+ *
+ * APNG frames depend on the frames before them, so the canvas is moved
+ * forward from the last rendered frame and restarted from the first frame
+ * when the animation wraps around.
+ *
+ * @return A new surface that is not touched afterwards, or NULL.
+ */
+static cairo_surface_t *
+gst_logo_sequence_render (GstLogoSequence * seq, GstLogoSeqSource * src,
+    guint index)
+{
+  if (src->file == NULL) {
+    cairo_surface_t *surface;
+    gchar *path;
+
+    path = gst_logo_seq_source_file (src, src->first_index + index);
+    surface = cairo_image_surface_create_from_png (path);
+    g_free (path);
+    if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS) {
+      cairo_surface_destroy (surface);
+      return NULL;
+    }
+    return surface;
+  }
+
+  if (seq->canvas_source != src || index < seq->next) {
+    if (seq->canvas_source != src) {
+      gst_logo_seq_source_unref (seq->canvas_source);
+      seq->canvas_source = gst_logo_seq_source_ref (src);
+    }
+    if (seq->canvas)
+      cairo_surface_destroy (seq->canvas);
+    if (seq->saved)
+      cairo_surface_destroy (seq->saved);
+    seq->canvas = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+        src->width, src->height);
+    seq->saved = NULL;
+    seq->pending_dispose = GST_LOGO_SEQ_DISPOSE_NONE;
+    seq->next = 0;
+  }
+
+  for (; seq->next <= index; seq->next++)
+    gst_logo_sequence_composite (seq, src, seq->next);
+
+  return gst_logo_seq_copy_surface (seq->canvas);
+}
+
+/* Must be called with the lock held. Whether @frame is one of the frames
+ * the ring should hold, counted from the wanted frame with wrap-around. */
+static gboolean
+gst_logo_sequence_in_window (GstLogoSequence * seq, gint frame)
+{
+  guint n = seq->source->frames->len;
+
+  return frame >= 0 && (frame + n - seq->want) % n < seq->ring_size;
+}
+
+/* Must be called with the lock held */
+static GstLogoSeqSlot *
+gst_logo_sequence_find (GstLogoSequence * seq, gint frame)
+{
+  guint i;
+
+  for (i = 0; i < seq->ring_size; i++) {
+    if (seq->ring[i].frame == frame)
+      return &seq->ring[i];
+  }
+  return NULL;
+}
+
+/**
+ * @brief Picks the next frame to decode and the slot for it.
+ *
+ * Must be called with the lock held. Frames are decoded in playback order
+ * from the wanted frame, into slots whose frame fell out of the window.
+ *
+ * @return The slot, already claimed for the frame, or NULL if the ring is
+ *     complete.
+ */
+static GstLogoSeqSlot *
+gst_logo_sequence_next_job (GstLogoSequence * seq)
+{
+  GstLogoSeqSlot *slot = NULL;
+  guint n, i, k;
+  gint frame = -1;
+
+  if (seq->source == NULL || seq->ring == NULL)
+    return NULL;
+
+  n = seq->source->frames->len;
+  for (k = 0; k < seq->ring_size && frame < 0; k++) {
+    if (gst_logo_sequence_find (seq, (seq->want + k) % n) == NULL)
+      frame = (seq->want + k) % n;
+  }
+  if (frame < 0)
+    return NULL;
+
+  for (i = 0; i < seq->ring_size && slot == NULL; i++) {
+    if (!gst_logo_sequence_in_window (seq, seq->ring[i].frame))
+      slot = &seq->ring[i];
+  }
+  if (slot == NULL)
+    return NULL;
+
+  gst_logo_image_unref (slot->image);
+  slot->image = NULL;
+  slot->frame = frame;
+  slot->done = FALSE;
+  return slot;
+}
+
+/**
+ * @brief Worker thread function, keeps the ring filled ahead of playback.
+ */
+static gpointer
+gst_logo_sequence_worker (gpointer data)
+{
+  GstLogoSequence *seq = data;
+
+  g_mutex_lock (&seq->lock);
+  while (!seq->quit) {
+    GstLogoSeqSource *src;
+    GstLogoSeqSlot *slot;
+    GstLogoImage *image = NULL;
+    cairo_surface_t *surface;
+    GstLogoScale scale;
+    GstLogoEffects effects;
+    gint frame, frame_height;
+    GstVideoFormat format;
+    GstVideoColorimetry colorimetry;
+    guint generation;
+
+    slot = gst_logo_sequence_next_job (seq);
+    if (slot == NULL) {
+      g_cond_wait (&seq->cond, &seq->lock);
+      continue;
+    }
+    src = gst_logo_seq_source_ref (seq->source);
+    frame = slot->frame;
+    scale = seq->scale;
+    effects = seq->effects;
+    frame_height = seq->frame_height;
+    format = seq->format;
+    colorimetry = seq->colorimetry;
+    generation = seq->generation;
+    g_mutex_unlock (&seq->lock);
+
+    surface = gst_logo_sequence_render (seq, src, frame);
+    if (surface != NULL) {
+      image = gst_logo_image_new_from_surface (surface, &scale, &effects,
+          frame_height, format, &colorimetry);
+      cairo_surface_destroy (surface);
+    }
+    gst_logo_seq_source_unref (src);
+
+    g_mutex_lock (&seq->lock);
+    /* The slot array is only replaced together with the generation */
+    if (generation == seq->generation && slot->frame == frame && !slot->done) {
+      slot->image = image;
+      slot->done = TRUE;
+      image = NULL;
+    }
+    g_cond_broadcast (&seq->cond);
+    g_mutex_unlock (&seq->lock);
+
+    gst_logo_image_unref (image);
+    g_mutex_lock (&seq->lock);
+  }
+  g_mutex_unlock (&seq->lock);
+
+  return NULL;
+}
+
+/* Must be called with the lock held. Drops all decoded frames and sizes
+ * the ring for the memory budget at the current resolution. */
+static void
+gst_logo_sequence_reset_ring (GstLogoSequence * seq)
+{
+  guint i, n;
+  guint64 bytes;
+  gint width, height;
+
+  for (i = 0; i < seq->ring_size; i++)
+    gst_logo_image_unref (seq->ring[i].image);
+  g_free (seq->ring);
+  seq->ring = NULL;
+  seq->ring_size = 0;
+  seq->want = 0;
+  gst_logo_image_unref (seq->last);
+  seq->last = NULL;
+  seq->generation++;
+
+  if (seq->source == NULL || seq->frame_height <= 0)
+    return;
+
+  gst_logo_scale_get_size (&seq->scale, seq->source->width,
+      seq->source->height, seq->frame_height, &width, &height);
+  bytes = (guint64) width * height * GST_LOGO_SEQ_BYTES_PER_PIXEL;
+  if (seq->effects.contrast_variant)
+    bytes *= 2;
+  n = seq->source->frames->len;
+  seq->ring_size = CLAMP (seq->max_bytes / MAX (bytes, 1), MIN (2, n), n);
+  seq->ring = g_new0 (GstLogoSeqSlot, seq->ring_size);
+  for (i = 0; i < seq->ring_size; i++)
+    seq->ring[i].frame = -1;
+}
+
+/**
+ * @brief Creates an empty animation player with its own worker thread.
+ */
+GstLogoSequence *
+gst_logo_sequence_new (void)
+{
+  static GOnce crc_once = G_ONCE_INIT;
+  GstLogoSequence *seq = g_new0 (GstLogoSequence, 1);
+
+  g_once (&crc_once, gst_logo_seq_crc_init, NULL);
+  g_mutex_init (&seq->lock);
+  g_cond_init (&seq->cond);
+  seq->thread = g_thread_new ("logoseq", gst_logo_sequence_worker, seq);
+
+  return seq;
+}
+
+/**
+ * @brief Stops the worker and frees the player with all decoded frames.
+ */
+void
+gst_logo_sequence_free (GstLogoSequence * seq)
+{
+  if (seq == NULL)
+    return;
+
+  g_mutex_lock (&seq->lock);
+  seq->quit = TRUE;
+  g_cond_broadcast (&seq->cond);
+  g_mutex_unlock (&seq->lock);
+  g_thread_join (seq->thread);
+
+  gst_logo_seq_source_unref (seq->source);
+  seq->source = NULL;
+  gst_logo_sequence_reset_ring (seq);
+  gst_logo_seq_source_unref (seq->canvas_source);
+  if (seq->canvas)
+    cairo_surface_destroy (seq->canvas);
+  if (seq->saved)
+    cairo_surface_destroy (seq->saved);
+  g_free (seq->location);
+  g_mutex_clear (&seq->lock);
+  g_cond_clear (&seq->cond);
+  g_free (seq);
+}
+
+/**
+ * @brief Sets the animated logo and how it is decoded.
+ *
+ * Drops all decoded frames if anything changed. The file is only indexed
+ * here, decoding starts once the resolution is known.
+ *
+ * @param seq The animation player.
+ * @param location An APNG file or a numbered PNG sequence pattern.
+ * @param fps Frame rate of PNG sequences and of APNG frames without delay.
+ * @param max_bytes Memory budget of the decoded frames.
+ * @param scale How the logo is sized per resolution.
+ * @param effects The effects drawn around every frame.
+ * @return TRUE if @location is an animated logo.
+ */
+gboolean
+gst_logo_sequence_set_source (GstLogoSequence * seq, const gchar * location,
+    gdouble fps, guint64 max_bytes, const GstLogoScale * scale,
+    const GstLogoEffects * effects)
+{
+  GstLogoSeqSource *src = NULL, *old = NULL;
+  gboolean reload, animated;
+
+  g_mutex_lock (&seq->lock);
+  reload = g_strcmp0 (location, seq->location) != 0 || fps != seq->fps;
+  if (!reload) {
+    if (max_bytes != seq->max_bytes
+        || !gst_logo_scale_is_equal (scale, &seq->scale)
+        || !gst_logo_effects_is_equal (effects, &seq->effects)) {
+      seq->max_bytes = max_bytes;
+      seq->scale = *scale;
+      seq->effects = *effects;
+      gst_logo_sequence_reset_ring (seq);
+      g_cond_broadcast (&seq->cond);
+    }
+    animated = seq->source != NULL;
+    g_mutex_unlock (&seq->lock);
+    return animated;
+  }
+  g_mutex_unlock (&seq->lock);
+
+  /* Index the file without holding the lock */
+  if (location != NULL && fps > 0) {
+    if (gst_logo_sequence_is_pattern (location))
+      src = gst_logo_seq_source_new_pattern (location, fps);
+    else
+      src = gst_logo_seq_source_new_apng (location, fps);
+  }
+
+  g_mutex_lock (&seq->lock);
+  g_free (seq->location);
+  seq->location = g_strdup (location);
+  seq->fps = fps;
+  seq->max_bytes = max_bytes;
+  seq->scale = *scale;
+  seq->effects = *effects;
+  old = seq->source;
+  seq->source = src;
+  gst_logo_sequence_reset_ring (seq);
+  g_cond_broadcast (&seq->cond);
+  g_mutex_unlock (&seq->lock);
+
+  gst_logo_seq_source_unref (old);
+  return src != NULL;
+}
+
+/**
+ * @brief Sets the negotiated resolution, format and colorimetry and starts
+ * decoding for them.
+ *
+ * @param seq The animation player.
+ * @param frame_width Negotiated frame width.
+ * @param frame_height Negotiated frame height.
+ * @param format Negotiated video format.
+ * @param colorimetry Negotiated colorimetry.
+ */
+void
+gst_logo_sequence_set_size (GstLogoSequence * seq, gint frame_width,
+    gint frame_height, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry)
+{
+  g_mutex_lock (&seq->lock);
+  if (frame_width != seq->frame_width || frame_height != seq->frame_height
+      || format != seq->format
+      || !gst_video_colorimetry_is_equal (colorimetry, &seq->colorimetry)) {
+    seq->frame_width = frame_width;
+    seq->frame_height = frame_height;
+    seq->format = format;
+    seq->colorimetry = *colorimetry;
+    gst_logo_sequence_reset_ring (seq);
+    g_cond_broadcast (&seq->cond);
+  }
+  g_mutex_unlock (&seq->lock);
+}
+
+/* Binary search for the frame shown at @time */
+static guint
+gst_logo_seq_source_frame_at (const GstLogoSeqSource * src,
+    GstClockTime running_time)
+{
+  guint lo = 0, hi = src->frames->len - 1;
+  GstClockTime time;
+
+  if (!GST_CLOCK_TIME_IS_VALID (running_time) || src->duration == 0)
+    return 0;
+  /* A limited number of plays stops on the last frame */
+  if (src->num_plays > 0 && running_time / src->duration >= src->num_plays)
+    return hi;
+
+  time = running_time % src->duration;
+  while (lo < hi) {
+    guint mid = (lo + hi + 1) / 2;
+
+    if (g_array_index (src->frames, GstLogoSeqFrame, mid).start <= time)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+/**
+ * @brief Gets the logo frame for a running time.
+ *
+ * Never waits for the worker once a frame was shown: if the wanted frame
+ * is not decoded yet the previous one is shown again, so a slow decoder
+ * drops logo frames instead of stalling the stream. Only the very first
+ * frame is waited for.
+ *
+ * @param seq The animation player.
+ * @param running_time Running time of the buffer.
+ * @return A reference to the image, or NULL if no frame could be decoded.
+ *     Release with gst_logo_image_unref().
+ */
+GstLogoImage *
+gst_logo_sequence_get (GstLogoSequence * seq, GstClockTime running_time)
+{
+  GstLogoSeqSlot *slot;
+  GstLogoImage *image = NULL;
+  guint frame;
+
+  g_mutex_lock (&seq->lock);
+  if (seq->source == NULL || seq->ring == NULL) {
+    g_mutex_unlock (&seq->lock);
+    return NULL;
+  }
+
+  frame = gst_logo_seq_source_frame_at (seq->source, running_time);
+  if (frame != seq->want) {
+    seq->want = frame;
+    g_cond_broadcast (&seq->cond);
+  }
+
+  /* The slot is looked up again after every wakeup since the ring may be
+   * replaced concurrently */
+  while (!seq->quit && seq->ring != NULL && seq->last == NULL
+      && ((slot = gst_logo_sequence_find (seq, frame)) == NULL || !slot->done))
+    g_cond_wait (&seq->cond, &seq->lock);
+
+  slot = seq->ring ? gst_logo_sequence_find (seq, frame) : NULL;
+  if (slot != NULL && slot->done && slot->image != NULL) {
+    image = gst_logo_image_ref (slot->image);
+    if (image != seq->last) {
+      gst_logo_image_unref (seq->last);
+      seq->last = gst_logo_image_ref (image);
+    }
+  } else if (seq->last != NULL) {
+    image = gst_logo_image_ref (seq->last);
+  }
+  g_mutex_unlock (&seq->lock);
+
+  return image;
+}
@@ -0,0 +1,1457 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:gstlogosprite
+ *
+ * A logo sprite is the decoded logo converted once to premultiplied YUVA or
+ * RGBA in the byte layout of the destination planes of the negotiated format. Every plane row carries a span
+ * index so blending skips transparent pixels, copies opaque runs and only
+ * does the arithmetic where the logo is actually translucent. A mip pyramid
+ * of halved copies lets a sprite be blended at any size, resampled row by
+ * row in the same pass.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogosprite.h"
+#include "gstlogocolor.h"
+#include <math.h>
+#include <string.h>
+
+/* Transparent gaps shorter than this are folded into the surrounding span,
+ * opaque runs shorter than this are blended instead of copied. Both keep
+ * the span lists short on anti-aliased edges. */
+#define GST_LOGO_SPAN_MIN_RUN 8
+
+/* Pixels and rows skipped between two samples when measuring a frame */
+#define GST_LOGO_SPRITE_MEASURE_STEP 4
+
+/* Exact x / 255 with rounding for 0 <= x <= 65535 */
+static inline guint
+gst_logo_div255 (guint x)
+{
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+/**
+ * @brief Adds the spans of one region of non-transparent samples.
+ *
+ * Opaque runs of at least GST_LOGO_SPAN_MIN_RUN samples become copy spans,
+ * everything in between is blended.
+ */
+static void
+gst_logo_sprite_push_region (GArray * spans, const guint8 * alpha,
+    guint start, guint end)
+{
+  GstLogoSpan span;
+  guint i = start, j, blend_start = start;
+
+  while (i < end) {
+    if (alpha[i] != 255) {
+      i++;
+      continue;
+    }
+    for (j = i; j < end && alpha[j] == 255; j++);
+    if (j - i >= GST_LOGO_SPAN_MIN_RUN) {
+      if (i > blend_start) {
+        span.start = blend_start;
+        span.len = i - blend_start;
+        span.kind = GST_LOGO_SPAN_BLEND;
+        g_array_append_val (spans, span);
+      }
+      span.start = i;
+      span.len = j - i;
+      span.kind = GST_LOGO_SPAN_OPAQUE;
+      g_array_append_val (spans, span);
+      blend_start = j;
+    }
+    i = j;
+  }
+
+  if (end > blend_start) {
+    span.start = blend_start;
+    span.len = end - blend_start;
+    span.kind = GST_LOGO_SPAN_BLEND;
+    g_array_append_val (spans, span);
+  }
+}
+
+/**
+ * @brief Adds the spans of the samples @x to @w of one row.
+ *
+ * @param spans Array of #GstLogoSpan to append to.
+ * @param alpha The coverage of the row.
+ * @param x First sample to index.
+ * @param w End of the samples to index.
+ */
+static void
+gst_logo_sprite_row_index (GArray * spans, const guint8 * alpha, guint x,
+    guint w)
+{
+  guint start, end, gap;
+
+  while (x < w) {
+    while (x < w && alpha[x] == 0)
+      x++;
+    if (x == w)
+      break;
+
+    /* Extend the region over short transparent gaps */
+    start = end = x;
+    while (end < w) {
+      if (alpha[end] != 0) {
+        end++;
+        continue;
+      }
+      for (gap = end; gap < w && alpha[gap] == 0; gap++);
+      if (gap == w || gap - end >= GST_LOGO_SPAN_MIN_RUN)
+        break;
+      end = gap;
+    }
+
+    gst_logo_sprite_push_region (spans, alpha, start, end);
+    x = end;
+  }
+}
+
+/**
+ * @brief Builds the span index of a sprite plane from its coverage.
+ *
+ * @param plane The plane whose @alpha is filled in.
+ */
+static void
+gst_logo_sprite_plane_index (GstLogoSpritePlane * plane)
+{
+  GArray *spans = g_array_new (FALSE, FALSE, sizeof (GstLogoSpan));
+  gint row;
+
+  plane->row_spans = g_new (guint, plane->height + 1);
+
+  for (row = 0; row < plane->height; row++) {
+    plane->row_spans[row] = spans->len;
+    gst_logo_sprite_row_index (spans,
+        plane->alpha + (gsize) row * plane->width, 0, plane->width);
+  }
+  plane->row_spans[plane->height] = spans->len;
+
+  plane->spans = (GstLogoSpan *) g_array_free (spans, FALSE);
+}
+
+/**
+ * @brief Allocates the pixel and alpha storage of a sprite plane.
+ */
+static void
+gst_logo_sprite_plane_alloc (GstLogoSpritePlane * plane, guint x_sub,
+    guint y_sub, guint pstride, guint bytes, guint shift, gint width,
+    gint height)
+{
+  plane->x_sub = x_sub;
+  plane->y_sub = y_sub;
+  plane->pstride = pstride;
+  plane->bytes = bytes;
+  plane->shift = shift;
+  plane->width = GST_VIDEO_SUB_SCALE (x_sub, width) * pstride;
+  plane->height = GST_VIDEO_SUB_SCALE (y_sub, height);
+  plane->pixels = g_malloc0 ((gsize) plane->width * plane->height * bytes);
+  plane->alpha = g_malloc0 ((gsize) plane->width * plane->height);
+}
+
+/**
+ * @brief Writes one component of the logo into its sprite plane.
+ *
+ * Every sample averages the premultiplied component and the coverage over
+ * its subsampling block, so a chroma sample is blended once with the
+ * weight of all the pixels it stands for. The sample goes to the place the
+ * component has in the frame, which interleaves Cb and Cr for semi-planar
+ * formats.
+ *
+ * Limited range values of @depth bits are the 8 bit values shifted left,
+ * so deeper samples are scaled before the rounding and keep the fraction
+ * the averaging gives. They are capped at the coverage of the sample so a
+ * blend can never overflow the range.
+ *
+ * @param plane The sprite plane holding the component.
+ * @param yuva The logo as premultiplied Y, Cb, Cr (or R, G, B) and coverage
+ *     per pixel.
+ * @param width Width of the logo.
+ * @param height Height of the logo.
+ * @param comp The component, 0 for Y, 1 for Cb, 2 for Cr and 3 for the
+ *     coverage itself.
+ * @param w_sub Horizontal subsampling of the component (log2).
+ * @param poffset Offset of the component in a unit of the plane, in samples.
+ * @param pstride Distance between two samples of the component.
+ * @param depth Bits of the component, 8 to 16.
+ */
+static void
+gst_logo_sprite_plane_fill (GstLogoSpritePlane * plane, const guint8 * yuva,
+    gint width, gint height, guint comp, guint w_sub, guint poffset,
+    guint pstride, guint depth)
+{
+  guint h_sub = plane->y_sub;
+  guint shift = w_sub + h_sub;
+  guint scale = depth - 8;
+  guint per_unit = plane->x_sub - w_sub;
+  gint samples = GST_VIDEO_SUB_SCALE (w_sub, width);
+  gint i, j, dx, dy;
+
+  for (j = 0; j < plane->height; j++) {
+    guint8 *pixels = plane->pixels + (gsize) j * plane->width * plane->bytes;
+    guint8 *alpha = plane->alpha + (gsize) j * plane->width;
+
+    for (i = 0; i < samples; i++) {
+      guint sum_v = 0, sum_a = 0, v;
+      gsize pos;
+
+      /* Pixels outside the logo count as transparent */
+      for (dy = 0; dy < (1 << h_sub) && (j << h_sub) + dy < height; dy++) {
+        const guint8 *px = yuva +
+            ((gsize) ((j << h_sub) + dy) * width + (i << w_sub)) * 4;
+
+        for (dx = 0; dx < (1 << w_sub) && (i << w_sub) + dx < width; dx++) {
+          sum_v += px[dx * 4 + comp];
+          sum_a += px[dx * 4 + 3];
+        }
+      }
+
+      pos = (gsize) (i >> per_unit) * plane->pstride + poffset
+          + (i & ((1 << per_unit) - 1)) * pstride;
+      alpha[pos] = (sum_a + ((1 << shift) >> 1)) >> shift;
+      v = ((sum_v << scale) + ((1 << shift) >> 1)) >> shift;
+      v = MIN (v, (guint) alpha[pos] << scale);
+      if (plane->bytes == 2)
+        ((guint16 *) pixels)[pos] = v << plane->shift;
+      else
+        pixels[pos] = v;
+    }
+  }
+}
+
+/**
+ * @brief Registers the #GstLogoBlendSpace enum type.
+ */
+GType
+gst_logo_blend_space_get_type (void)
+{
+  static gsize type = 0;
+  static const GEnumValue values[] = {
+    {GST_LOGO_BLEND_SPACE_GAMMA, "Blend the gamma encoded samples", "gamma"},
+    {GST_LOGO_BLEND_SPACE_LINEAR, "Blend luma and RGB in linear light",
+        "linear"},
+    {0, NULL, NULL}
+  };
+
+  if (g_once_init_enter (&type)) {
+    GType t = g_enum_register_static ("GstLogoBlendSpace", values);
+
+    g_once_init_leave (&type, t);
+  }
+  return type;
+}
+
+/**
+ * @brief Checks if sprites can be built for a video format.
+ *
+ * @param format A video format.
+ * @return TRUE if @format is one of GST_LOGO_SPRITE_FORMATS.
+ */
+gboolean
+gst_logo_sprite_supports_format (GstVideoFormat format)
+{
+  switch (format) {
+    case GST_VIDEO_FORMAT_NV12:
+    case GST_VIDEO_FORMAT_NV21:
+    case GST_VIDEO_FORMAT_I420:
+    case GST_VIDEO_FORMAT_YV12:
+    case GST_VIDEO_FORMAT_NV16:
+    case GST_VIDEO_FORMAT_NV61:
+    case GST_VIDEO_FORMAT_Y42B:
+    case GST_VIDEO_FORMAT_NV24:
+    case GST_VIDEO_FORMAT_Y444:
+    case GST_VIDEO_FORMAT_GRAY8:
+    case GST_VIDEO_FORMAT_YUY2:
+    case GST_VIDEO_FORMAT_UYVY:
+    case GST_VIDEO_FORMAT_YVYU:
+    case GST_VIDEO_FORMAT_RGBx:
+    case GST_VIDEO_FORMAT_BGRx:
+    case GST_VIDEO_FORMAT_xRGB:
+    case GST_VIDEO_FORMAT_xBGR:
+    case GST_VIDEO_FORMAT_RGBA:
+    case GST_VIDEO_FORMAT_BGRA:
+    case GST_VIDEO_FORMAT_ARGB:
+    case GST_VIDEO_FORMAT_ABGR:
+    case GST_VIDEO_FORMAT_RGB:
+    case GST_VIDEO_FORMAT_BGR:
+    case GST_VIDEO_FORMAT_NV12_4L4:
+    case GST_VIDEO_FORMAT_NV12_32L32:
+    case GST_VIDEO_FORMAT_NV12_64Z32:
+#if GST_CHECK_VERSION(1, 22, 0)
+    case GST_VIDEO_FORMAT_NV12_16L32S:
+#endif
+      return TRUE;
+    case GST_VIDEO_FORMAT_P010_10LE:
+    case GST_VIDEO_FORMAT_P010_10BE:
+    case GST_VIDEO_FORMAT_P012_LE:
+    case GST_VIDEO_FORMAT_P012_BE:
+    case GST_VIDEO_FORMAT_P016_LE:
+    case GST_VIDEO_FORMAT_P016_BE:
+    case GST_VIDEO_FORMAT_I420_10LE:
+    case GST_VIDEO_FORMAT_I420_10BE:
+    case GST_VIDEO_FORMAT_I420_12LE:
+    case GST_VIDEO_FORMAT_I420_12BE:
+    case GST_VIDEO_FORMAT_I422_10LE:
+    case GST_VIDEO_FORMAT_I422_10BE:
+    case GST_VIDEO_FORMAT_Y444_10LE:
+    case GST_VIDEO_FORMAT_Y444_10BE:
+    case GST_VIDEO_FORMAT_GRAY16_LE:
+    case GST_VIDEO_FORMAT_GRAY16_BE:
+      /* 16 bit samples are blended as native integers */
+      return GST_VIDEO_FORMAT_INFO_IS_LE (gst_video_format_get_info (format))
+          == (G_BYTE_ORDER == G_LITTLE_ENDIAN);
+    default:
+      return FALSE;
+  }
+}
+
+/**
+ * @brief Converts a cairo surface into a sprite for a video format.
+ *
+ * The logo is converted to premultiplied YUVA (or RGBA for RGB formats) in
+ * the matrix, range and transfer function of @colorimetry once, then every
+ * plane of @format is laid out from the component
+ * offsets, pixel strides and subsampling of its #GstVideoFormatInfo.
+ * Planar (I420, Y42B, Y444), semi-planar (NV12, NV21, NV16, NV24), packed
+ * (YUY2, UYVY, BGRx, RGBA, ...) and grey formats all come out as plain
+ * byte rows blended by the same kernels. A plane unit is the smallest
+ * group of bytes holding every component of the plane, e.g. one Cb/Cr
+ * pair of NV12 or one Y0 Cb Y1 Cr macro-pixel of YUY2, and sprites are
+ * placed on unit boundaries. Formats deeper than 8 bits (P010, I420_10LE,
+ * ...) get 16 bit samples at the depth and bit position of the format.
+ * Tiled formats have the sprite of their linear layout; the tiles are only
+ * resolved when blending.
+ *
+ * An alpha byte of the frame is composited like a colour with the
+ * coverage as premultiplied value, which is the over operator for the
+ * frame alpha. The colours are only exact over opaque frame pixels, as
+ * the frame itself is not premultiplied. The padding byte of RGBx like
+ * formats is treated the same way so opaque runs stay contiguous.
+ *
+ * @param surface A CAIRO_FORMAT_ARGB32 image surface.
+ * @param format The format of the frames, see
+ *     gst_logo_sprite_supports_format().
+ * @param colorimetry The colorimetry of the frames.
+ * @return A new #GstLogoSprite, free with gst_logo_sprite_free().
+ */
+GstLogoSprite *
+gst_logo_sprite_new_from_surface (cairo_surface_t * surface,
+    GstVideoFormat format, const GstVideoColorimetry * colorimetry)
+{
+  const GstVideoFormatInfo *finfo = gst_video_format_get_info (format);
+  const GstLogoColorTables *tables;
+  GstLogoSprite *sprite;
+  const guint8 *data;
+  guint8 *yuva;
+  gint stride, width, height, i, j;
+  guint p, c, bytes;
+
+  cairo_surface_flush (surface);
+  data = cairo_image_surface_get_data (surface);
+  stride = cairo_image_surface_get_stride (surface);
+  width = cairo_image_surface_get_width (surface);
+  height = cairo_image_surface_get_height (surface);
+
+  tables = gst_logo_color_tables_get (colorimetry,
+      GST_VIDEO_FORMAT_INFO_IS_RGB (finfo));
+  yuva = g_malloc ((gsize) width * height * 4);
+  for (j = 0; j < height; j++) {
+    const guint32 *src = (const guint32 *) (data + (gsize) j * stride);
+    guint8 *dst = yuva + (gsize) j * width * 4;
+
+    for (i = 0; i < width; i++)
+      gst_logo_color_convert (tables, src[i], dst + 4 * i);
+  }
+
+  sprite = g_new0 (GstLogoSprite, 1);
+  sprite->width = width;
+  sprite->height = height;
+  sprite->format = format;
+  sprite->colorimetry = *colorimetry;
+  sprite->n_planes = GST_VIDEO_FORMAT_INFO_N_PLANES (finfo);
+
+  /* A unit spans the most subsampled component of the plane */
+  bytes = GST_VIDEO_FORMAT_INFO_DEPTH (finfo, 0) > 8 ? 2 : 1;
+  for (p = 0; p < sprite->n_planes; p++) {
+    guint x_sub = 0, y_sub = 0, pstride = 1, shift = 0;
+
+    for (c = 0; c < GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo); c++) {
+      if (GST_VIDEO_FORMAT_INFO_PLANE (finfo, c) != p)
+        continue;
+      if (GST_VIDEO_FORMAT_INFO_W_SUB (finfo, c) >= x_sub) {
+        x_sub = GST_VIDEO_FORMAT_INFO_W_SUB (finfo, c);
+        pstride = GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, c) / bytes;
+      }
+      y_sub = GST_VIDEO_FORMAT_INFO_H_SUB (finfo, c);
+      shift = GST_VIDEO_FORMAT_INFO_SHIFT (finfo, c);
+    }
+    gst_logo_sprite_plane_alloc (&sprite->planes[p], x_sub, y_sub, pstride,
+        bytes, shift, width, height);
+  }
+
+  /* Luma, or R, G and B, are the samples that carry the light */
+  for (c = 0; c < GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo); c++) {
+    GstLogoSpritePlane *plane =
+        &sprite->planes[GST_VIDEO_FORMAT_INFO_PLANE (finfo, c)];
+    guint per_unit = plane->x_sub - GST_VIDEO_FORMAT_INFO_W_SUB (finfo, c);
+    guint k;
+
+    if (c >= (GST_VIDEO_FORMAT_INFO_IS_RGB (finfo) ? 3 : 1))
+      continue;
+    for (k = 0; k < (1u << per_unit); k++)
+      plane->linear_mask |= 1 << (GST_VIDEO_FORMAT_INFO_POFFSET (finfo, c)
+          / bytes + k * GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, c) / bytes);
+  }
+
+  for (c = 0; c < GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo); c++)
+    gst_logo_sprite_plane_fill (
+        &sprite->planes[GST_VIDEO_FORMAT_INFO_PLANE (finfo, c)], yuva, width,
+        height, c, GST_VIDEO_FORMAT_INFO_W_SUB (finfo, c),
+        GST_VIDEO_FORMAT_INFO_POFFSET (finfo, c) / bytes,
+        GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, c) / bytes,
+        GST_VIDEO_FORMAT_INFO_DEPTH (finfo, c));
+
+  /* The one byte of a 4 byte RGB pixel that is no component is padding */
+  if (GST_VIDEO_FORMAT_INFO_IS_RGB (finfo)
+      && !GST_VIDEO_FORMAT_INFO_HAS_ALPHA (finfo)
+      && GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, 0) == 4) {
+    guint padding = 0 + 1 + 2 + 3;
+
+    for (c = 0; c < GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo); c++)
+      padding -= GST_VIDEO_FORMAT_INFO_POFFSET (finfo, c);
+    gst_logo_sprite_plane_fill (&sprite->planes[0], yuva, width, height, 3,
+        0, padding, 4, 8);
+  }
+  g_free (yuva);
+
+  for (p = 0; p < sprite->n_planes; p++)
+    gst_logo_sprite_plane_index (&sprite->planes[p]);
+
+  return sprite;
+}
+
+/**
+ * @brief Builds a sprite of a rotated and scaled logo.
+ *
+ * A rotated logo is drawn around its center into a square surface of the
+ * size of its longer side, so that every angle has the same sprite size.
+ *
+ * @param surface The logo as ARGB32 image surface.
+ * @param degree The rotation angle in degrees, clockwise.
+ * @param scale The size relative to @surface.
+ * @param format The format of the frames.
+ * @param colorimetry The colorimetry of the frames.
+ * @return A new sprite with the transformed logo.
+ */
+GstLogoSprite *
+gst_logo_sprite_new_transformed (cairo_surface_t * surface, gdouble degree,
+    gdouble scale, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry)
+{
+  gint width = cairo_image_surface_get_width (surface);
+  gint height = cairo_image_surface_get_height (surface);
+  gint out_width, out_height;
+  cairo_surface_t *transformed;
+  GstLogoSprite *sprite;
+  cairo_t *cr;
+
+  if (degree != 0) {
+    out_width = out_height = MAX (1, (gint) ceil (MAX (width, height) * scale));
+  } else {
+    out_width = MAX (1, (gint) ceil (width * scale));
+    out_height = MAX (1, (gint) ceil (height * scale));
+  }
+
+  transformed = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, out_width,
+      out_height);
+  cr = cairo_create (transformed);
+  cairo_translate (cr, out_width / 2.0, out_height / 2.0);
+  cairo_rotate (cr, degree * (G_PI / 180.0));
+  cairo_scale (cr, scale, scale);
+  cairo_translate (cr, -width / 2.0, -height / 2.0);
+  cairo_set_source_surface (cr, surface, 0, 0);
+  cairo_paint (cr);
+  cairo_destroy (cr);
+
+  sprite = gst_logo_sprite_new_from_surface (transformed, format,
+      colorimetry);
+  cairo_surface_destroy (transformed);
+
+  return sprite;
+}
+
+/* The mip pyramid stops once the shorter side would get below this */
+#define GST_LOGO_SPRITE_MIP_MIN 4
+
+/**
+ * @brief Builds the mip pyramid of a sprite.
+ *
+ * Every level halves the one above it with cairo's box filter, until the
+ * shorter side would get below GST_LOGO_SPRITE_MIP_MIN pixels. A placement
+ * resampled to another size reads the smallest level that is still at
+ * least as large, so the bilinear filter never has to skip source pixels
+ * and every size costs about the same whatever the size of the logo.
+ *
+ * @param sprite A sprite without mip levels.
+ * @param surface The ARGB32 surface @sprite was built from.
+ */
+void
+gst_logo_sprite_add_mips (GstLogoSprite * sprite, cairo_surface_t * surface)
+{
+  cairo_surface_t *src = cairo_surface_reference (surface);
+  GstLogoSprite *level = sprite;
+
+  while (MIN (level->width, level->height) >= 2 * GST_LOGO_SPRITE_MIP_MIN) {
+    gint width = (level->width + 1) / 2, height = (level->height + 1) / 2;
+    cairo_surface_t *half;
+    cairo_t *cr;
+
+    half = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+    cr = cairo_create (half);
+    cairo_scale (cr, (gdouble) width / level->width,
+        (gdouble) height / level->height);
+    cairo_set_source_surface (cr, src, 0, 0);
+    cairo_pattern_set_filter (cairo_get_source (cr), CAIRO_FILTER_GOOD);
+    cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+    cairo_paint (cr);
+    cairo_destroy (cr);
+
+    level->mip = gst_logo_sprite_new_from_surface (half, sprite->format,
+        &sprite->colorimetry);
+    cairo_surface_destroy (src);
+    src = half;
+    level = level->mip;
+  }
+  cairo_surface_destroy (src);
+}
+
+/**
+ * @brief Frees a sprite with its planes and mip levels.
+ *
+ * @param sprite The sprite to free, may be NULL.
+ */
+void
+gst_logo_sprite_free (GstLogoSprite * sprite)
+{
+  guint p;
+
+  if (sprite == NULL)
+    return;
+
+  gst_logo_sprite_free (sprite->mip);
+  for (p = 0; p < sprite->n_planes; p++) {
+    g_free (sprite->planes[p].pixels);
+    g_free (sprite->planes[p].alpha);
+    g_free (sprite->planes[p].row_spans);
+    g_free (sprite->planes[p].spans);
+  }
+  g_free (sprite);
+}
+
+/**
+ * @brief Blends premultiplied bytes over a row of the frame.
+ */
+static inline void
+gst_logo_sprite_blend_bytes (guint8 * dst, const guint8 * src,
+    const guint8 * alpha, guint n)
+{
+  guint i;
+
+  for (i = 0; i < n; i++)
+    dst[i] = src[i] + gst_logo_div255 (dst[i] * (255 - alpha[i]));
+}
+
+/**
+ * @brief Blends premultiplied bytes faded by a global opacity.
+ */
+static inline void
+gst_logo_sprite_blend_bytes_alpha (guint8 * dst, const guint8 * src,
+    const guint8 * alpha, guint n, guint global_alpha)
+{
+  guint i;
+
+  for (i = 0; i < n; i++) {
+    guint a = gst_logo_div255 (alpha[i] * global_alpha);
+
+    dst[i] = gst_logo_div255 (src[i] * global_alpha)
+        + gst_logo_div255 (dst[i] * (255 - a));
+  }
+}
+
+/**
+ * @brief Mixes opaque bytes into a row of the frame at a global opacity.
+ *
+ * Opaque spans have full coverage, so the mix only depends on the global
+ * opacity and needs no coverage lookup. Both terms are rounded separately
+ * to give the same bytes as gst_logo_sprite_blend_bytes_alpha().
+ */
+static inline void
+gst_logo_sprite_mix_bytes (guint8 * dst, const guint8 * src, guint n,
+    guint global_alpha)
+{
+  guint inv = 255 - global_alpha;
+  guint i;
+
+  for (i = 0; i < n; i++)
+    dst[i] = gst_logo_div255 (src[i] * global_alpha)
+        + gst_logo_div255 (dst[i] * inv);
+}
+
+/* Exact x / 255 with rounding for products of 16 bit samples */
+static inline guint
+gst_logo_div255_wide (guint x)
+{
+  return (x + 127) / 255;
+}
+
+/**
+ * @brief Blends premultiplied 16 bit samples over a row of the frame.
+ *
+ * The arithmetic is the one of the byte kernels on the value bits of the
+ * samples, so bits below @shift come out cleared.
+ */
+static inline void
+gst_logo_sprite_blend_words (guint16 * dst, const guint16 * src,
+    const guint8 * alpha, guint n, guint shift)
+{
+  guint i;
+
+  for (i = 0; i < n; i++)
+    dst[i] = src[i]
+        + (gst_logo_div255_wide ((dst[i] >> shift) * (255 - alpha[i]))
+        << shift);
+}
+
+/**
+ * @brief Blends premultiplied 16 bit samples faded by a global opacity.
+ */
+static inline void
+gst_logo_sprite_blend_words_alpha (guint16 * dst, const guint16 * src,
+    const guint8 * alpha, guint n, guint global_alpha, guint shift)
+{
+  guint i;
+
+  for (i = 0; i < n; i++) {
+    guint a = gst_logo_div255 (alpha[i] * global_alpha);
+
+    dst[i] = (gst_logo_div255_wide ((src[i] >> shift) * global_alpha)
+        + gst_logo_div255_wide ((dst[i] >> shift) * (255 - a))) << shift;
+  }
+}
+
+/**
+ * @brief Mixes opaque 16 bit samples into a row at a global opacity.
+ */
+static inline void
+gst_logo_sprite_mix_words (guint16 * dst, const guint16 * src, guint n,
+    guint global_alpha, guint shift)
+{
+  guint inv = 255 - global_alpha;
+  guint i;
+
+  for (i = 0; i < n; i++)
+    dst[i] = (gst_logo_div255_wide ((src[i] >> shift) * global_alpha)
+        + gst_logo_div255_wide ((dst[i] >> shift) * inv)) << shift;
+}
+
+/**
+ * @brief Blends one span of a 16 bit plane that needs arithmetic.
+ */
+static inline void
+gst_logo_sprite_blend_span_words (const GstLogoSpritePlane * plane,
+    guint16 * dst, const guint16 * src, const guint8 * coverage, guint n,
+    GstLogoSpanKind kind, guint alpha)
+{
+  if (kind == GST_LOGO_SPAN_OPAQUE)
+    gst_logo_sprite_mix_words (dst, src, n, alpha, plane->shift);
+  else if (alpha == 255)
+    gst_logo_sprite_blend_words (dst, src, coverage, n, plane->shift);
+  else
+    gst_logo_sprite_blend_words_alpha (dst, src, coverage, n, alpha,
+        plane->shift);
+}
+
+/**
+ * @brief Blends one span of a plane in linear light.
+ *
+ * The samples flagged in the linear mask of the plane are unpremultiplied,
+ * decoded to linear light together with the frame sample, mixed with the
+ * faded coverage and encoded again. Samples not covered at all are left
+ * alone so they keep their exact value. The other samples of the plane
+ * take the arithmetic of the faded kernels.
+ *
+ * @param start First sample of the span in the sprite row.
+ */
+static void
+gst_logo_sprite_blend_span_linear (const GstLogoSpritePlane * plane,
+    const GstLogoLinearTables * linear, guint8 * dst, const guint8 * src,
+    const guint8 * coverage, guint start, guint n, GstLogoSpanKind kind,
+    guint alpha)
+{
+  guint max = (1 << linear->depth) - 1;
+  guint i;
+
+  for (i = start; i < start + n; i++) {
+    guint c = kind == GST_LOGO_SPAN_OPAQUE ? 255 : coverage[i];
+    guint a = gst_logo_div255 (c * alpha);
+    guint s, d, v;
+
+    if (plane->bytes == 2) {
+      s = ((const guint16 *) src)[i] >> plane->shift;
+      d = ((guint16 *) dst)[i] >> plane->shift;
+    } else {
+      s = src[i];
+      d = dst[i];
+    }
+
+    if (plane->linear_mask & (1 << (i % plane->pstride))) {
+      guint light;
+
+      if (a == 0)
+        continue;
+      v = c == 255 ? s : MIN (max, (s * 255 + c / 2) / c);
+      light = (linear->decode[v] * a + linear->decode[d] * (255 - a)
+          + 127) / 255;
+      v = linear->encode[light >> linear->encode_shift];
+    } else {
+      v = gst_logo_div255_wide (s * alpha)
+          + gst_logo_div255_wide (d * (255 - a));
+    }
+
+    if (plane->bytes == 2)
+      ((guint16 *) dst)[i] = v << plane->shift;
+    else
+      dst[i] = v;
+  }
+}
+
+/**
+ * @brief Blends the spans of one sprite row that fall into a column range.
+ *
+ * @param plane The sprite plane.
+ * @param row The sprite row.
+ * @param dst The frame row, already offset to the left edge of the sprite.
+ * @param col_start First visible sample of the sprite row.
+ * @param col_end End of the visible samples of the sprite row.
+ * @param alpha Global opacity of the sprite, 0 to 255.
+ * @param linear Tables to blend in linear light, NULL to blend the samples
+ *     as they are.
+ * @param counts Return location for the blended pixels per kernel, or NULL.
+ */
+static inline void
+gst_logo_sprite_blend_row (const GstLogoSpritePlane * plane, gint row,
+    guint8 * dst, gint col_start, gint col_end, guint alpha,
+    const GstLogoLinearTables * linear, GstLogoBlendCounts * counts)
+{
+  const guint8 *src = plane->pixels + (gsize) row * plane->width * plane->bytes;
+  const guint8 *coverage = plane->alpha + (gsize) row * plane->width;
+  guint bytes = plane->bytes;
+  guint s;
+
+  for (s = plane->row_spans[row]; s < plane->row_spans[row + 1]; s++) {
+    const GstLogoSpan *span = &plane->spans[s];
+    gint start = MAX ((gint) span->start, col_start);
+    gint end = MIN ((gint) (span->start + span->len), col_end);
+
+    if (start >= end)
+      continue;
+
+    if (span->kind == GST_LOGO_SPAN_OPAQUE && alpha == 255) {
+      memcpy (dst + start * bytes, src + start * bytes,
+          (end - start) * bytes);
+    } else if (linear != NULL) {
+      gst_logo_sprite_blend_span_linear (plane, linear, dst, src, coverage,
+          start, end - start, span->kind, alpha);
+    } else if (bytes == 2) {
+      gst_logo_sprite_blend_span_words (plane, (guint16 *) dst + start,
+          (const guint16 *) src + start, coverage + start, end - start,
+          span->kind, alpha);
+    } else if (span->kind == GST_LOGO_SPAN_OPAQUE) {
+      gst_logo_sprite_mix_bytes (dst + start, src + start, end - start,
+          alpha);
+    } else if (alpha == 255) {
+      gst_logo_sprite_blend_bytes (dst + start, src + start,
+          coverage + start, end - start);
+    } else {
+      gst_logo_sprite_blend_bytes_alpha (dst + start, src + start,
+          coverage + start, end - start, alpha);
+    }
+
+    if (counts != NULL) {
+      guint64 pixels = ((guint64) (end - start) << plane->x_sub)
+          / plane->pstride;
+
+      if (span->kind == GST_LOGO_SPAN_OPAQUE)
+        *(alpha == 255 ? &counts->opaque : &counts->mixed) += pixels;
+      else
+        *(alpha == 255 ? &counts->blended : &counts->faded) += pixels;
+    }
+  }
+}
+
+/**
+ * @brief Reads the tile grid of a plane of a mapped tiled frame.
+ *
+ * The stride of a tiled plane holds the number of tiles in each direction.
+ *
+ * @param tiling Return location for the tile grid.
+ * @param frame A mapped frame in a tiled format.
+ * @param plane The plane.
+ */
+void
+gst_logo_sprite_tiling_init (GstLogoTiling * tiling, GstVideoFrame * frame,
+    guint plane)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  gint stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, plane);
+
+  tiling->mode = GST_VIDEO_FORMAT_INFO_TILE_MODE (finfo);
+#if GST_CHECK_VERSION(1, 22, 0)
+  {
+    const GstVideoTileInfo *tinfo =
+        GST_VIDEO_FORMAT_INFO_TILE_INFO (finfo, plane);
+
+    tiling->width = tinfo->stride;
+    tiling->height = tinfo->height;
+    tiling->size = tinfo->size;
+  }
+#else
+  tiling->width = 1 << GST_VIDEO_FORMAT_INFO_TILE_WS (finfo);
+  tiling->height = 1 << GST_VIDEO_FORMAT_INFO_TILE_HS (finfo);
+  tiling->size = (gsize) tiling->width * tiling->height;
+#endif
+  tiling->x_tiles = GST_VIDEO_TILE_X_TILES (stride);
+  tiling->y_tiles = GST_VIDEO_TILE_Y_TILES (stride);
+}
+
+/**
+ * @brief Finds a byte of a tiled frame plane.
+ *
+ * @param tiling The tile grid of the plane.
+ * @param data The plane.
+ * @param x Byte offset in the row as if the plane was not tiled.
+ * @param row The row.
+ * @return The address of the byte.
+ */
+guint8 *
+gst_logo_sprite_tiling_get (const GstLogoTiling * tiling, guint8 * data,
+    gint x, gint row)
+{
+  return data + tiling->size * gst_video_tile_get_index (tiling->mode,
+      x / tiling->width, row / tiling->height, tiling->x_tiles,
+      tiling->y_tiles) + (gsize) (row % tiling->height) * tiling->width
+      + x % tiling->width;
+}
+
+/**
+ * @brief Blends the visible part of a sprite row into a tiled frame row.
+ *
+ * The frame row is cut where it crosses into the next tile and every piece
+ * is blended in place inside its tile, so only the tiles under the sprite
+ * are touched.
+ *
+ * @param plane The sprite plane.
+ * @param row The sprite row.
+ * @param tiling The tile grid of the frame plane.
+ * @param data The frame plane.
+ * @param frame_row The frame row the sprite row lands on.
+ * @param px Left edge of the sprite in samples.
+ * @param col_start First visible sample of the sprite row.
+ * @param col_end End of the visible samples of the sprite row.
+ * @param alpha Global opacity of the sprite, 0 to 255.
+ * @param linear Tables to blend in linear light, or NULL.
+ * @param counts Return location for the blended pixels per kernel, or NULL.
+ */
+static void
+gst_logo_sprite_blend_row_tiled (const GstLogoSpritePlane * plane, gint row,
+    const GstLogoTiling * tiling, guint8 * data, gint frame_row, gint px,
+    gint col_start, gint col_end, guint alpha,
+    const GstLogoLinearTables * linear, GstLogoBlendCounts * counts)
+{
+  gint bytes = plane->bytes;
+  gint tile_y = frame_row / tiling->height;
+  guint8 *line = data + (gsize) (frame_row % tiling->height) * tiling->width;
+  gint col, end;
+
+  for (col = col_start; col < col_end; col = end) {
+    gint x = (px + col) * bytes;
+    gint tile_x = x / tiling->width;
+    guint8 *tile = line + tiling->size *
+        gst_video_tile_get_index (tiling->mode, tile_x, tile_y,
+        tiling->x_tiles, tiling->y_tiles);
+
+    end = MIN (col_end, ((tile_x + 1) * tiling->width) / bytes - px);
+    gst_logo_sprite_blend_row (plane, row,
+        tile + x % tiling->width - col * bytes, col, end, alpha, linear,
+        counts);
+  }
+}
+
+/* One plane of a placement resampled while it is blended */
+typedef struct
+{
+  const GstLogoSpritePlane *src;        /* the plane of the mip level */
+  GstLogoSpritePlane plane;     /* one resampled row of the result */
+  guint *x0;                    /* left source sample per sample of a row */
+  guint8 *fx;                   /* weight of the right one, of 256 */
+  guint scale;                  /* bits of the samples above 8 */
+  guint row_spans[2];
+  GArray *spans;
+} GstLogoResample;
+
+/**
+ * @brief Maps a resampled position to the source.
+ *
+ * Pixel centers are lined up, so the edges of the result fall onto the
+ * edges of the source.
+ *
+ * @param i The position in the result.
+ * @param dst_n Size of the result.
+ * @param src_n Size of the source.
+ * @param i0 Return location for the source position before @i.
+ * @param f Return location for the weight of the one after it, of 256.
+ *     It is 0 at the far edge so nothing past the source is read.
+ */
+static inline void
+gst_logo_sprite_resample_map (gint i, gint dst_n, gint src_n, guint * i0,
+    guint8 * f)
+{
+  gint64 pos = ((gint64) (2 * i + 1) * src_n << 16) / (2 * dst_n) - 32768;
+
+  pos = MAX (pos, 0);
+  *i0 = pos >> 16;
+  *f = (pos & 0xffff) >> 8;
+  if (*i0 >= (guint) src_n - 1) {
+    *i0 = src_n - 1;
+    *f = 0;
+  }
+}
+
+/* Bilinear interpolation in fixed point; 16 bit samples use all 32 bits */
+static inline guint
+gst_logo_sprite_bilinear (guint p00, guint p01, guint p10, guint p11,
+    guint fx, guint fy)
+{
+  guint top = p00 * (256 - fx) + p01 * fx;
+  guint bottom = p10 * (256 - fx) + p11 * fx;
+
+  return (top * (256 - fy) + bottom * fy + 32768) >> 16;
+}
+
+/**
+ * @brief Prepares the resampling of a sprite plane to another size.
+ *
+ * Samples are interpolated between the units of the plane, so every
+ * component only mixes with the same component of the neighbouring units.
+ *
+ * @param rs The resampling to set up.
+ * @param src The plane of the mip level to read.
+ * @param width Width of the result in luma pixels.
+ * @param height Height of the result in luma pixels.
+ * @param depth Bits of the samples.
+ */
+static void
+gst_logo_sprite_resample_init (GstLogoResample * rs,
+    const GstLogoSpritePlane * src, gint width, gint height, guint depth)
+{
+  guint pstride = src->pstride;
+  gint src_units = src->width / pstride, dst_units, i;
+
+  rs->src = src;
+  rs->plane = *src;
+  rs->plane.width = GST_VIDEO_SUB_SCALE (src->x_sub, width) * pstride;
+  rs->plane.height = GST_VIDEO_SUB_SCALE (src->y_sub, height);
+  rs->plane.pixels = g_malloc ((gsize) rs->plane.width * src->bytes);
+  rs->plane.alpha = g_malloc (rs->plane.width);
+  rs->plane.row_spans = rs->row_spans;
+  rs->scale = depth - 8;
+  rs->spans = g_array_new (FALSE, FALSE, sizeof (GstLogoSpan));
+
+  dst_units = rs->plane.width / pstride;
+  rs->x0 = g_new (guint, rs->plane.width);
+  rs->fx = g_new (guint8, rs->plane.width);
+  for (i = 0; i < rs->plane.width; i++) {
+    gst_logo_sprite_resample_map (i / pstride, dst_units, src_units,
+        &rs->x0[i], &rs->fx[i]);
+    rs->x0[i] = rs->x0[i] * pstride + i % pstride;
+  }
+}
+
+static void
+gst_logo_sprite_resample_clear (GstLogoResample * rs)
+{
+  g_free (rs->plane.pixels);
+  g_free (rs->plane.alpha);
+  g_free (rs->x0);
+  g_free (rs->fx);
+  g_array_free (rs->spans, TRUE);
+}
+
+/**
+ * @brief Resamples the visible part of one row and indexes its spans.
+ *
+ * The premultiplied samples and the coverage are interpolated alike, and
+ * the samples are capped at the coverage like when the sprite is built.
+ * The result is row 0 of @rs->plane.
+ *
+ * @param rs The resampling of the plane.
+ * @param row The row of the result.
+ * @param col_start First visible sample of the row.
+ * @param col_end End of the visible samples of the row.
+ */
+static void
+gst_logo_sprite_resample_row (GstLogoResample * rs, gint row, gint col_start,
+    gint col_end)
+{
+  const GstLogoSpritePlane *src = rs->src;
+  const guint8 *a0, *a1, *p0, *p1;
+  guint y0, bytes = src->bytes;
+  guint8 fy;
+  gint i;
+
+  gst_logo_sprite_resample_map (row, rs->plane.height, src->height, &y0,
+      &fy);
+  a0 = src->alpha + (gsize) y0 * src->width;
+  a1 = fy > 0 ? a0 + src->width : a0;
+  p0 = src->pixels + (gsize) y0 * src->width * bytes;
+  p1 = fy > 0 ? p0 + src->width * bytes : p0;
+
+  for (i = col_start; i < col_end; i++) {
+    guint x0 = rs->x0[i], fx = rs->fx[i];
+    guint x1 = fx > 0 ? x0 + src->pstride : x0;
+    guint a, v;
+
+    a = gst_logo_sprite_bilinear (a0[x0], a0[x1], a1[x0], a1[x1], fx, fy);
+    rs->plane.alpha[i] = a;
+    if (bytes == 2) {
+      const guint16 *w0 = (const guint16 *) p0, *w1 = (const guint16 *) p1;
+      guint shift = src->shift;
+
+      v = gst_logo_sprite_bilinear (w0[x0] >> shift, w0[x1] >> shift,
+          w1[x0] >> shift, w1[x1] >> shift, fx, fy);
+      ((guint16 *) rs->plane.pixels)[i] = MIN (v, a << rs->scale) << shift;
+    } else {
+      v = gst_logo_sprite_bilinear (p0[x0], p0[x1], p1[x0], p1[x1], fx, fy);
+      rs->plane.pixels[i] = MIN (v, a);
+    }
+  }
+
+  g_array_set_size (rs->spans, 0);
+  gst_logo_sprite_row_index (rs->spans, rs->plane.alpha, col_start, col_end);
+  rs->plane.spans = (GstLogoSpan *) rs->spans->data;
+  rs->row_spans[0] = 0;
+  rs->row_spans[1] = rs->spans->len;
+}
+
+/**
+ * @brief Picks the mip level a placement is resampled from.
+ *
+ * @param pl The placement.
+ * @param width Return location for the width of the result.
+ * @param height Return location for the height of the result.
+ * @return The smallest level at least as large as the result, or NULL if
+ *     the sprite is blended at its own size.
+ */
+static const GstLogoSprite *
+gst_logo_sprite_placement_level (const GstLogoPlacement * pl, gint * width,
+    gint * height)
+{
+  const GstLogoSprite *level = pl->sprite;
+
+  *width = pl->width > 0 ? pl->width : level->width;
+  *height = pl->height > 0 ? pl->height : level->height;
+  if (*width == level->width && *height == level->height)
+    return NULL;
+
+  while (level->mip != NULL && level->mip->width >= *width
+      && level->mip->height >= *height)
+    level = level->mip;
+  return level;
+}
+
+/* Where a placement lands in one plane of the frame */
+typedef struct
+{
+  gint px;                      /* left edge in samples */
+  gint py;                      /* top edge in rows */
+  gint top;                     /* first visible frame row */
+  gint bottom;                  /* end of the visible frame rows */
+  gint col_start;               /* visible sample range of a sprite row */
+  gint col_end;
+} GstLogoClip;
+
+/* Sorts placement indices by their first visible row, keeping the stacking
+ * order for placements starting on the same row */
+static gint
+gst_logo_sprite_compare_top (gconstpointer a, gconstpointer b, gpointer data)
+{
+  const GstLogoClip *clips = data;
+  guint ia = *(const guint *) a, ib = *(const guint *) b;
+
+  if (clips[ia].top != clips[ib].top)
+    return clips[ia].top < clips[ib].top ? -1 : 1;
+  return ia < ib ? -1 : (ia > ib);
+}
+
+/**
+ * @brief Blends a stack of sprites into a mapped frame in a single pass.
+ *
+ * The placements are stacked in array order, the first one at the bottom.
+ * Every plane is walked once from top to bottom; each frame row is blended
+ * with all placements covering it before moving on to the next row, so the
+ * frame is only brought into the cache once however many layers overlap.
+ * Placements are clipped against the frame and may be partly outside.
+ *
+ * A placement of another size than its sprite is resampled from the mip
+ * level closest above that size, one row at a time right before the row
+ * is blended, so it needs no sprite of its own and stays in the cache.
+ *
+ * @param placements The sprites and where to put them.
+ * @param n_placements Number of entries in @placements.
+ * @param frame A frame mapped for writing in the format of the sprites.
+ * @param space The #GstLogoBlendSpace, linear light is decoded with the
+ *     colorimetry of @frame.
+ * @param counts Accumulates the pixels of the first plane per kernel, or
+ *     NULL.
+ */
+void
+gst_logo_sprite_blend_layers (const GstLogoPlacement * placements,
+    guint n_placements, GstVideoFrame * frame, GstLogoBlendSpace space,
+    GstLogoBlendCounts * counts)
+{
+  guint depth = GST_VIDEO_FORMAT_INFO_DEPTH (frame->info.finfo, 0);
+  const GstLogoSpritePlane **planes;
+  GstLogoResample *resamples;
+  GstLogoClip *clips;
+  guint *order, *active;
+  guint p, i;
+
+  if (n_placements == 0)
+    return;
+
+  clips = g_new (GstLogoClip, n_placements);
+  order = g_new (guint, n_placements);
+  active = g_new (guint, n_placements);
+  planes = g_new (const GstLogoSpritePlane *, n_placements);
+  resamples = g_new0 (GstLogoResample, n_placements);
+
+  for (p = 0; p < placements[0].sprite->n_planes; p++) {
+    guint8 *data = GST_VIDEO_FRAME_PLANE_DATA (frame, p);
+    gint stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, p);
+    gboolean tiled = GST_VIDEO_FORMAT_INFO_IS_TILED (frame->info.finfo);
+    const GstLogoLinearTables *linear = NULL;
+    GstLogoTiling tiling;
+    guint n_order = 0, n_active = 0, next = 0;
+    gint row = 0;
+
+    if (tiled)
+      gst_logo_sprite_tiling_init (&tiling, frame, p);
+    if (space == GST_LOGO_BLEND_SPACE_LINEAR
+        && placements[0].sprite->planes[p].linear_mask != 0)
+      linear = gst_logo_color_linear_get (&frame->info.colorimetry,
+          GST_VIDEO_FORMAT_INFO_IS_RGB (frame->info.finfo),
+          GST_VIDEO_FORMAT_INFO_DEPTH (frame->info.finfo, 0));
+
+    for (i = 0; i < n_placements; i++) {
+      const GstLogoPlacement *pl = &placements[i];
+      const GstLogoSpritePlane *plane = &pl->sprite->planes[p];
+      GstLogoClip *clip = &clips[i];
+      const GstLogoSprite *level;
+      gint width, height;
+
+      level = gst_logo_sprite_placement_level (pl, &width, &height);
+      if (level != NULL) {
+        gst_logo_sprite_resample_init (&resamples[i], &level->planes[p],
+            width, height, depth);
+        plane = &resamples[i].plane;
+      }
+      planes[i] = plane;
+      gint frame_w = GST_VIDEO_SUB_SCALE (plane->x_sub,
+          GST_VIDEO_FRAME_WIDTH (frame)) * plane->pstride;
+      gint frame_h = GST_VIDEO_SUB_SCALE (plane->y_sub,
+          GST_VIDEO_FRAME_HEIGHT (frame));
+
+      clip->px = (pl->x >> plane->x_sub) * (gint) plane->pstride;
+      clip->py = pl->y >> plane->y_sub;
+      clip->top = MAX (0, clip->py);
+      clip->bottom = MIN (frame_h, clip->py + plane->height);
+      clip->col_start = MAX (0, -clip->px);
+      clip->col_end = MIN (plane->width, frame_w - clip->px);
+
+      if (pl->alpha > 0 && clip->top < clip->bottom
+          && clip->col_start < clip->col_end)
+        order[n_order++] = i;
+    }
+
+    if (n_order > 0) {
+      g_qsort_with_data (order, n_order, sizeof (guint),
+          gst_logo_sprite_compare_top, clips);
+      row = clips[order[0]].top;
+    }
+    while (next < n_order || n_active > 0) {
+      guint8 *dst;
+      guint a, k;
+
+      /* Nothing on this row, jump to the next placement */
+      if (n_active == 0 && clips[order[next]].top > row)
+        row = clips[order[next]].top;
+
+      /* Activate placements starting here, in stacking order */
+      while (next < n_order && clips[order[next]].top == row) {
+        guint idx = order[next++];
+
+        for (k = n_active; k > 0 && active[k - 1] > idx; k--)
+          active[k] = active[k - 1];
+        active[k] = idx;
+        n_active++;
+      }
+
+      dst = data + (gsize) row * stride;
+      for (a = 0, k = 0; a < n_active; a++) {
+        guint idx = active[a];
+        const GstLogoClip *clip = &clips[idx];
+        const GstLogoSpritePlane *plane = planes[idx];
+        gint sprite_row = row - clip->py;
+
+        if (resamples[idx].src != NULL) {
+          gst_logo_sprite_resample_row (&resamples[idx], sprite_row,
+              clip->col_start, clip->col_end);
+          sprite_row = 0;
+        }
+
+        if (tiled)
+          gst_logo_sprite_blend_row_tiled (plane, sprite_row, &tiling,
+              data, row, clip->px, clip->col_start, clip->col_end,
+              placements[idx].alpha, linear, p == 0 ? counts : NULL);
+        else
+          gst_logo_sprite_blend_row (plane, sprite_row,
+              dst + clip->px * (gint) plane->bytes, clip->col_start,
+              clip->col_end, placements[idx].alpha, linear,
+              p == 0 ? counts : NULL);
+
+        /* Retire placements ending on this row */
+        if (clip->bottom > row + 1)
+          active[k++] = idx;
+      }
+      n_active = k;
+      row++;
+    }
+
+    for (i = 0; i < n_placements; i++) {
+      if (resamples[i].src != NULL)
+        gst_logo_sprite_resample_clear (&resamples[i]);
+    }
+    memset (resamples, 0, n_placements * sizeof (GstLogoResample));
+  }
+
+  g_free (resamples);
+  g_free (planes);
+  g_free (active);
+  g_free (order);
+  g_free (clips);
+}
+
+/**
+ * @brief Blends a sprite into a mapped frame.
+ *
+ * The sprite is clipped against the frame, so @x and @y may be negative or
+ * place the sprite partly outside of the frame.
+ *
+ * @param sprite The sprite to blend.
+ * @param frame A frame mapped for writing in the format of the sprite.
+ * @param x Horizontal position of the sprite in luma pixels.
+ * @param y Vertical position of the sprite in luma pixels.
+ * @param alpha Global opacity of the sprite, 0 to 255.
+ */
+void
+gst_logo_sprite_blend (const GstLogoSprite * sprite, GstVideoFrame * frame,
+    gint x, gint y, guint alpha)
+{
+  GstLogoPlacement placement = { sprite, x, y, alpha };
+
+  gst_logo_sprite_blend_layers (&placement, 1, frame,
+      GST_LOGO_BLEND_SPACE_GAMMA, NULL);
+}
+
+/* Reads one sample of a frame plane, tiled or not */
+static inline guint
+gst_logo_sprite_read_sample (guint8 * data, gint stride,
+    const GstLogoTiling * tiling, gint x, gint row, guint bytes, guint shift)
+{
+  const guint8 *p;
+
+  if (tiling != NULL)
+    p = gst_logo_sprite_tiling_get (tiling, data, x, row);
+  else
+    p = data + (gsize) row * stride + x;
+  return bytes == 2 ? *(const guint16 *) p >> shift : *p;
+}
+
+/**
+ * @brief Measures the light of the frame in a rectangle.
+ *
+ * The light is the luma of YUV and grey formats and the mean of R, G and B
+ * of RGB formats. Only every GST_LOGO_SPRITE_MEASURE_STEP pixel of every
+ * GST_LOGO_SPRITE_MEASURE_STEP row is read, which is plenty to judge the
+ * contrast against a logo and keeps the cost a small fraction of a blend.
+ *
+ * This is a read of its own rather than a by-product of the blend: the
+ * blend copies the opaque spans of a logo at full opacity without reading
+ * the frame under them, and it reads the rest only while it overwrites
+ * it. The light has to describe the video before any logo is drawn over
+ * it.
+ *
+ * @param frame A mapped frame in a format sprites can be built for.
+ * @param x Left edge of the rectangle in luma pixels.
+ * @param y Top edge of the rectangle in luma pixels.
+ * @param width Width of the rectangle in luma pixels.
+ * @param height Height of the rectangle in luma pixels.
+ * @param stats Return location for the statistics.
+ * @return FALSE if the rectangle is outside of the frame.
+ */
+gboolean
+gst_logo_sprite_measure (GstVideoFrame * frame, gint x, gint y, gint width,
+    gint height, GstLogoLightStats * stats)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  guint n_comps = GST_VIDEO_FORMAT_INFO_IS_RGB (finfo) ? 3 : 1;
+  guint depth = GST_VIDEO_FORMAT_INFO_DEPTH (finfo, 0);
+  guint bytes = depth > 8 ? 2 : 1;
+  guint shift = GST_VIDEO_FORMAT_INFO_SHIFT (finfo, 0);
+  guint plane = GST_VIDEO_FORMAT_INFO_PLANE (finfo, 0);
+  guint8 *data = GST_VIDEO_FRAME_PLANE_DATA (frame, plane);
+  gint stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, plane);
+  gint x0 = MAX (x, 0), y0 = MAX (y, 0);
+  gint x1 = MIN (x + width, GST_VIDEO_FRAME_WIDTH (frame));
+  gint y1 = MIN (y + height, GST_VIDEO_FRAME_HEIGHT (frame));
+  gint offsets[3], pstrides[3];
+  GstLogoTiling tiling;
+  const GstLogoTiling *tiles = NULL;
+  guint64 sum = 0, sum_sq = 0, n = 0;
+  gdouble max, mean;
+  gint col, row;
+  guint c;
+
+  if (x0 >= x1 || y0 >= y1)
+    return FALSE;
+
+  for (c = 0; c < n_comps; c++) {
+    offsets[c] = GST_VIDEO_FORMAT_INFO_POFFSET (finfo, c);
+    pstrides[c] = GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, c);
+  }
+  if (GST_VIDEO_FORMAT_INFO_IS_TILED (finfo)) {
+    gst_logo_sprite_tiling_init (&tiling, frame, plane);
+    tiles = &tiling;
+  }
+
+  for (row = y0; row < y1; row += GST_LOGO_SPRITE_MEASURE_STEP) {
+    for (col = x0; col < x1; col += GST_LOGO_SPRITE_MEASURE_STEP) {
+      guint light = 0;
+
+      for (c = 0; c < n_comps; c++)
+        light += gst_logo_sprite_read_sample (data, stride, tiles,
+            col * pstrides[c] + offsets[c], row, bytes, shift);
+      sum += light;
+      sum_sq += (guint64) light * light;
+      n++;
+    }
+  }
+
+  max = (gdouble) n_comps * (255 << (depth - 8));
+  mean = (gdouble) sum / n;
+  stats->mean = mean / max;
+  stats->stddev = sqrt (MAX (0.0, (gdouble) sum_sq / n - mean * mean)) / max;
+  return TRUE;
+}
+
+/**
+ * @brief Computes the mean light of a sprite, weighted by its coverage.
+ *
+ * Uses the same measure as gst_logo_sprite_measure(), so the two can be
+ * compared to judge the contrast of the logo against the frame.
+ *
+ * @param sprite The sprite.
+ * @return The light of the sprite from 0 to 1, 0 if it is transparent.
+ */
+gdouble
+gst_logo_sprite_get_light (const GstLogoSprite * sprite)
+{
+  const GstLogoSpritePlane *plane = &sprite->planes[0];
+  const GstVideoFormatInfo *finfo = gst_video_format_get_info (sprite->format);
+  guint scale = GST_VIDEO_FORMAT_INFO_DEPTH (finfo, 0) - 8;
+  guint64 sum = 0, coverage = 0;
+  gsize i, n = (gsize) plane->width * plane->height;
+
+  for (i = 0; i < n; i++) {
+    if (!(plane->linear_mask & (1 << (i % plane->pstride))))
+      continue;
+    if (plane->bytes == 2)
+      sum += ((const guint16 *) plane->pixels)[i] >> plane->shift;
+    else
+      sum += plane->pixels[i];
+    coverage += plane->alpha[i];
+  }
+  return coverage > 0 ? (gdouble) sum / (coverage << scale) : 0.0;
+}
+
+/**
+ * @brief Names the blend kernels in use, for statistics.
+ */
+const gchar *
+gst_logo_sprite_kernel_name (void)
+{
+  return "c-span";
+}
@@ -0,0 +1,293 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_SPRITE_H__
+#define __GST_LOGO_SPRITE_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <cairo.h>
+
+G_BEGIN_DECLS
+
+/* High bit depth formats sprites can be built for, in native endianness */
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+#define GST_LOGO_SPRITE_FORMATS_16 \
+  "P010_10LE, P012_LE, P016_LE, I420_10LE, I420_12LE, I422_10LE, " \
+  "Y444_10LE, GRAY16_LE"
+#else
+#define GST_LOGO_SPRITE_FORMATS_16 \
+  "P010_10BE, P012_BE, P016_BE, I420_10BE, I420_12BE, I422_10BE, " \
+  "Y444_10BE, GRAY16_BE"
+#endif
+
+/* Tiled decoder formats blended in place, tile by tile */
+#if GST_CHECK_VERSION(1, 22, 0)
+#define GST_LOGO_SPRITE_FORMATS_TILED \
+  "NV12_4L4, NV12_32L32, NV12_64Z32, NV12_16L32S"
+#else
+#define GST_LOGO_SPRITE_FORMATS_TILED \
+  "NV12_4L4, NV12_32L32, NV12_64Z32"
+#endif
+
+/* Formats sprites can be built for, as caps format list */
+#define GST_LOGO_SPRITE_FORMATS \
+  "{ NV12, NV21, I420, YV12, NV16, NV61, Y42B, NV24, Y444, GRAY8, " \
+  "YUY2, UYVY, YVYU, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, " \
+  "RGB, BGR, " GST_LOGO_SPRITE_FORMATS_16 ", " \
+  GST_LOGO_SPRITE_FORMATS_TILED " }"
+
+/**
+ * GstLogoBlendSpace:
+ * @GST_LOGO_BLEND_SPACE_GAMMA: the samples are blended as they are,
+ *     gamma encoded.
+ * @GST_LOGO_BLEND_SPACE_LINEAR: luma and R, G and B samples are blended in
+ *     linear light, chroma and alpha samples as they are.
+ *
+ * How the logo is mixed with the frame. Blending gamma encoded samples
+ * darkens anti-aliased edges and translucent areas; linear light keeps
+ * their brightness at the cost of two table lookups per sample.
+ */
+typedef enum
+{
+  GST_LOGO_BLEND_SPACE_GAMMA,
+  GST_LOGO_BLEND_SPACE_LINEAR
+} GstLogoBlendSpace;
+
+#define GST_TYPE_LOGO_BLEND_SPACE (gst_logo_blend_space_get_type ())
+GType gst_logo_blend_space_get_type (void);
+
+/**
+ * GstLogoSpanKind:
+ * @GST_LOGO_SPAN_OPAQUE: every sample of the span has full coverage and is
+ *     simply copied into the frame.
+ * @GST_LOGO_SPAN_BLEND: the span has partial coverage and is blended.
+ *
+ * Classification of a run of samples in a sprite row. Fully transparent runs
+ * are not stored at all, so they cost nothing when blending.
+ */
+typedef enum
+{
+  GST_LOGO_SPAN_OPAQUE,
+  GST_LOGO_SPAN_BLEND
+} GstLogoSpanKind;
+
+/**
+ * GstLogoSpan:
+ * @start: first sample of the span in the sprite row.
+ * @len: number of samples in the span.
+ * @kind: a #GstLogoSpanKind.
+ */
+typedef struct
+{
+  guint32 start;
+  guint32 len;
+  guint32 kind;
+} GstLogoSpan;
+
+/**
+ * GstLogoSpritePlane:
+ * @x_sub: horizontal subsampling of the plane (log2), relative to luma.
+ * @y_sub: vertical subsampling of the plane (log2), relative to luma.
+ * @pstride: samples per unit of 1 << @x_sub luma pixels in the plane.
+ * @bytes: size of a sample, 1 or 2 for high bit depth formats.
+ * @shift: bits the value of a 16 bit sample is shifted left by.
+ * @linear_mask: bit n is set if sample n of a unit is luma, R, G or B,
+ *     the samples blended in linear light.
+ * @width: length of a sprite row in samples.
+ * @height: number of rows.
+ * @pixels: premultiplied samples laid out exactly like the frame plane, in
+ *     native endianness for 16 bit samples.
+ * @alpha: 8 bit coverage of every sample in @pixels.
+ * @row_spans: @height + 1 offsets into @spans, one run list per row.
+ * @spans: the span index of the plane.
+ *
+ * One plane of a sprite, pre-converted to the layout of the destination
+ * plane so a row is blended sample by sample without any conversion.
+ */
+typedef struct
+{
+  guint x_sub;
+  guint y_sub;
+  guint pstride;
+  guint bytes;
+  guint shift;
+  guint linear_mask;
+  gint width;
+  gint height;
+  guint8 *pixels;
+  guint8 *alpha;
+  guint *row_spans;
+  GstLogoSpan *spans;
+} GstLogoSpritePlane;
+
+/**
+ * GstLogoSprite:
+ * @width: width of the logo in luma pixels.
+ * @height: height of the logo in luma pixels.
+ * @format: the video format the planes are laid out for.
+ * @colorimetry: the colorimetry the colours were converted to.
+ * @n_planes: number of planes in @planes.
+ * @planes: the per-plane sprite data.
+ * @mip: the logo at half the size as the next level of the mip pyramid,
+ *     or NULL.
+ *
+ * A logo converted once to premultiplied YUVA or RGBA in the layout of the
+ * negotiated video format, together with a span index per row.
+ */
+typedef struct _GstLogoSprite GstLogoSprite;
+
+struct _GstLogoSprite
+{
+  gint width;
+  gint height;
+  GstVideoFormat format;
+  GstVideoColorimetry colorimetry;
+  guint n_planes;
+  GstLogoSpritePlane planes[GST_VIDEO_MAX_PLANES];
+  GstLogoSprite *mip;
+};
+
+/**
+ * GstLogoPlacement:
+ * @sprite: the sprite to blend.
+ * @x: horizontal position in luma pixels.
+ * @y: vertical position in luma pixels.
+ * @alpha: global opacity, 0 to 255.
+ * @width: width in luma pixels the sprite is resampled to while it is
+ *     blended, 0 for the size of the sprite.
+ * @height: height in luma pixels the sprite is resampled to, 0 for the
+ *     size of the sprite.
+ *
+ * One sprite of a layer stack and where it goes in the frame.
+ */
+typedef struct
+{
+  const GstLogoSprite *sprite;
+  gint x;
+  gint y;
+  guint alpha;
+  gint width;
+  gint height;
+} GstLogoPlacement;
+
+/**
+ * GstLogoBlendCounts:
+ * @opaque: pixels of opaque spans copied at full opacity.
+ * @mixed: pixels of opaque spans mixed at a global opacity.
+ * @blended: pixels of blend spans at full opacity.
+ * @faded: pixels of blend spans at a global opacity.
+ *
+ * How many pixels of the first plane each blend kernel handled.
+ */
+typedef struct
+{
+  guint64 opaque;
+  guint64 mixed;
+  guint64 blended;
+  guint64 faded;
+} GstLogoBlendCounts;
+
+/**
+ * GstLogoTiling:
+ * @mode: the tile mode of the format.
+ * @width: bytes of a tile row.
+ * @height: rows of a tile.
+ * @size: bytes of a tile.
+ * @x_tiles: number of tiles in a row of the plane.
+ * @y_tiles: number of tile rows of the plane.
+ *
+ * The tile grid of one plane of a tiled frame.
+ */
+typedef struct
+{
+  GstVideoTileMode mode;
+  gint width;
+  gint height;
+  gsize size;
+  gint x_tiles;
+  gint y_tiles;
+} GstLogoTiling;
+
+/**
+ * GstLogoLightStats:
+ * @mean: mean light of a region, 0 for black to 1 for white.
+ * @stddev: standard deviation of the light, on the same scale.
+ *
+ * Statistics of the frame under a logo, see gst_logo_sprite_measure().
+ */
+typedef struct
+{
+  gdouble mean;
+  gdouble stddev;
+} GstLogoLightStats;
+
+gboolean gst_logo_sprite_supports_format (GstVideoFormat format);
+GstLogoSprite *gst_logo_sprite_new_from_surface (cairo_surface_t * surface,
+    GstVideoFormat format, const GstVideoColorimetry * colorimetry);
+GstLogoSprite *gst_logo_sprite_new_transformed (cairo_surface_t * surface,
+    gdouble degree, gdouble scale, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry);
+void gst_logo_sprite_add_mips (GstLogoSprite * sprite,
+    cairo_surface_t * surface);
+void gst_logo_sprite_free (GstLogoSprite * sprite);
+
+void gst_logo_sprite_blend (const GstLogoSprite * sprite,
+    GstVideoFrame * frame, gint x, gint y, guint alpha);
+void gst_logo_sprite_blend_layers (const GstLogoPlacement * placements,
+    guint n_placements, GstVideoFrame * frame, GstLogoBlendSpace space,
+    GstLogoBlendCounts * counts);
+void gst_logo_sprite_tiling_init (GstLogoTiling * tiling,
+    GstVideoFrame * frame, guint plane);
+guint8 *gst_logo_sprite_tiling_get (const GstLogoTiling * tiling,
+    guint8 * data, gint x, gint row);
+gboolean gst_logo_sprite_measure (GstVideoFrame * frame, gint x, gint y,
+    gint width, gint height, GstLogoLightStats * stats);
+gdouble gst_logo_sprite_get_light (const GstLogoSprite * sprite);
+const gchar *gst_logo_sprite_kernel_name (void);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_SPRITE_H__ */
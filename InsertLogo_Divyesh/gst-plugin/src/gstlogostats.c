@@ -0,0 +1,232 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:gstlogostats
+ *
+ * Per instance statistics of the blend cost: frames rendered and passed
+ * through, pixels per blend kernel, a histogram of the time per frame,
+ * sprite reuse and the latency to the first frame. The streaming thread
+ * only adds to pointer sized counters with atomic operations and readers
+ * take a snapshot the same way, so neither side ever blocks the other.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogostats.h"
+#include <string.h>
+
+#define GST_LOGO_STATS_GET(field) ((guint64) (gsize) g_atomic_pointer_get (&(field)))
+
+/* Histogram bucket of a time in nanoseconds */
+static guint
+gst_logo_stats_bucket (guint64 ns)
+{
+  guint e;
+
+  if (ns < 16)
+    return ns;
+  e = g_bit_storage (ns) - 1;
+  return 16 + ((e - 4) << GST_LOGO_STATS_SUB_BITS) +
+      ((ns >> (e - GST_LOGO_STATS_SUB_BITS)) &
+      ((1 << GST_LOGO_STATS_SUB_BITS) - 1));
+}
+
+/* Largest time in nanoseconds that falls into a bucket */
+static guint64
+gst_logo_stats_bucket_max (guint bucket)
+{
+  guint e, sub;
+
+  if (bucket < 16)
+    return bucket;
+  e = ((bucket - 16) >> GST_LOGO_STATS_SUB_BITS) + 4;
+  sub = (bucket - 16) & ((1 << GST_LOGO_STATS_SUB_BITS) - 1);
+  return ((((guint64) 1 << GST_LOGO_STATS_SUB_BITS) + sub + 1) <<
+      (e - GST_LOGO_STATS_SUB_BITS)) - 1;
+}
+
+/* Upper bound of the time per frame at quantile @q of a histogram */
+static guint64
+gst_logo_stats_quantile (const guint64 * buckets, guint64 total, gdouble q,
+    guint64 max)
+{
+  guint64 target = MAX (1, (guint64) (total * q + 0.999999)), seen = 0;
+  guint i;
+
+  if (total == 0)
+    return 0;
+  for (i = 0; i < GST_LOGO_STATS_N_BUCKETS; i++) {
+    seen += buckets[i];
+    if (seen >= target)
+      return MIN (gst_logo_stats_bucket_max (i), max);
+  }
+  return max;
+}
+
+/**
+ * @brief Clears all counters. Must not race with any other call.
+ *
+ * @param stats The statistics.
+ */
+void
+gst_logo_stats_reset (GstLogoStats * stats)
+{
+  memset (stats, 0, sizeof (GstLogoStats));
+}
+
+/**
+ * @brief Accounts a frame the overlay was rendered on.
+ *
+ * @param stats The statistics.
+ * @param time Time spent on the frame.
+ * @param counts Pixels blended per kernel.
+ */
+void
+gst_logo_stats_add_frame (GstLogoStats * stats, GstClockTime time,
+    const GstLogoBlendCounts * counts)
+{
+  guint64 max;
+
+  g_atomic_pointer_add (&stats->frames, 1);
+  g_atomic_pointer_add (&stats->opaque, counts->opaque);
+  g_atomic_pointer_add (&stats->mixed, counts->mixed);
+  g_atomic_pointer_add (&stats->blended, counts->blended);
+  g_atomic_pointer_add (&stats->faded, counts->faded);
+  g_atomic_pointer_add (&stats->buckets[gst_logo_stats_bucket (time)], 1);
+
+  /* Only the streaming thread writes, so adding the difference stores the
+   * new maximum without a lost update */
+  max = GST_LOGO_STATS_GET (stats->max_ns);
+  if (time > max)
+    g_atomic_pointer_add (&stats->max_ns, (gsize) (MIN (time, G_MAXSIZE) - max));
+}
+
+/**
+ * @brief Accounts a frame pushed untouched.
+ *
+ * @param stats The statistics.
+ */
+void
+gst_logo_stats_add_passthrough (GstLogoStats * stats)
+{
+  g_atomic_pointer_add (&stats->passthrough, 1);
+}
+
+/**
+ * @brief Accounts a rotated or scaled sprite.
+ *
+ * @param stats The statistics.
+ * @param hit Whether the sprite was reused from an earlier frame.
+ */
+void
+gst_logo_stats_add_sprite (GstLogoStats * stats, gboolean hit)
+{
+  g_atomic_pointer_add (hit ? &stats->sprite_hits : &stats->sprite_misses, 1);
+}
+
+/**
+ * @brief Records the latency to the first rendered frame once.
+ *
+ * @param stats The statistics.
+ * @param latency Time from the caps to the first rendered frame.
+ */
+void
+gst_logo_stats_set_first_frame (GstLogoStats * stats, GstClockTime latency)
+{
+  /* Only the streaming thread writes */
+  if (GST_LOGO_STATS_GET (stats->first_frame) == 0)
+    g_atomic_pointer_add (&stats->first_frame,
+        (gsize) CLAMP (latency, 1, G_MAXSIZE));
+}
+
+/**
+ * @brief Takes a snapshot of the statistics.
+ *
+ * The fields are frames, passthrough-frames, opaque-pixels, mixed-pixels,
+ * blended-pixels and faded-pixels, ns-per-frame-p50, -p99 and -max,
+ * sprite-cache-hits and sprite-cache-misses, and first-frame-latency in
+ * nanoseconds, or GST_CLOCK_TIME_NONE before the first frame.
+ *
+ * @param stats The statistics.
+ * @return A new structure named GST_LOGO_STATS_NAME.
+ */
+GstStructure *
+gst_logo_stats_to_structure (GstLogoStats * stats)
+{
+  guint64 buckets[GST_LOGO_STATS_N_BUCKETS];
+  guint64 total = 0, max, first;
+  guint i;
+
+  for (i = 0; i < GST_LOGO_STATS_N_BUCKETS; i++) {
+    buckets[i] = GST_LOGO_STATS_GET (stats->buckets[i]);
+    total += buckets[i];
+  }
+  max = GST_LOGO_STATS_GET (stats->max_ns);
+  first = GST_LOGO_STATS_GET (stats->first_frame);
+
+  return gst_structure_new (GST_LOGO_STATS_NAME,
+      "frames", G_TYPE_UINT64, GST_LOGO_STATS_GET (stats->frames),
+      "passthrough-frames", G_TYPE_UINT64,
+      GST_LOGO_STATS_GET (stats->passthrough),
+      "opaque-pixels", G_TYPE_UINT64, GST_LOGO_STATS_GET (stats->opaque),
+      "mixed-pixels", G_TYPE_UINT64, GST_LOGO_STATS_GET (stats->mixed),
+      "blended-pixels", G_TYPE_UINT64, GST_LOGO_STATS_GET (stats->blended),
+      "faded-pixels", G_TYPE_UINT64, GST_LOGO_STATS_GET (stats->faded),
+      "ns-per-frame-p50", G_TYPE_UINT64,
+      gst_logo_stats_quantile (buckets, total, 0.50, max),
+      "ns-per-frame-p99", G_TYPE_UINT64,
+      gst_logo_stats_quantile (buckets, total, 0.99, max),
+      "ns-per-frame-max", G_TYPE_UINT64, max,
+      "sprite-cache-hits", G_TYPE_UINT64,
+      GST_LOGO_STATS_GET (stats->sprite_hits),
+      "sprite-cache-misses", G_TYPE_UINT64,
+      GST_LOGO_STATS_GET (stats->sprite_misses),
+      "first-frame-latency", G_TYPE_UINT64,
+      first ? first : GST_CLOCK_TIME_NONE,
+      "kernel", G_TYPE_STRING, gst_logo_sprite_kernel_name (), NULL);
+}
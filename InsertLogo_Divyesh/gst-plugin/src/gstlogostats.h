@@ -0,0 +1,106 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_STATS_H__
+#define __GST_LOGO_STATS_H__
+
+#include <gst/gst.h>
+#include "gstlogosprite.h"
+
+G_BEGIN_DECLS
+
+/* Name of the statistics structure and of the element messages */
+#define GST_LOGO_STATS_NAME "insert-logo-stats"
+
+/* Exact buckets below 16 ns, then 8 buckets per power of two */
+#define GST_LOGO_STATS_SUB_BITS 3
+#define GST_LOGO_STATS_N_BUCKETS (16 + (64 - 4) * (1 << GST_LOGO_STATS_SUB_BITS))
+
+/**
+ * GstLogoStats:
+ * @frames: frames the overlay was rendered on.
+ * @passthrough: frames pushed untouched.
+ * @opaque: pixels of opaque spans copied at full opacity.
+ * @mixed: pixels of opaque spans mixed at a global opacity.
+ * @blended: pixels of blend spans at full opacity.
+ * @faded: pixels of blend spans at a global opacity.
+ * @sprite_hits: rotated or scaled sprites reused from an earlier frame.
+ * @sprite_misses: rotated or scaled sprites drawn for the frame.
+ * @first_frame: nanoseconds from the caps to the first rendered frame, 0
+ *     until then.
+ * @max_ns: the slowest frame in nanoseconds.
+ * @buckets: histogram of the nanoseconds per rendered frame.
+ *
+ * Counters of one element instance. They are written by the streaming
+ * thread and read by any thread with atomic operations only, so no lock is
+ * taken on either side. Every counter is pointer sized.
+ */
+typedef struct
+{
+  gsize frames;
+  gsize passthrough;
+  gsize opaque;
+  gsize mixed;
+  gsize blended;
+  gsize faded;
+  gsize sprite_hits;
+  gsize sprite_misses;
+  gsize first_frame;
+  gsize max_ns;
+  gsize buckets[GST_LOGO_STATS_N_BUCKETS];
+} GstLogoStats;
+
+void gst_logo_stats_reset (GstLogoStats * stats);
+void gst_logo_stats_add_frame (GstLogoStats * stats, GstClockTime time,
+    const GstLogoBlendCounts * counts);
+void gst_logo_stats_add_passthrough (GstLogoStats * stats);
+void gst_logo_stats_add_sprite (GstLogoStats * stats, gboolean hit);
+void gst_logo_stats_set_first_frame (GstLogoStats * stats,
+    GstClockTime latency);
+GstStructure *gst_logo_stats_to_structure (GstLogoStats * stats);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_STATS_H__ */
@@ -0,0 +1,331 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "gstlogotext.h"
+
+/* Rounds up to the next even number of pixels */
+#define GST_LOGO_TEXT_EVEN(v) (((gint) ceil (v) + 1) & ~1)
+
+/**
+ * @brief Selects the cairo font face of a font description.
+ *
+ * The description is a family name optionally followed by "Bold" and/or
+ * "Italic", e.g. "Sans Bold".
+ */
+static void
+gst_logo_text_select_font (cairo_t * cr, const gchar * font, gint size)
+{
+  cairo_font_weight_t weight = CAIRO_FONT_WEIGHT_NORMAL;
+  cairo_font_slant_t slant = CAIRO_FONT_SLANT_NORMAL;
+  gchar *family = g_strdup (font);
+  gchar *word;
+
+  while ((word = strrchr (family, ' ')) != NULL) {
+    if (g_ascii_strcasecmp (word + 1, "bold") == 0)
+      weight = CAIRO_FONT_WEIGHT_BOLD;
+    else if (g_ascii_strcasecmp (word + 1, "italic") == 0)
+      slant = CAIRO_FONT_SLANT_ITALIC;
+    else
+      break;
+    *word = '\0';
+  }
+
+  cairo_select_font_face (cr, family, slant, weight);
+  cairo_set_font_size (cr, size);
+  g_free (family);
+}
+
+/**
+ * @brief Rasterizes the glyphs of a font and converts them for blending.
+ *
+ * @param font The font family, optionally followed by "Bold" and/or "Italic".
+ * @param size The font size in pixels.
+ * @param color The text colour as 0xAARRGGBB.
+ * @param format The video format the glyph sprites are built for.
+ * @param colorimetry The colorimetry the glyph sprites are built for.
+ * @return A new atlas.
+ */
+GstLogoGlyphAtlas *
+gst_logo_glyph_atlas_new (const gchar * font, gint size, guint32 color,
+    GstVideoFormat format, const GstVideoColorimetry * colorimetry)
+{
+  GstLogoGlyphAtlas *atlas = g_new0 (GstLogoGlyphAtlas, 1);
+  cairo_surface_t *surface;
+  cairo_font_extents_t font_extents;
+  cairo_t *cr;
+  guint i;
+
+  atlas->ref_count = 1;
+  atlas->font = g_strdup (font);
+  atlas->size = size;
+  atlas->color = color;
+  atlas->format = format;
+  atlas->colorimetry = *colorimetry;
+
+  /* Scratch context to measure the font */
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 1, 1);
+  cr = cairo_create (surface);
+  gst_logo_text_select_font (cr, font, size);
+  cairo_font_extents (cr, &font_extents);
+  cairo_destroy (cr);
+  cairo_surface_destroy (surface);
+
+  atlas->height = GST_LOGO_TEXT_EVEN (font_extents.ascent +
+      font_extents.descent);
+
+  for (i = 0; i < GST_LOGO_TEXT_N_GLYPHS; i++) {
+    GstLogoGlyph *glyph = &atlas->glyphs[i];
+    cairo_text_extents_t extents;
+    gchar str[2] = { GST_LOGO_TEXT_FIRST_GLYPH + i, '\0' };
+    gint width;
+
+    surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 1, 1);
+    cr = cairo_create (surface);
+    gst_logo_text_select_font (cr, font, size);
+    cairo_text_extents (cr, str, &extents);
+    cairo_destroy (cr);
+    cairo_surface_destroy (surface);
+
+    glyph->advance = GST_LOGO_TEXT_EVEN (extents.x_advance);
+    width = MAX (glyph->advance,
+        GST_LOGO_TEXT_EVEN (extents.x_bearing + extents.width));
+
+    surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width,
+        atlas->height);
+    cr = cairo_create (surface);
+    gst_logo_text_select_font (cr, font, size);
+    cairo_set_source_rgba (cr, ((color >> 16) & 0xff) / 255.0,
+        ((color >> 8) & 0xff) / 255.0, (color & 0xff) / 255.0,
+        (color >> 24) / 255.0);
+    cairo_move_to (cr, 0, font_extents.ascent);
+    cairo_show_text (cr, str);
+    cairo_destroy (cr);
+
+    glyph->sprite = gst_logo_sprite_new_from_surface (surface, format,
+        colorimetry);
+    cairo_surface_destroy (surface);
+  }
+
+  return atlas;
+}
+
+/**
+ * @brief Takes a reference on a glyph atlas.
+ */
+GstLogoGlyphAtlas *
+gst_logo_glyph_atlas_ref (GstLogoGlyphAtlas * atlas)
+{
+  g_atomic_int_inc (&atlas->ref_count);
+  return atlas;
+}
+
+/**
+ * @brief Drops a reference on a glyph atlas, freeing it with the last one.
+ */
+void
+gst_logo_glyph_atlas_unref (GstLogoGlyphAtlas * atlas)
+{
+  guint i;
+
+  if (atlas == NULL || !g_atomic_int_dec_and_test (&atlas->ref_count))
+    return;
+
+  for (i = 0; i < GST_LOGO_TEXT_N_GLYPHS; i++)
+    gst_logo_sprite_free (atlas->glyphs[i].sprite);
+  g_free (atlas->font);
+  g_free (atlas);
+}
+
+/**
+ * @brief Checks whether an atlas was rasterized with the given font for
+ * the given format and colorimetry.
+ */
+gboolean
+gst_logo_glyph_atlas_matches (const GstLogoGlyphAtlas * atlas,
+    const gchar * font, gint size, guint32 color, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry)
+{
+  return g_strcmp0 (atlas->font, font) == 0 && atlas->size == size
+      && atlas->color == color && atlas->format == format
+      && gst_video_colorimetry_is_equal (&atlas->colorimetry, colorimetry);
+}
+
+/* Characters outside of the atlas are drawn as '?' */
+static const GstLogoGlyph *
+gst_logo_glyph_atlas_lookup (const GstLogoGlyphAtlas * atlas, gunichar c)
+{
+  if (c < GST_LOGO_TEXT_FIRST_GLYPH
+      || c >= GST_LOGO_TEXT_FIRST_GLYPH + GST_LOGO_TEXT_N_GLYPHS)
+    c = '?';
+  return &atlas->glyphs[c - GST_LOGO_TEXT_FIRST_GLYPH];
+}
+
+/**
+ * @brief Measures the width of a line of text.
+ *
+ * @param atlas The glyph atlas.
+ * @param text UTF-8 text.
+ * @return The sum of the glyph advances in pixels.
+ */
+gint
+gst_logo_glyph_atlas_measure (const GstLogoGlyphAtlas * atlas,
+    const gchar * text)
+{
+  gint width = 0;
+
+  for (; *text; text = g_utf8_next_char (text))
+    width += gst_logo_glyph_atlas_lookup (atlas,
+        g_utf8_get_char (text))->advance;
+
+  return width;
+}
+
+/**
+ * @brief Queues the glyph sprites of a line of text for blending.
+ *
+ * @param atlas The glyph atlas, must stay alive until the placements are
+ *     blended.
+ * @param text UTF-8 text.
+ * @param x Horizontal position of the text in luma pixels.
+ * @param y Vertical position of the top of the text in luma pixels.
+ * @param alpha Global opacity of the text, 0 to 255.
+ * @param placements Array of #GstLogoPlacement to append to.
+ */
+void
+gst_logo_glyph_atlas_layout (const GstLogoGlyphAtlas * atlas,
+    const gchar * text, gint x, gint y, guint alpha, GArray * placements)
+{
+  GstLogoPlacement placement;
+
+  placement.x = x & ~1;
+  placement.y = y;
+  placement.alpha = alpha;
+  placement.width = 0;
+  placement.height = 0;
+
+  for (; *text; text = g_utf8_next_char (text)) {
+    const GstLogoGlyph *glyph = gst_logo_glyph_atlas_lookup (atlas,
+        g_utf8_get_char (text));
+
+    /* Blanks have no visible spans */
+    if (glyph->sprite->planes[0].row_spans[glyph->sprite->height] > 0) {
+      placement.sprite = glyph->sprite;
+      g_array_append_val (placements, placement);
+    }
+    placement.x += glyph->advance;
+  }
+}
+
+/**
+ * @brief Expands the placeholders of a text layer for one frame.
+ *
+ * "%T" is replaced by the timecode HH:MM:SS:FF of @pts, "%C" by the local
+ * wall-clock time HH:MM:SS and "%%" by a single '%'.
+ *
+ * @param format The text with placeholders.
+ * @param pts Presentation timestamp of the frame.
+ * @param fps_n Framerate numerator, 0 if unknown.
+ * @param fps_d Framerate denominator.
+ * @param text Return location for the expanded text, reused between frames.
+ */
+void
+gst_logo_text_expand (const gchar * format, GstClockTime pts, gint fps_n,
+    gint fps_d, GString * text)
+{
+  const gchar *p;
+
+  g_string_truncate (text, 0);
+
+  for (p = format; *p; p++) {
+    if (p[0] != '%' || p[1] == '\0') {
+      g_string_append_c (text, *p);
+      continue;
+    }
+
+    switch (*++p) {
+      case 'T':
+        if (!GST_CLOCK_TIME_IS_VALID (pts)) {
+          g_string_append (text, "--:--:--:--");
+        } else if (fps_n > 0 && fps_d > 0) {
+          /* Non-drop-frame timecode */
+          guint64 fps = (fps_n + fps_d - 1) / fps_d;
+          guint64 frames = gst_util_uint64_scale (pts, fps_n,
+              (guint64) fps_d * GST_SECOND);
+          guint64 secs = frames / fps;
+
+          g_string_append_printf (text, "%02u:%02u:%02u:%02u",
+              (guint) (secs / 3600), (guint) (secs / 60 % 60),
+              (guint) (secs % 60), (guint) (frames % fps));
+        } else {
+          guint64 secs = pts / GST_SECOND;
+
+          g_string_append_printf (text, "%02u:%02u:%02u:--",
+              (guint) (secs / 3600), (guint) (secs / 60 % 60),
+              (guint) (secs % 60));
+        }
+        break;
+      case 'C':
+      {
+        GDateTime *now = g_date_time_new_now_local ();
+
+        g_string_append_printf (text, "%02d:%02d:%02d",
+            g_date_time_get_hour (now), g_date_time_get_minute (now),
+            g_date_time_get_second (now));
+        g_date_time_unref (now);
+        break;
+      }
+      case '%':
+        g_string_append_c (text, '%');
+        break;
+      default:
+        g_string_append_c (text, '%');
+        g_string_append_c (text, *p);
+        break;
+    }
+  }
+}
@@ -0,0 +1,118 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_TEXT_H__
+#define __GST_LOGO_TEXT_H__
+
+#include <gst/gst.h>
+#include <cairo.h>
+
+#include "gstlogosprite.h"
+
+G_BEGIN_DECLS
+
+/* The atlas covers the printable ASCII characters */
+#define GST_LOGO_TEXT_FIRST_GLYPH 0x20
+#define GST_LOGO_TEXT_N_GLYPHS 95
+
+/**
+ * GstLogoGlyph:
+ * @advance: horizontal distance to the next glyph, rounded up to an even
+ *     number of pixels so every glyph starts on a chroma sample.
+ * @sprite: the glyph converted for blending.
+ */
+typedef struct
+{
+  gint advance;
+  GstLogoSprite *sprite;
+} GstLogoGlyph;
+
+/**
+ * GstLogoGlyphAtlas:
+ * @ref_count: reference count, see gst_logo_glyph_atlas_ref().
+ * @font: the font family, optionally followed by "Bold" and/or "Italic".
+ * @size: the font size in pixels.
+ * @color: the text colour as 0xAARRGGBB.
+ * @format: the video format the glyph sprites are built for.
+ * @colorimetry: the colorimetry the glyph sprites are built for.
+ * @height: height of every glyph sprite.
+ * @glyphs: one glyph per character starting at GST_LOGO_TEXT_FIRST_GLYPH.
+ *
+ * Glyphs of one font rasterized by cairo and converted for blending once.
+ * Text is composed per frame from the cached glyph sprites, so changing
+ * text costs no rasterization. Atlases are immutable once created.
+ */
+typedef struct
+{
+  gint ref_count;
+  gchar *font;
+  gint size;
+  guint32 color;
+  GstVideoFormat format;
+  GstVideoColorimetry colorimetry;
+  gint height;
+  GstLogoGlyph glyphs[GST_LOGO_TEXT_N_GLYPHS];
+} GstLogoGlyphAtlas;
+
+GstLogoGlyphAtlas *gst_logo_glyph_atlas_new (const gchar * font, gint size,
+    guint32 color, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry);
+GstLogoGlyphAtlas *gst_logo_glyph_atlas_ref (GstLogoGlyphAtlas * atlas);
+void gst_logo_glyph_atlas_unref (GstLogoGlyphAtlas * atlas);
+gboolean gst_logo_glyph_atlas_matches (const GstLogoGlyphAtlas * atlas,
+    const gchar * font, gint size, guint32 color, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry);
+
+gint gst_logo_glyph_atlas_measure (const GstLogoGlyphAtlas * atlas,
+    const gchar * text);
+void gst_logo_glyph_atlas_layout (const GstLogoGlyphAtlas * atlas,
+    const gchar * text, gint x, gint y, guint alpha, GArray * placements);
+
+void gst_logo_text_expand (const gchar * format, GstClockTime pts,
+    gint fps_n, gint fps_d, GString * text);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_TEXT_H__ */
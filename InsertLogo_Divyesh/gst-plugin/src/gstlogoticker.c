@@ -0,0 +1,622 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+/**
+ * SECTION:gstlogoticker
+ *
+ * A news ticker that crawls a pre-rendered strip, which may be tens of
+ * thousands of pixels wide, from right to left through a band of the
+ * frame. A worker thread decodes the strip once, row by row, and writes
+ * every row straight into column tiles of GST_LOGO_TICKER_TILE_WIDTH
+ * pixels in an unlinked temporary file that is mapped into memory. Only
+ * one row of the strip is ever held in the heap, so neither the decoder
+ * nor cairo limit its width, and the tiles that are not on screen live in
+ * the page cache. Only the tiles in
+ * the band are converted to sprites; a tile is converted once when it
+ * scrolls in and freed when it has scrolled out. The work per frame and
+ * the memory held therefore follow the band, not the length of the strip.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogoticker.h"
+#include <glib/gstdio.h>
+#include <cairo.h>
+#include <errno.h>
+#include <png.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/* One visible tile converted for blending */
+typedef struct
+{
+  gint tile;
+  GstLogoSprite *sprite;
+} GstLogoTickerSlot;
+
+/* The strip cut into column tiles of premultiplied ARGB32, tile after tile
+ * in @file, every tile GST_LOGO_TICKER_TILE_WIDTH pixels wide */
+typedef struct
+{
+  guint generation;
+  gint width;
+  gint height;
+  gint n_tiles;
+  GMappedFile *file;
+
+  /* only touched by the streaming thread */
+  GstVideoFormat format;
+  GstVideoColorimetry colorimetry;
+  GArray *slots;
+} GstLogoTickerStrip;
+
+struct _GstLogoTicker
+{
+  GMutex lock;
+  GThreadPool *pool;
+
+  /* protected by lock */
+  gchar *path;
+  guint generation;
+  GstLogoTickerStrip *pending;
+
+  /* only touched by the streaming thread */
+  GstLogoTickerStrip *strip;
+  GstLogoSprite *band;
+  gint band_width;
+  gint band_height;
+  guint32 band_color;
+};
+
+static void
+gst_logo_ticker_strip_free (GstLogoTickerStrip * strip)
+{
+  guint i;
+
+  if (strip == NULL)
+    return;
+
+  for (i = 0; i < strip->slots->len; i++)
+    gst_logo_sprite_free (g_array_index (strip->slots, GstLogoTickerSlot,
+            i).sprite);
+  g_array_free (strip->slots, TRUE);
+  g_mapped_file_unref (strip->file);
+  g_free (strip);
+}
+
+/* Writes all of @data at @offset, retrying on interruptions */
+static gboolean
+gst_logo_ticker_pwrite (gint fd, const guint8 * data, gsize size,
+    goffset offset)
+{
+  while (size > 0) {
+    gssize n = pwrite (fd, data, size, offset);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return FALSE;
+    data += n;
+    size -= n;
+    offset += n;
+  }
+  return TRUE;
+}
+
+/* Reads all of @size bytes at @offset, retrying on interruptions */
+static gboolean
+gst_logo_ticker_pread (gint fd, guint8 * data, gsize size, goffset offset)
+{
+  while (size > 0) {
+    gssize n = pread (fd, data, size, offset);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return FALSE;
+    data += n;
+    size -= n;
+    offset += n;
+  }
+  return TRUE;
+}
+
+/* Offset of a row of a tile in the tile file */
+static goffset
+gst_logo_ticker_tile_offset (gint height, gint t, gint row)
+{
+  gsize tile_stride = GST_LOGO_TICKER_TILE_WIDTH * 4;
+
+  return ((goffset) t * height + row) * tile_stride;
+}
+
+/* Converts a decoded RGBA row to the premultiplied native endian ARGB32 of
+ * cairo, in place */
+static void
+gst_logo_ticker_premultiply (guint8 * row, gint width)
+{
+  gint x;
+
+  for (x = 0; x < width; x++, row += 4) {
+    guint a = row[3];
+    guint32 pixel = (a << 24)
+        | ((row[0] * a + 127) / 255) << 16
+        | ((row[1] * a + 127) / 255) << 8 | (row[2] * a + 127) / 255;
+
+    memcpy (row, &pixel, 4);
+  }
+}
+
+/* Reads or writes one row of the strip, cut into the tiles it spans */
+static gboolean
+gst_logo_ticker_row_io (gint fd, guint8 * row, gint width, gint height,
+    gint y, gboolean write)
+{
+  gint t, x;
+
+  for (t = 0, x = 0; x < width; t++, x += GST_LOGO_TICKER_TILE_WIDTH) {
+    gsize size = MIN (GST_LOGO_TICKER_TILE_WIDTH, width - x) * 4;
+    goffset offset = gst_logo_ticker_tile_offset (height, t, y);
+
+    if (write ? !gst_logo_ticker_pwrite (fd, row + (gsize) x * 4, size, offset)
+        : !gst_logo_ticker_pread (fd, row + (gsize) x * 4, size, offset))
+      return FALSE;
+  }
+  return TRUE;
+}
+
+static void
+gst_logo_ticker_png_warning (png_structp png, png_const_charp message)
+{
+}
+
+/* Decodes the PNG at @path row by row into the tiles of @fd, which is
+ * sized for @width and @height first. The tiles past the strip stay
+ * transparent. */
+static gboolean
+gst_logo_ticker_decode (const gchar * path, gint fd, gint * width,
+    gint * height)
+{
+  png_structp png;
+  png_infop info;
+  FILE *file;
+  guint8 *volatile row = NULL;
+  guint8 *volatile pass_row = NULL;
+  volatile gboolean ok = FALSE;
+  gint passes, pass, x, y, n_tiles;
+  png_uint_32 w, h;
+
+  file = g_fopen (path, "rb");
+  if (file == NULL)
+    return FALSE;
+  png = png_create_read_struct (PNG_LIBPNG_VER_STRING, NULL, NULL,
+      gst_logo_ticker_png_warning);
+  info = png ? png_create_info_struct (png) : NULL;
+  if (info == NULL) {
+    png_destroy_read_struct (&png, NULL, NULL);
+    fclose (file);
+    return FALSE;
+  }
+  if (setjmp (png_jmpbuf (png)))
+    goto done;
+
+  png_init_io (png, file);
+  /* Lift the default limit of libpng, the strip is never held in full */
+  png_set_user_limits (png, G_MAXINT, GST_LOGO_TICKER_MAX_HEIGHT);
+  png_read_info (png, info);
+  w = png_get_image_width (png, info);
+  h = png_get_image_height (png, info);
+  if (w > G_MAXINT - GST_LOGO_TICKER_TILE_WIDTH
+      || h > GST_LOGO_TICKER_MAX_HEIGHT)
+    goto done;
+
+  /* Any PNG to 8 bit RGBA */
+  png_set_expand (png);
+  png_set_strip_16 (png);
+  png_set_gray_to_rgb (png);
+  png_set_filler (png, 0xff, PNG_FILLER_AFTER);
+  passes = png_set_interlace_handling (png);
+  png_read_update_info (png, info);
+
+  *width = w;
+  *height = h;
+  n_tiles = (w + GST_LOGO_TICKER_TILE_WIDTH - 1) / GST_LOGO_TICKER_TILE_WIDTH;
+  if (ftruncate (fd, gst_logo_ticker_tile_offset (h, n_tiles, 0)) != 0)
+    goto done;
+
+  row = g_try_malloc ((gsize) w * 4);
+  if (row == NULL || (passes > 1 && (pass_row = g_try_malloc ((gsize) w * 4))
+          == NULL))
+    goto done;
+  if (passes == 1) {
+    for (y = 0; y < (gint) h; y++) {
+      png_read_row (png, row, NULL);
+      gst_logo_ticker_premultiply (row, w);
+      if (!gst_logo_ticker_row_io (fd, row, w, h, y, TRUE))
+        goto done;
+    }
+  } else {
+    /* Every interlaced pass fills in some pixels of some rows, the rest
+     * is read back from the tiles the previous passes wrote */
+    for (pass = 0; pass < passes; pass++) {
+      for (y = 0; y < (gint) h; y++) {
+        png_read_row (png, pass_row, NULL);
+        if (!PNG_ROW_IN_INTERLACE_PASS (y, pass))
+          continue;
+        gst_logo_ticker_premultiply (pass_row, w);
+        if (!gst_logo_ticker_row_io (fd, row, w, h, y, FALSE))
+          goto done;
+        for (x = PNG_PASS_START_COL (pass); x < (gint) w;
+            x += 1 << PNG_PASS_COL_SHIFT (pass))
+          memcpy (row + (gsize) x * 4, pass_row + (gsize) x * 4, 4);
+        if (!gst_logo_ticker_row_io (fd, row, w, h, y, TRUE))
+          goto done;
+      }
+    }
+  }
+  ok = TRUE;
+
+done:
+  g_free (row);
+  g_free (pass_row);
+  png_destroy_read_struct (&png, &info, NULL);
+  fclose (file);
+  return ok;
+}
+
+/**
+ * @brief Decodes a strip into mapped column tiles.
+ *
+ * The tiles are written to an unlinked temporary file as the rows are
+ * decoded, which goes away with its mapping. A strip may be as wide as a
+ * PNG allows and up to GST_LOGO_TICKER_MAX_HEIGHT pixels high.
+ *
+ * @param path Path of the PNG strip.
+ * @return The strip, or NULL with a warning if it could not be loaded.
+ */
+static GstLogoTickerStrip *
+gst_logo_ticker_strip_new (const gchar * path)
+{
+  GstLogoTickerStrip *strip;
+  GError *error = NULL;
+  gchar *name = NULL;
+  gint fd, width = 0, height = 0;
+
+  fd = g_file_open_tmp ("insertlogo-ticker-XXXXXX", &name, &error);
+  if (fd < 0) {
+    g_warning ("Could not store the ticker tiles: %s", error->message);
+    g_clear_error (&error);
+    return NULL;
+  }
+  g_unlink (name);
+  g_free (name);
+
+  if (!gst_logo_ticker_decode (path, fd, &width, &height)) {
+    g_warning ("Could not load the ticker strip '%s'. It must be a PNG file "
+        "of at most %d pixels high.", path, GST_LOGO_TICKER_MAX_HEIGHT);
+    close (fd);
+    return NULL;
+  }
+
+  strip = g_new0 (GstLogoTickerStrip, 1);
+  strip->width = width;
+  strip->height = height;
+  strip->n_tiles = (width + GST_LOGO_TICKER_TILE_WIDTH - 1)
+      / GST_LOGO_TICKER_TILE_WIDTH;
+  strip->file = g_mapped_file_new_from_fd (fd, FALSE, &error);
+  close (fd);
+  if (strip->file == NULL) {
+    g_warning ("Could not store the ticker tiles: %s", error->message);
+    g_clear_error (&error);
+    g_free (strip);
+    return NULL;
+  }
+  strip->slots = g_array_new (FALSE, FALSE, sizeof (GstLogoTickerSlot));
+
+  return strip;
+}
+
+/**
+ * @brief Worker thread function, prepares the strip of one generation.
+ */
+static void
+gst_logo_ticker_worker (gpointer data, gpointer user_data)
+{
+  GstLogoTicker *ticker = user_data;
+  guint generation = GPOINTER_TO_UINT (data);
+  GstLogoTickerStrip *strip;
+  gchar *path;
+
+  g_mutex_lock (&ticker->lock);
+  if (generation != ticker->generation || ticker->path == NULL) {
+    g_mutex_unlock (&ticker->lock);
+    return;
+  }
+  path = g_strdup (ticker->path);
+  g_mutex_unlock (&ticker->lock);
+
+  strip = gst_logo_ticker_strip_new (path);
+  g_free (path);
+  if (strip != NULL)
+    strip->generation = generation;
+
+  g_mutex_lock (&ticker->lock);
+  if (strip != NULL && generation == ticker->generation) {
+    gst_logo_ticker_strip_free (ticker->pending);
+    ticker->pending = strip;
+    strip = NULL;
+  }
+  g_mutex_unlock (&ticker->lock);
+
+  gst_logo_ticker_strip_free (strip);
+}
+
+/**
+ * @brief Creates a ticker without a strip, with its own worker thread.
+ */
+GstLogoTicker *
+gst_logo_ticker_new (void)
+{
+  GstLogoTicker *ticker = g_new0 (GstLogoTicker, 1);
+
+  g_mutex_init (&ticker->lock);
+  ticker->pool = g_thread_pool_new (gst_logo_ticker_worker, ticker, 1, FALSE,
+      NULL);
+
+  return ticker;
+}
+
+/**
+ * @brief Frees the ticker, dropping pending jobs and waiting for the worker.
+ */
+void
+gst_logo_ticker_free (GstLogoTicker * ticker)
+{
+  if (ticker == NULL)
+    return;
+
+  g_thread_pool_free (ticker->pool, TRUE, TRUE);
+  gst_logo_ticker_strip_free (ticker->pending);
+  gst_logo_ticker_strip_free (ticker->strip);
+  gst_logo_sprite_free (ticker->band);
+  g_free (ticker->path);
+  g_mutex_clear (&ticker->lock);
+  g_free (ticker);
+}
+
+/**
+ * @brief Sets the strip and starts preparing it in the background.
+ *
+ * The current strip keeps crawling until the new one is ready; it is
+ * dropped at once if @path is NULL.
+ *
+ * @param ticker The ticker.
+ * @param path Path of the PNG strip, or NULL for no ticker.
+ */
+void
+gst_logo_ticker_set_source (GstLogoTicker * ticker, const gchar * path)
+{
+  g_mutex_lock (&ticker->lock);
+  if (g_strcmp0 (path, ticker->path) != 0) {
+    g_free (ticker->path);
+    ticker->path = g_strdup (path);
+    ticker->generation++;
+    gst_logo_ticker_strip_free (ticker->pending);
+    ticker->pending = NULL;
+    if (path != NULL)
+      g_thread_pool_push (ticker->pool,
+          GUINT_TO_POINTER (ticker->generation), NULL);
+  }
+  g_mutex_unlock (&ticker->lock);
+}
+
+/* Converts one tile of the strip for blending */
+static GstLogoSprite *
+gst_logo_ticker_tile_sprite (GstLogoTickerStrip * strip, gint t)
+{
+  gsize tile_stride = GST_LOGO_TICKER_TILE_WIDTH * 4;
+  guint8 *data = (guint8 *) g_mapped_file_get_contents (strip->file)
+      + t * tile_stride * strip->height;
+  gint w = MIN (GST_LOGO_TICKER_TILE_WIDTH,
+      strip->width - t * GST_LOGO_TICKER_TILE_WIDTH);
+  cairo_surface_t *surface;
+  GstLogoSprite *sprite;
+
+  surface = cairo_image_surface_create_for_data (data, CAIRO_FORMAT_ARGB32,
+      w, strip->height, tile_stride);
+  sprite = gst_logo_sprite_new_from_surface (surface, strip->format,
+      &strip->colorimetry);
+  cairo_surface_destroy (surface);
+
+  return sprite;
+}
+
+/* Converts the band background when its size, format or colour change */
+static void
+gst_logo_ticker_update_band (GstLogoTicker * ticker, gint width,
+    gint height, guint32 color, GstVideoFormat format,
+    const GstVideoColorimetry * colorimetry)
+{
+  cairo_surface_t *surface;
+  cairo_t *cr;
+
+  if (ticker->band != NULL && ticker->band_width == width
+      && ticker->band_height == height && ticker->band_color == color
+      && ticker->band->format == format
+      && gst_video_colorimetry_is_equal (&ticker->band->colorimetry,
+          colorimetry))
+    return;
+
+  gst_logo_sprite_free (ticker->band);
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+  cr = cairo_create (surface);
+  cairo_set_source_rgba (cr, ((color >> 16) & 0xff) / 255.0,
+      ((color >> 8) & 0xff) / 255.0, (color & 0xff) / 255.0,
+      (color >> 24) / 255.0);
+  cairo_paint (cr);
+  cairo_destroy (cr);
+  ticker->band = gst_logo_sprite_new_from_surface (surface, format,
+      colorimetry);
+  ticker->band_width = width;
+  ticker->band_height = height;
+  ticker->band_color = color;
+  cairo_surface_destroy (surface);
+}
+
+/**
+ * @brief Queues the tiles of the strip that are in the band for a frame.
+ *
+ * The strip enters at the right edge of the frame and starts over once it
+ * has left at the left edge. Tiles that scrolled out of the band since the
+ * previous call are freed, the ones that scrolled in are converted. The
+ * sprites stay valid until the next call or until the ticker is freed.
+ * Nothing is queued while the strip is being prepared.
+ *
+ * @param ticker The ticker.
+ * @param info The video info of the frame.
+ * @param running_time Running time of the frame.
+ * @param y Top of the band, -1 for the bottom of the frame.
+ * @param speed Speed of the crawl in pixels per second.
+ * @param background Colour of the band under the strip as 0xAARRGGBB.
+ * @param placements Array of #GstLogoPlacement to append to.
+ */
+void
+gst_logo_ticker_place (GstLogoTicker * ticker, const GstVideoInfo * info,
+    GstClockTime running_time, gint y, gdouble speed, guint32 background,
+    GArray * placements)
+{
+  gint frame_width = GST_VIDEO_INFO_WIDTH (info);
+  GstVideoFormat format = GST_VIDEO_INFO_FORMAT (info);
+  const GstVideoColorimetry *colorimetry = &GST_VIDEO_INFO_COLORIMETRY (info);
+  GstLogoTickerStrip *strip;
+  GstLogoPlacement placement = { NULL, 0, 0, 255, 0, 0 };
+  gint64 range, offset;
+  gint left, first, last, t;
+  guint i;
+
+  /* Take over a freshly prepared strip, drop one that was replaced */
+  g_mutex_lock (&ticker->lock);
+  if (ticker->pending != NULL) {
+    gst_logo_ticker_strip_free (ticker->strip);
+    ticker->strip = ticker->pending;
+    ticker->pending = NULL;
+  } else if (ticker->strip != NULL && ticker->path == NULL) {
+    gst_logo_ticker_strip_free (ticker->strip);
+    ticker->strip = NULL;
+  }
+  g_mutex_unlock (&ticker->lock);
+
+  strip = ticker->strip;
+  if (strip == NULL)
+    return;
+  if (y < 0)
+    y = GST_VIDEO_INFO_HEIGHT (info) - strip->height;
+
+  if ((background >> 24) > 0) {
+    gst_logo_ticker_update_band (ticker, frame_width, strip->height,
+        background, format, colorimetry);
+    placement.sprite = ticker->band;
+    placement.y = y;
+    g_array_append_val (placements, placement);
+  }
+
+  /* Sprites of another format cannot be reused */
+  if (strip->format != format
+      || !gst_video_colorimetry_is_equal (&strip->colorimetry, colorimetry)) {
+    for (i = 0; i < strip->slots->len; i++)
+      gst_logo_sprite_free (g_array_index (strip->slots, GstLogoTickerSlot,
+              i).sprite);
+    g_array_set_size (strip->slots, 0);
+    strip->format = format;
+    strip->colorimetry = *colorimetry;
+  }
+
+  /* Left edge of the strip in the frame */
+  range = (gint64) frame_width + strip->width;
+  offset = GST_CLOCK_TIME_IS_VALID (running_time) ?
+      (gint64) (speed * running_time / GST_SECOND) % range : 0;
+  left = frame_width - offset;
+
+  /* The tiles in the band */
+  first = MAX (0, -left) / GST_LOGO_TICKER_TILE_WIDTH;
+  last = MIN (strip->width, frame_width - left) - 1;
+  last = last < 0 ? -1 : last / GST_LOGO_TICKER_TILE_WIDTH;
+
+  for (i = 0; i < strip->slots->len;) {
+    GstLogoTickerSlot *slot = &g_array_index (strip->slots,
+        GstLogoTickerSlot, i);
+
+    if (slot->tile < first || slot->tile > last) {
+      gst_logo_sprite_free (slot->sprite);
+      g_array_remove_index_fast (strip->slots, i);
+    } else {
+      i++;
+    }
+  }
+
+  placement.y = y;
+  for (t = first; t <= last; t++) {
+    GstLogoTickerSlot *slot = NULL;
+
+    for (i = 0; i < strip->slots->len; i++) {
+      if (g_array_index (strip->slots, GstLogoTickerSlot, i).tile == t) {
+        slot = &g_array_index (strip->slots, GstLogoTickerSlot, i);
+        break;
+      }
+    }
+    if (slot == NULL) {
+      GstLogoTickerSlot fresh = { t, gst_logo_ticker_tile_sprite (strip, t) };
+
+      g_array_append_val (strip->slots, fresh);
+      slot = &g_array_index (strip->slots, GstLogoTickerSlot,
+          strip->slots->len - 1);
+    }
+    placement.sprite = slot->sprite;
+    placement.x = left + t * GST_LOGO_TICKER_TILE_WIDTH;
+    g_array_append_val (placements, placement);
+  }
+}
@@ -0,0 +1,75 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_TICKER_H__
+#define __GST_LOGO_TICKER_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#include "gstlogosprite.h"
+
+G_BEGIN_DECLS
+
+/* Width of the column tiles a strip is cut into, in pixels */
+#define GST_LOGO_TICKER_TILE_WIDTH 256
+
+/* Highest strip, in pixels, the tiles are cairo surfaces of its height.
+ * The width is only limited by the PNG format. */
+#define GST_LOGO_TICKER_MAX_HEIGHT 32767
+
+typedef struct _GstLogoTicker GstLogoTicker;
+
+GstLogoTicker *gst_logo_ticker_new (void);
+void gst_logo_ticker_free (GstLogoTicker * ticker);
+
+void gst_logo_ticker_set_source (GstLogoTicker * ticker, const gchar * path);
+void gst_logo_ticker_place (GstLogoTicker * ticker, const GstVideoInfo * info,
+    GstClockTime running_time, gint y, gdouble speed, guint32 background,
+    GArray * placements);
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_TICKER_H__ */
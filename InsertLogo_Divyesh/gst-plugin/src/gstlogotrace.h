@@ -0,0 +1,114 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_TRACE_H__
+#define __GST_LOGO_TRACE_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/* Object data of an insert_logo element holding its GstLogoTraceHooks.
+ * The tracer plugin sets it when the element is created; the element and
+ * the tracer share nothing else, so neither links against the other. */
+#define GST_LOGO_TRACE_QDATA "insert-logo-trace"
+
+/**
+ * GstLogoTraceStage:
+ * @GST_LOGO_TRACE_SPRITE: looking up the logo and drawing rotated or
+ *     scaled sprites, including any wait for the worker threads.
+ * @GST_LOGO_TRACE_ANIM: building and evaluating the animation timeline.
+ * @GST_LOGO_TRACE_BLEND: covering regions and blending all layers into the
+ *     frame.
+ * @GST_LOGO_TRACE_PUSH: pushing the buffer downstream.
+ *
+ * The stages of the element that are reported to a tracer.
+ */
+typedef enum
+{
+  GST_LOGO_TRACE_SPRITE,
+  GST_LOGO_TRACE_ANIM,
+  GST_LOGO_TRACE_BLEND,
+  GST_LOGO_TRACE_PUSH,
+  GST_LOGO_TRACE_N_STAGES
+} GstLogoTraceStage;
+
+/**
+ * GstLogoTraceHooks:
+ * @begin: called on the thread entering a stage.
+ * @end: called on the same thread leaving it. Stages may nest, a push can
+ *     run the stages of an element further downstream.
+ * @user_data: passed to @begin and @end.
+ *
+ * Callbacks of a tracer, installed on the element as GST_LOGO_TRACE_QDATA.
+ */
+typedef struct
+{
+  void (*begin) (gpointer user_data, GstElement * element,
+      GstLogoTraceStage stage);
+  void (*end) (gpointer user_data, GstElement * element,
+      GstLogoTraceStage stage);
+  gpointer user_data;
+} GstLogoTraceHooks;
+
+static inline void
+gst_logo_trace_begin (const GstLogoTraceHooks * hooks, gpointer element,
+    GstLogoTraceStage stage)
+{
+  if (G_UNLIKELY (hooks != NULL))
+    hooks->begin (hooks->user_data, GST_ELEMENT (element), stage);
+}
+
+static inline void
+gst_logo_trace_end (const GstLogoTraceHooks * hooks, gpointer element,
+    GstLogoTraceStage stage)
+{
+  if (G_UNLIKELY (hooks != NULL))
+    hooks->end (hooks->user_data, GST_ELEMENT (element), stage);
+}
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_TRACE_H__ */
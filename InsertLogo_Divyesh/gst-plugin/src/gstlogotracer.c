@@ -0,0 +1,341 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:tracer-insertlogo
+ *
+ * A tracer writing the internal stages of every insert_logo element as a
+ * Chrome trace JSON file that loads into Perfetto or chrome://tracing:
+ * sprite lookup (including waits for the worker threads), animation
+ * evaluation, blend and push. Every stage of every frame becomes a
+ * complete event with the thread it ran on, so many channels in one
+ * process can be compared side by side.
+ *
+ * |[
+ * GST_PLUGIN_PATH=<builddir> GST_TRACERS="insertlogo(file=/tmp/logo.json)" \
+ *     gst-launch-1.0 videotestsrc num-buffers=300 ! insertlogo ! fakesink
+ * ]|
+ *
+ * Only one instance of the tracer is supported per process.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "gstlogotracer.h"
+#include <string.h>
+#include <unistd.h>
+
+/* Bytes of events a thread collects before writing them out */
+#define GST_LOGO_TRACER_FLUSH_SIZE (64 * 1024)
+
+/* Type name of the element whose stages are traced */
+#define GST_LOGO_TRACER_ELEMENT_TYPE "GstInsertLogo"
+
+/* Events and the stages entered on one thread */
+typedef struct
+{
+  GstLogoTracer *tracer;
+  gint tid;
+  GArray *starts;
+  GString *events;
+} GstLogoTracerThread;
+
+static void gst_logo_tracer_thread_free (gpointer data);
+
+/* Guards the file and the thread list against threads exiting while the
+ * tracer is finalized */
+G_LOCK_DEFINE_STATIC (trace_file);
+static GPrivate thread_key = G_PRIVATE_INIT (gst_logo_tracer_thread_free);
+
+static const gchar *stage_names[GST_LOGO_TRACE_N_STAGES] = {
+  "sprite", "anim", "blend", "push"
+};
+
+G_DEFINE_TYPE (GstLogoTracer, gst_logo_tracer, GST_TYPE_TRACER);
+
+/* Appends a string as a JSON string literal */
+static void
+gst_logo_tracer_append_string (GString * out, const gchar * str)
+{
+  g_string_append_c (out, '"');
+  for (; str != NULL && *str; str++) {
+    if (*str == '"' || *str == '\\')
+      g_string_append_c (out, '\\');
+    if ((guchar) * str < 0x20)
+      g_string_append_printf (out, "\\u%04x", (guchar) * str);
+    else
+      g_string_append_c (out, *str);
+  }
+  g_string_append_c (out, '"');
+}
+
+/* Writes the events of a thread, with the lock of the file held */
+static void
+gst_logo_tracer_flush_locked (GstLogoTracerThread * thread)
+{
+  if (thread->tracer != NULL && thread->tracer->file != NULL)
+    fwrite (thread->events->str, 1, thread->events->len, thread->tracer->file);
+  g_string_truncate (thread->events, 0);
+}
+
+static void
+gst_logo_tracer_thread_free (gpointer data)
+{
+  GstLogoTracerThread *thread = data;
+
+  G_LOCK (trace_file);
+  if (thread->tracer != NULL) {
+    gst_logo_tracer_flush_locked (thread);
+    g_ptr_array_remove_fast (thread->tracer->threads, thread);
+  }
+  G_UNLOCK (trace_file);
+
+  g_array_free (thread->starts, TRUE);
+  g_string_free (thread->events, TRUE);
+  g_free (thread);
+}
+
+/* Gives the state of the calling thread, naming the thread in the trace
+ * after the element it first ran */
+static GstLogoTracerThread *
+gst_logo_tracer_get_thread (GstLogoTracer * self, GstElement * element)
+{
+  GstLogoTracerThread *thread = g_private_get (&thread_key);
+  gchar *name;
+
+  if (thread != NULL)
+    return thread;
+
+  thread = g_new0 (GstLogoTracerThread, 1);
+  thread->starts = g_array_new (FALSE, FALSE, sizeof (GstClockTime));
+  thread->events = g_string_sized_new (GST_LOGO_TRACER_FLUSH_SIZE + 1024);
+
+  G_LOCK (trace_file);
+  thread->tracer = self;
+  thread->tid = ++self->next_tid;
+  g_ptr_array_add (self->threads, thread);
+  G_UNLOCK (trace_file);
+
+  name = g_strdup_printf ("%s streaming", GST_OBJECT_NAME (element));
+  g_string_append_printf (thread->events,
+      ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+      "\"args\":{\"name\":", self->pid, thread->tid);
+  gst_logo_tracer_append_string (thread->events, name);
+  g_string_append (thread->events, "}}");
+  g_free (name);
+
+  g_private_set (&thread_key, thread);
+  return thread;
+}
+
+static void
+gst_logo_tracer_begin (gpointer user_data, GstElement * element,
+    GstLogoTraceStage stage)
+{
+  GstLogoTracerThread *thread = gst_logo_tracer_get_thread (user_data,
+      element);
+  GstClockTime now = gst_util_get_timestamp ();
+
+  g_array_append_val (thread->starts, now);
+}
+
+static void
+gst_logo_tracer_end (gpointer user_data, GstElement * element,
+    GstLogoTraceStage stage)
+{
+  GstLogoTracer *self = user_data;
+  GstLogoTracerThread *thread = gst_logo_tracer_get_thread (self, element);
+  GstClockTime now = gst_util_get_timestamp (), start;
+
+  if (thread->starts->len == 0)
+    return;
+  start = g_array_index (thread->starts, GstClockTime, thread->starts->len - 1);
+  g_array_set_size (thread->starts, thread->starts->len - 1);
+
+  g_string_append_printf (thread->events,
+      ",\n{\"name\":\"%s\",\"cat\":\"insertlogo\",\"ph\":\"X\",\"pid\":%d,"
+      "\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"element\":",
+      stage_names[stage], self->pid, thread->tid, start / 1000.0,
+      (now - start) / 1000.0);
+  gst_logo_tracer_append_string (thread->events, GST_OBJECT_NAME (element));
+  g_string_append (thread->events, "}}");
+
+  if (thread->events->len >= GST_LOGO_TRACER_FLUSH_SIZE) {
+    G_LOCK (trace_file);
+    gst_logo_tracer_flush_locked (thread);
+    G_UNLOCK (trace_file);
+  }
+}
+
+/* Installs the hooks on every new insert_logo element */
+static void
+gst_logo_tracer_element_new (GObject * object, GstClockTime ts,
+    GstElement * element)
+{
+  GstLogoTracer *self = GST_LOGO_TRACER (object);
+
+  if (g_strcmp0 (G_OBJECT_TYPE_NAME (element),
+          GST_LOGO_TRACER_ELEMENT_TYPE) == 0)
+    g_object_set_qdata (G_OBJECT (element),
+        g_quark_from_static_string (GST_LOGO_TRACE_QDATA), &self->hooks);
+}
+
+static void
+gst_logo_tracer_constructed (GObject * object)
+{
+  GstLogoTracer *self = GST_LOGO_TRACER (object);
+  gchar *params = NULL, *file = NULL;
+  GString *header;
+
+  G_OBJECT_CLASS (gst_logo_tracer_parent_class)->constructed (object);
+
+  /* The params are a structure body, e.g. 'file=/tmp/logo.json' */
+  g_object_get (self, "params", &params, NULL);
+  if (params != NULL) {
+    gchar *desc = g_strdup_printf ("insertlogo,%s", params);
+    GstStructure *s = gst_structure_from_string (desc, NULL);
+
+    if (s != NULL) {
+      file = g_strdup (gst_structure_get_string (s, "file"));
+      gst_structure_free (s);
+    } else {
+      g_warning ("Invalid params '%s' for the insertlogo tracer.", params);
+    }
+    g_free (desc);
+    g_free (params);
+  }
+  if (file == NULL)
+    file = g_strdup (DFLT_TRACE_FILE);
+
+  /* Every event after the process name starts with a separator */
+  self->file = fopen (file, "w");
+  if (self->file == NULL) {
+    g_warning ("Cannot open trace file '%s'.", file);
+  } else {
+    header = g_string_new (NULL);
+    g_string_append_printf (header, "{\"traceEvents\":[\n"
+        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,"
+        "\"args\":{\"name\":", self->pid);
+    gst_logo_tracer_append_string (header, g_get_prgname () ?
+        g_get_prgname () : "gstreamer");
+    g_string_append (header, "}}");
+    fputs (header->str, self->file);
+    g_string_free (header, TRUE);
+  }
+  g_free (file);
+
+  gst_tracing_register_hook (GST_TRACER (self), "element-new",
+      G_CALLBACK (gst_logo_tracer_element_new));
+}
+
+static void
+gst_logo_tracer_finalize (GObject * object)
+{
+  GstLogoTracer *self = GST_LOGO_TRACER (object);
+  guint i;
+
+  /* Threads still alive keep their state, but no longer write */
+  G_LOCK (trace_file);
+  for (i = 0; i < self->threads->len; i++) {
+    GstLogoTracerThread *thread = g_ptr_array_index (self->threads, i);
+    gst_logo_tracer_flush_locked (thread);
+    thread->tracer = NULL;
+  }
+  if (self->file != NULL) {
+    fputs ("\n]}\n", self->file);
+    fclose (self->file);
+    self->file = NULL;
+  }
+  G_UNLOCK (trace_file);
+  g_ptr_array_unref (self->threads);
+
+  G_OBJECT_CLASS (gst_logo_tracer_parent_class)->finalize (object);
+}
+
+static void
+gst_logo_tracer_class_init (GstLogoTracerClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+
+  gobject_class->constructed = gst_logo_tracer_constructed;
+  gobject_class->finalize = gst_logo_tracer_finalize;
+}
+
+static void
+gst_logo_tracer_init (GstLogoTracer * self)
+{
+  self->hooks.begin = gst_logo_tracer_begin;
+  self->hooks.end = gst_logo_tracer_end;
+  self->hooks.user_data = self;
+  self->file = NULL;
+  self->threads = g_ptr_array_new ();
+  self->next_tid = 0;
+  self->pid = getpid ();
+}
+
+/**
+ * @brief Registers the insertlogo tracer.
+ *
+ * @param plugin The GstPlugin instance of the tracer plug-in.
+ * @return TRUE if registration was successful, FALSE otherwise.
+ */
+static gboolean
+insertlogotracer_init (GstPlugin * plugin)
+{
+  return gst_tracer_register (plugin, "insertlogo", GST_TYPE_LOGO_TRACER);
+}
+
+#ifndef PACKAGE
+#define PACKAGE "insertlogotracer"
+#endif
+
+GST_PLUGIN_DEFINE (GST_VERSION_MAJOR,
+    GST_VERSION_MINOR,
+    insertlogotracer,
+    "Chrome trace export of the insert_logo stages",
+    insertlogotracer_init,
+    PACKAGE_VERSION, GST_LICENSE, GST_PACKAGE_NAME, GST_PACKAGE_ORIGIN)
@@ -0,0 +1,87 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_LOGO_TRACER_H__
+#define __GST_LOGO_TRACER_H__
+
+#include <gst/gst.h>
+#include <stdio.h>
+#include "gstlogotrace.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_LOGO_TRACER (gst_logo_tracer_get_type())
+G_DECLARE_FINAL_TYPE (GstLogoTracer, gst_logo_tracer,
+    GST, LOGO_TRACER, GstTracer)
+
+/* Trace file written when the params do not name one */
+#define DFLT_TRACE_FILE "insertlogo-trace.json"
+
+/**
+ * GstLogoTracer:
+ * @tracer: The parent tracer.
+ * @hooks: The hooks installed on every insert_logo element.
+ * @file: The Chrome trace file being written.
+ * @threads: The per-thread event buffers that are not flushed yet.
+ * @next_tid: The id given to the next thread that enters a stage.
+ * @pid: The process id written with every event.
+ *
+ * Writes the stages of every insert_logo element as Chrome trace events.
+ * Events are collected per thread and written out in blocks, so threads
+ * only contend on the lock of the file once every few hundred events.
+ */
+struct _GstLogoTracer
+{
+  GstTracer tracer;
+  GstLogoTraceHooks hooks;
+  FILE *file;
+  GPtrArray *threads;
+  gint next_tid;
+  gint pid;
+};
+
+G_END_DECLS
+
+#endif /* __GST_LOGO_TRACER_H__ */
@@ -0,0 +1,1102 @@
+/*
+ * GStreamer
+ * Copyright (C) 2005 Thomas Vander Stichele <thomas@apestaart.org>
+ * Copyright (C) 2005 Ronald S. Bultje <rbultje@ronald.bitfreak.net>
+ * Copyright (C) 2024 Divyesh Kapadiya <<Divyesh.Kapadiya@moschip.com>>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Alternatively, the contents of this file may be used under the
+ * GNU Lesser General Public License Version 2.1 (the "LGPL"), in
+ * which case the following provisions apply instead of the ones
+ * mentioned above:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * SECTION:test-logo
+ *
+ * Unit tests of the logo modules, run by `meson test`.
+ *
+ * Covers the property string parsers (schedule windows, covers, layers,
+ * keyframes and playlist entries), the text placeholders, the animation
+ * sampler, the APNG index and decoder including malformed files, the
+ * playlist switching, the ticker strip decoder and the blend kernels of
+ * every format sprites can be built for. The PNG files are generated into
+ * a temporary directory, so the tests need no data.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <glib/gstdio.h>
+#include <math.h>
+#include <string.h>
+#include "gstlogoanim.h"
+#include "gstlogocover.h"
+#include "gstlogolayer.h"
+#include "gstlogoplaylist.h"
+#include "gstlogoschedule.h"
+#include "gstlogoseq.h"
+#include "gstlogosprite.h"
+#include "gstlogotext.h"
+#include "gstlogoticker.h"
+
+/* How long a test waits for a decoder thread */
+#define TEST_TIMEOUT (5 * G_USEC_PER_SEC)
+
+typedef enum
+{
+  APNG_VALID,
+  APNG_TRUNCATED,
+  APNG_HUGE_OFFSET
+} TestApng;
+
+static const GstVideoFormat blend_formats[] = {
+  GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_NV21, GST_VIDEO_FORMAT_I420,
+  GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_NV16, GST_VIDEO_FORMAT_NV61,
+  GST_VIDEO_FORMAT_Y42B, GST_VIDEO_FORMAT_NV24, GST_VIDEO_FORMAT_Y444,
+  GST_VIDEO_FORMAT_GRAY8, GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_UYVY,
+  GST_VIDEO_FORMAT_YVYU, GST_VIDEO_FORMAT_RGBx, GST_VIDEO_FORMAT_BGRx,
+  GST_VIDEO_FORMAT_xRGB, GST_VIDEO_FORMAT_xBGR, GST_VIDEO_FORMAT_RGBA,
+  GST_VIDEO_FORMAT_BGRA, GST_VIDEO_FORMAT_ARGB, GST_VIDEO_FORMAT_ABGR,
+  GST_VIDEO_FORMAT_RGB, GST_VIDEO_FORMAT_BGR,
+  GST_VIDEO_FORMAT_P010_10LE, GST_VIDEO_FORMAT_P012_LE,
+  GST_VIDEO_FORMAT_P016_LE, GST_VIDEO_FORMAT_I420_10LE,
+  GST_VIDEO_FORMAT_I420_12LE, GST_VIDEO_FORMAT_I422_10LE,
+  GST_VIDEO_FORMAT_Y444_10LE, GST_VIDEO_FORMAT_GRAY16_LE,
+  GST_VIDEO_FORMAT_P010_10BE, GST_VIDEO_FORMAT_P012_BE,
+  GST_VIDEO_FORMAT_P016_BE, GST_VIDEO_FORMAT_I420_10BE,
+  GST_VIDEO_FORMAT_I420_12BE, GST_VIDEO_FORMAT_I422_10BE,
+  GST_VIDEO_FORMAT_Y444_10BE, GST_VIDEO_FORMAT_GRAY16_BE,
+  GST_VIDEO_FORMAT_NV12_4L4, GST_VIDEO_FORMAT_NV12_32L32,
+  GST_VIDEO_FORMAT_NV12_64Z32
+};
+
+static gchar *tmp_dir;
+static guint32 crc_table[256];
+
+/* Writing PNG files */
+
+static void
+test_crc_init (void)
+{
+  guint32 c;
+  guint i, k;
+
+  for (i = 0; i < 256; i++) {
+    c = i;
+    for (k = 0; k < 8; k++)
+      c = c & 1 ? 0xedb88320 ^ (c >> 1) : c >> 1;
+    crc_table[i] = c;
+  }
+}
+
+static void
+test_put_be32 (GByteArray * png, guint32 value)
+{
+  guint8 bytes[4] = { value >> 24, value >> 16, value >> 8, value };
+
+  g_byte_array_append (png, bytes, 4);
+}
+
+static void
+test_put_chunk (GByteArray * png, const gchar * type, const guint8 * data,
+    guint len)
+{
+  guint32 crc = 0xffffffff;
+  guint start, i;
+
+  test_put_be32 (png, len);
+  start = png->len;
+  g_byte_array_append (png, (const guint8 *) type, 4);
+  if (len > 0)
+    g_byte_array_append (png, data, len);
+  for (i = start; i < png->len; i++)
+    crc = crc_table[(crc ^ png->data[i]) & 0xff] ^ (crc >> 8);
+  test_put_be32 (png, crc ^ 0xffffffff);
+}
+
+/* A zlib stream of stored blocks holding the unfiltered rows of a uniform
+ * RGBA image, so no compressor is needed. An interlaced image holds the
+ * rows of its seven Adam7 passes one after the other. */
+static GByteArray *
+test_image_data (gint width, gint height, guint32 rgba, gboolean interlaced)
+{
+  static const gint start_x[7] = { 0, 4, 0, 2, 0, 1, 0 };
+  static const gint start_y[7] = { 0, 0, 4, 0, 2, 0, 1 };
+  static const gint step_x[7] = { 8, 8, 4, 4, 2, 2, 1 };
+  static const gint step_y[7] = { 8, 8, 8, 4, 4, 2, 2 };
+  GByteArray *raw = g_byte_array_new (), *z = g_byte_array_new ();
+  guint8 pixel[4] = { rgba >> 24, rgba >> 16, rgba >> 8, rgba };
+  guint8 header[3] = { 0x78, 0x01 };
+  guint32 a = 1, b = 0;
+  guint i, len;
+  gint pass, x, y, pass_width, pass_height;
+
+  for (pass = 0; pass < (interlaced ? 7 : 1); pass++) {
+    pass_width = interlaced ? MAX (0, width - start_x[pass] + step_x[pass]
+        - 1) / step_x[pass] : width;
+    pass_height = interlaced ? MAX (0, height - start_y[pass] + step_y[pass]
+        - 1) / step_y[pass] : height;
+    if (pass_width == 0)
+      continue;
+    for (y = 0; y < pass_height; y++) {
+      g_byte_array_append (raw, (const guint8 *) "", 1);
+      for (x = 0; x < pass_width; x++)
+        g_byte_array_append (raw, pixel, 4);
+    }
+  }
+  for (i = 0; i < raw->len; i++) {
+    a = (a + raw->data[i]) % 65521;
+    b = (b + a) % 65521;
+  }
+
+  g_byte_array_append (z, header, 2);
+  for (i = 0; i == 0 || i < raw->len; i += len) {
+    len = MIN (raw->len - i, 0xffff);
+    header[0] = i + len == raw->len;
+    header[1] = len & 0xff;
+    header[2] = len >> 8;
+    g_byte_array_append (z, header, 3);
+    header[1] ^= 0xff;
+    header[2] ^= 0xff;
+    g_byte_array_append (z, header + 1, 2);
+    g_byte_array_append (z, raw->data + i, len);
+  }
+  test_put_be32 (z, (b << 16) | a);
+  g_byte_array_unref (raw);
+
+  return z;
+}
+
+static GByteArray *
+test_png_start (gint width, gint height, gboolean interlaced)
+{
+  static const guint8 signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+  GByteArray *png = g_byte_array_new ();
+  guint8 ihdr[13] = { 0 };
+  gint i;
+
+  g_byte_array_append (png, signature, 8);
+  for (i = 0; i < 4; i++) {
+    ihdr[3 - i] = width >> (8 * i);
+    ihdr[7 - i] = height >> (8 * i);
+  }
+  ihdr[8] = 8;
+  ihdr[9] = 6;
+  ihdr[12] = interlaced;
+  test_put_chunk (png, "IHDR", ihdr, 13);
+
+  return png;
+}
+
+static gchar *
+test_png_save (GByteArray * png, const gchar * name)
+{
+  gchar *path = g_build_filename (tmp_dir, name, NULL);
+
+  g_assert_true (g_file_set_contents (path, (const gchar *) png->data,
+          png->len, NULL));
+  g_byte_array_unref (png);
+
+  return path;
+}
+
+/* Writes a uniform PNG, returns its path */
+static gchar *
+test_write_image (const gchar * name, gint width, gint height, guint32 rgba,
+    gboolean interlaced)
+{
+  GByteArray *png = test_png_start (width, height, interlaced);
+  GByteArray *data = test_image_data (width, height, rgba, interlaced);
+
+  test_put_chunk (png, "IDAT", data->data, data->len);
+  test_put_chunk (png, "IEND", NULL, 0);
+  g_byte_array_unref (data);
+
+  return test_png_save (png, name);
+}
+
+static gchar *
+test_write_png (const gchar * name, gint width, gint height, guint32 rgba)
+{
+  return test_write_image (name, width, height, rgba, FALSE);
+}
+
+static void
+test_put_fctl (GByteArray * png, guint seq, guint32 width, guint32 height,
+    guint32 x, guint32 y)
+{
+  guint8 fctl[26] = { 0 };
+  guint32 fields[5] = { seq, width, height, x, y };
+  guint i;
+
+  for (i = 0; i < 5; i++) {
+    fctl[4 * i] = fields[i] >> 24;
+    fctl[4 * i + 1] = fields[i] >> 16;
+    fctl[4 * i + 2] = fields[i] >> 8;
+    fctl[4 * i + 3] = fields[i];
+  }
+  /* A delay of 1/10 s, no dispose, source blend */
+  fctl[21] = 1;
+  fctl[23] = 10;
+  test_put_chunk (png, "fcTL", fctl, 26);
+}
+
+/* Writes an 8x8 APNG of a red frame followed by a green 4x4 square in its
+ * middle, both shown for 1/10 s. The malformed kinds have a second frame
+ * region far outside of the image, or a last chunk claiming more data
+ * than the file holds and no IEND. */
+static gchar *
+test_write_apng (const gchar * name, TestApng kind)
+{
+  GByteArray *png = test_png_start (8, 8, FALSE);
+  GByteArray *data, *fdat;
+  guint8 actl[8] = { 0, 0, 0, 2, 0, 0, 0, 0 };
+
+  test_put_chunk (png, "acTL", actl, 8);
+
+  test_put_fctl (png, 0, 8, 8, 0, 0);
+  data = test_image_data (8, 8, 0xff0000ff, FALSE);
+  test_put_chunk (png, "IDAT", data->data, data->len);
+  g_byte_array_unref (data);
+
+  test_put_fctl (png, 1, 4, 4, kind == APNG_HUGE_OFFSET ? 0x7ffffffe : 2, 2);
+  data = test_image_data (4, 4, 0x00ff00ff, FALSE);
+  fdat = g_byte_array_new ();
+  test_put_be32 (fdat, 2);
+  g_byte_array_append (fdat, data->data, data->len);
+  test_put_chunk (png, "fdAT", fdat->data, fdat->len);
+  g_byte_array_unref (fdat);
+  g_byte_array_unref (data);
+
+  if (kind == APNG_TRUNCATED) {
+    test_put_be32 (png, 0x7ffffff0);
+    g_byte_array_append (png, (const guint8 *) "fdAT", 4);
+    test_put_be32 (png, 3);
+    test_put_be32 (png, 0xdeadbeef);
+  } else {
+    test_put_chunk (png, "IEND", NULL, 0);
+  }
+
+  return test_png_save (png, name);
+}
+
+static GstStructure *
+test_structure (const gchar * str)
+{
+  GstStructure *s = gst_structure_from_string (str, NULL);
+
+  g_assert_nonnull (s);
+  return s;
+}
+
+static guint32
+test_surface_pixel (cairo_surface_t * surface, gint x, gint y)
+{
+  cairo_surface_flush (surface);
+  return *(guint32 *) (cairo_image_surface_get_data (surface) +
+      y * cairo_image_surface_get_stride (surface) + 4 * x);
+}
+
+/* Parsers */
+
+static guint
+test_schedule_eval (const gchar * str, gdouble seconds)
+{
+  GstStructure *s = test_structure (str);
+  GArray *windows = g_array_new (FALSE, FALSE, sizeof (GstLogoWindow));
+  GstLogoWindow window;
+  guint level;
+
+  g_assert_true (gst_logo_window_parse (s, &window));
+  g_array_append_val (windows, window);
+  level = gst_logo_schedule_eval (windows, seconds * GST_SECOND,
+      seconds * GST_SECOND);
+  g_array_unref (windows);
+  gst_structure_free (s);
+
+  return level;
+}
+
+static void
+test_schedule_invalid (const gchar * str)
+{
+  GstStructure *s = test_structure (str);
+  GstLogoWindow window;
+
+  g_test_expect_message (NULL, G_LOG_LEVEL_WARNING, "Invalid*");
+  g_assert_false (gst_logo_window_parse (s, &window));
+  g_test_assert_expected_messages ();
+  gst_structure_free (s);
+}
+
+static void
+test_schedule (void)
+{
+  const gchar *fade = "w, start=10, end=20, fade=2";
+  const gchar *night = "w, from=(string)\"23:00\", to=(string)\"01:00\"";
+  GstStructure *s;
+  GstLogoWindow window;
+
+  g_assert_cmpuint (test_schedule_eval (fade, 9), ==, 0);
+  g_assert_cmpuint (test_schedule_eval (fade, 11), ==, 127);
+  g_assert_cmpuint (test_schedule_eval (fade, 15), ==, 255);
+  g_assert_cmpuint (test_schedule_eval (fade, 19), ==, 127);
+  g_assert_cmpuint (test_schedule_eval (fade, 20), ==, 0);
+
+  s = test_structure ("w, start=5.5");
+  g_assert_true (gst_logo_window_parse (s, &window));
+  g_assert_false (window.wall_clock);
+  g_assert_cmpuint (window.start, ==, 5500 * GST_MSECOND);
+  g_assert_cmpuint (window.end, ==, GST_CLOCK_TIME_NONE);
+  gst_structure_free (s);
+
+  /* Wall clock windows may span midnight */
+  g_assert_cmpuint (test_schedule_eval (night, 23.5 * 3600), ==, 255);
+  g_assert_cmpuint (test_schedule_eval (night, 0.5 * 3600), ==, 255);
+  g_assert_cmpuint (test_schedule_eval (night, 12 * 3600), ==, 0);
+
+  test_schedule_invalid ("w, start=20, end=10");
+  test_schedule_invalid ("w, end=10");
+  test_schedule_invalid ("w, start=0, fade=-1");
+  test_schedule_invalid ("w, from=(string)\"25:00\", to=(string)\"01:00\"");
+  test_schedule_invalid ("w, from=(string)\"23:00\", to=(string)\"1\"");
+}
+
+static void
+test_cover_invalid (const gchar * str)
+{
+  GstStructure *s = test_structure (str);
+  GstLogoCover cover;
+
+  g_test_expect_message (NULL, G_LOG_LEVEL_WARNING, "Invalid*");
+  g_assert_false (gst_logo_cover_parse (s, &cover));
+  g_test_assert_expected_messages ();
+  gst_structure_free (s);
+}
+
+static void
+test_cover (void)
+{
+  GstStructure *s;
+  GstLogoCover cover;
+
+  s = test_structure ("c, x=10, y=20, width=30, height=40");
+  g_assert_true (gst_logo_cover_parse (s, &cover));
+  g_assert_cmpint (cover.mode, ==, GST_LOGO_COVER_BLUR);
+  g_assert_cmpint (cover.x, ==, 10);
+  g_assert_cmpint (cover.height, ==, 40);
+  g_assert_cmpuint (cover.radius, ==, GST_LOGO_COVER_RADIUS);
+  g_assert_cmpuint (cover.passes, ==, GST_LOGO_COVER_PASSES);
+  gst_structure_free (s);
+
+  s = test_structure ("c, x=0, y=0, width=8, height=8, mode=pixelate, "
+      "block=4");
+  g_assert_true (gst_logo_cover_parse (s, &cover));
+  g_assert_cmpint (cover.mode, ==, GST_LOGO_COVER_PIXELATE);
+  g_assert_cmpuint (cover.block, ==, 4);
+  gst_structure_free (s);
+
+  test_cover_invalid ("c, x=0, y=0, width=0, height=8");
+  test_cover_invalid ("c, x=-1, y=0, width=8, height=8");
+  test_cover_invalid ("c, x=0, y=0, width=8");
+  test_cover_invalid ("c, x=0, y=0, width=8, height=8, mode=smudge");
+  test_cover_invalid ("c, x=0, y=0, width=8, height=8, passes=7");
+  test_cover_invalid ("c, x=0, y=0, width=8, height=8, radius=300");
+}
+
+static void
+test_layer_invalid (const gchar * str)
+{
+  GstStructure *s = test_structure (str);
+
+  g_test_expect_message (NULL, G_LOG_LEVEL_WARNING, "*ayer*");
+  g_assert_null (gst_logo_layer_new_from_structure (s));
+  g_test_assert_expected_messages ();
+  gst_structure_free (s);
+}
+
+static void
+test_layer (void)
+{
+  GstStructure *s;
+  GstLogoLayer *layer;
+  gchar *logo, *str;
+
+  s = test_structure ("clock, text=\"%T\", x=10, y=20, font-size=24, "
+      "color=0x7f00ff00");
+  layer = gst_logo_layer_new_from_structure (s);
+  g_assert_nonnull (layer);
+  g_assert_cmpstr (layer->name, ==, "clock");
+  g_assert_cmpstr (layer->text, ==, "%T");
+  g_assert_cmpstr (layer->font, ==, "Sans");
+  g_assert_cmpint (layer->font_size, ==, 24);
+  g_assert_cmphex (layer->color, ==, 0x7f00ff00);
+  g_assert_cmpint (layer->x, ==, 10);
+  g_assert_cmpint (layer->alpha, ==, 100);
+  g_assert_null (layer->cache);
+  gst_logo_layer_free (layer);
+  gst_structure_free (s);
+
+  logo = test_write_png ("layer.png", 8, 8, 0xffffffff);
+  str = g_strdup_printf ("rating, logo-file=\"%s\", scrolling=rtl, "
+      "speed=fast, alpha=80", logo);
+  s = test_structure (str);
+  layer = gst_logo_layer_new_from_structure (s);
+  g_assert_nonnull (layer);
+  g_assert_cmpstr (layer->name, ==, "rating");
+  g_assert_cmpstr (layer->logo, ==, logo);
+  g_assert_cmpint (layer->motion, ==, GST_LOGO_MOTION_SCROLL_RTL);
+  g_assert_cmpfloat (layer->speed, ==, 120);
+  g_assert_cmpint (layer->alpha, ==, 80);
+  g_assert_cmpint (layer->x, ==, -1);
+  g_assert_nonnull (layer->cache);
+  gst_logo_layer_free (layer);
+  gst_structure_free (s);
+  g_free (str);
+  g_free (logo);
+
+  test_layer_invalid ("l, x=0");
+  test_layer_invalid ("l, logo-file=a.png, text=a");
+  test_layer_invalid ("l, logo-file=a.jpg");
+  test_layer_invalid ("l, text=a, alpha=101");
+  test_layer_invalid ("l, logo-file=a.png, x=-2");
+  test_layer_invalid ("l, logo-file=a.png, rotation=sideways");
+  test_layer_invalid ("l, text=a, rotation=clockwise");
+  test_layer_invalid ("l, text=a, font-size=2");
+  test_layer_invalid ("l, logo-file=a.png, scrolling=up");
+  test_layer_invalid ("l, logo-file=a.png, scrolling=ltr, "
+      "rotation=clockwise");
+}
+
+static void
+test_text (void)
+{
+  GString *text = g_string_new (NULL);
+  GstClockTime pts = 3723 * GST_SECOND + GST_SECOND / 2;
+
+  gst_logo_text_expand ("%T", pts, 25, 1, text);
+  g_assert_cmpstr (text->str, ==, "01:02:03:12");
+  gst_logo_text_expand ("at %T", pts, 0, 1, text);
+  g_assert_cmpstr (text->str, ==, "at 01:02:03:--");
+  gst_logo_text_expand ("%T", GST_CLOCK_TIME_NONE, 25, 1, text);
+  g_assert_cmpstr (text->str, ==, "--:--:--:--");
+  gst_logo_text_expand ("100%% %x%", pts, 25, 1, text);
+  g_assert_cmpstr (text->str, ==, "100% %x%");
+
+  g_string_free (text, TRUE);
+}
+
+static void
+test_keyframe (void)
+{
+  GstLogoKeyframe prev = { 0, 10, 20, 0, 100, 1.0, GST_LOGO_EASE_OUT };
+  GstLogoKeyframe kf;
+  GstStructure *s;
+  const gchar *invalid[] = {
+    "k, x=5", "k, t=-1", "k, t=1, alpha=101", "k, t=1, scale=0",
+    "k, t=1, ease=wobble", "k, t=1, x=(string)left"
+  };
+  guint i;
+
+  s = test_structure ("k, t=2.5, x=50, ease=in-out");
+  g_assert_true (gst_logo_keyframe_parse (s, &prev, &kf));
+  g_assert_cmpuint (kf.time, ==, 2500 * GST_MSECOND);
+  g_assert_cmpfloat (kf.x, ==, 50);
+  g_assert_cmpfloat (kf.y, ==, 20);
+  g_assert_cmpfloat (kf.alpha, ==, 100);
+  g_assert_cmpint (kf.easing, ==, GST_LOGO_EASE_IN_OUT);
+  gst_structure_free (s);
+
+  /* The easing is not inherited */
+  s = test_structure ("k, t=3");
+  g_assert_true (gst_logo_keyframe_parse (s, &prev, &kf));
+  g_assert_cmpint (kf.easing, ==, GST_LOGO_EASE_LINEAR);
+  gst_structure_free (s);
+
+  for (i = 0; i < G_N_ELEMENTS (invalid); i++) {
+    s = test_structure (invalid[i]);
+    g_assert_false (gst_logo_keyframe_parse (s, &prev, &kf));
+    gst_structure_free (s);
+  }
+}
+
+static void
+test_playlist_parse (void)
+{
+  GstStructure *s;
+  GstLogoPlaylistEntry entry;
+  GArray *entries;
+  gchar *path, *logo;
+
+  s = test_structure ("a, logo-file=a.png, duration=2.5");
+  g_assert_true (gst_logo_playlist_entry_parse (s, &entry));
+  g_assert_cmpstr (entry.file, ==, "a.png");
+  g_assert_cmpuint (entry.duration, ==, 2500 * GST_MSECOND);
+  g_free (entry.file);
+  gst_structure_free (s);
+
+  s = test_structure ("b, logo-file=b.png, duration=3");
+  g_assert_true (gst_logo_playlist_entry_parse (s, &entry));
+  g_assert_cmpuint (entry.duration, ==, 3 * GST_SECOND);
+  g_free (entry.file);
+  gst_structure_free (s);
+
+  s = test_structure ("b, logo-file=b.gif, duration=3");
+  g_test_expect_message (NULL, G_LOG_LEVEL_WARNING, "Invalid playlist logo*");
+  g_assert_false (gst_logo_playlist_entry_parse (s, &entry));
+  g_test_assert_expected_messages ();
+  gst_structure_free (s);
+
+  s = test_structure ("b, logo-file=b.png, duration=0");
+  g_test_expect_message (NULL, G_LOG_LEVEL_WARNING, "Invalid duration*");
+  g_assert_false (gst_logo_playlist_entry_parse (s, &entry));
+  g_test_assert_expected_messages ();
+  gst_structure_free (s);
+
+  /* Relative paths are relative to the playlist file */
+  path = g_build_filename (tmp_dir, "playlist.txt", NULL);
+  g_assert_true (g_file_set_contents (path, "# sponsors\n"
+          "  a.png 1.5\n" "\n" "/logos/my logo.png\t2\n", -1, NULL));
+  entries = gst_logo_playlist_read_file (path);
+  g_assert_nonnull (entries);
+  g_assert_cmpuint (entries->len, ==, 2);
+  logo = g_build_filename (tmp_dir, "a.png", NULL);
+  g_assert_cmpstr (g_array_index (entries, GstLogoPlaylistEntry, 0).file, ==,
+      logo);
+  g_assert_cmpuint (g_array_index (entries, GstLogoPlaylistEntry,
+          0).duration, ==, 1500 * GST_MSECOND);
+  g_assert_cmpstr (g_array_index (entries, GstLogoPlaylistEntry, 1).file, ==,
+      "/logos/my logo.png");
+  g_assert_cmpuint (g_array_index (entries, GstLogoPlaylistEntry,
+          1).duration, ==, 2 * GST_SECOND);
+  g_array_unref (entries);
+  g_free (logo);
+
+  g_assert_true (g_file_set_contents (path, "a.png 1\nb.png\n", -1, NULL));
+  g_test_expect_message (NULL, G_LOG_LEVEL_WARNING, "Invalid line 2*");
+  g_assert_null (gst_logo_playlist_read_file (path));
+  g_test_assert_expected_messages ();
+
+  g_unlink (path);
+  g_free (path);
+}
+
+/* Animation sampler */
+
+static void
+test_anim (void)
+{
+  GstLogoAnim *anim;
+  const GstLogoAnimState *state;
+  GstLogoKeyframe kf = { 0, 0, 0, 0, 100, 1.0, GST_LOGO_EASE_LINEAR };
+  gdouble speed;
+
+  /* 100 pixels at 100 pixels per second, sampled every 1/10 s */
+  anim = gst_logo_anim_new_path (GST_LOGO_PATH_HORIZONTAL,
+      GST_LOGO_REPEAT_BOUNCE, 5, 7, 100, 100, 50, 100);
+  gst_logo_anim_compile (anim, GST_SECOND / 10);
+  g_assert_cmpuint (anim->duration, ==, GST_SECOND);
+  g_assert_cmpuint (anim->n_states, ==, 11);
+  state = gst_logo_anim_eval (anim, 0);
+  g_assert_cmpint (state->x, ==, 0);
+  g_assert_cmpint (state->y, ==, 7);
+  g_assert_cmpuint (state->alpha, ==, 255);
+  g_assert_cmpint (gst_logo_anim_eval (anim, GST_SECOND / 2)->x, ==, 50);
+  g_assert_cmpint (gst_logo_anim_eval (anim, GST_SECOND)->x, ==, 100);
+  g_assert_cmpint (gst_logo_anim_eval (anim, 1200 * GST_MSECOND)->x, ==, 80);
+  g_assert_cmpint (gst_logo_anim_eval (anim, GST_CLOCK_TIME_NONE)->x, ==, 0);
+  anim->repeat = GST_LOGO_REPEAT_LOOP;
+  g_assert_cmpint (gst_logo_anim_eval (anim, 1200 * GST_MSECOND)->x, ==, 20);
+  anim->repeat = GST_LOGO_REPEAT_ONCE;
+  g_assert_cmpint (gst_logo_anim_eval (anim, 1200 * GST_MSECOND)->x, ==, 100);
+  gst_logo_anim_free (anim);
+
+  anim = gst_logo_anim_new_static (3, 4, 50);
+  gst_logo_anim_compile (anim, GST_SECOND / 25);
+  g_assert_cmpuint (anim->n_states, ==, 1);
+  state = gst_logo_anim_eval (anim, 10 * GST_SECOND);
+  g_assert_cmpint (state->x, ==, 3);
+  g_assert_cmpint (state->y, ==, 4);
+  g_assert_cmpuint (state->alpha, ==, 128);
+  gst_logo_anim_free (anim);
+
+  anim = gst_logo_anim_new_spin (0, 0, 100, -90);
+  gst_logo_anim_compile (anim, GST_SECOND / 10);
+  g_assert_cmpuint (anim->duration, ==, 4 * GST_SECOND);
+  g_assert_cmpfloat (gst_logo_anim_eval (anim, GST_SECOND)->angle, ==, -90);
+  g_assert_cmpfloat (gst_logo_anim_eval (anim, 5 * GST_SECOND)->angle, ==,
+      -90);
+  gst_logo_anim_free (anim);
+
+  /* Keyframes are sorted and eased per segment */
+  anim = gst_logo_anim_new (GST_LOGO_REPEAT_ONCE);
+  kf.time = GST_SECOND;
+  kf.x = 100;
+  kf.easing = GST_LOGO_EASE_IN;
+  gst_logo_anim_add_keyframe (anim, &kf);
+  kf.time = 0;
+  kf.x = 0;
+  kf.easing = GST_LOGO_EASE_LINEAR;
+  gst_logo_anim_add_keyframe (anim, &kf);
+  gst_logo_anim_compile (anim, GST_SECOND / 10);
+  g_assert_cmpint (gst_logo_anim_eval (anim, GST_SECOND / 2)->x, ==, 25);
+  g_assert_cmpint (gst_logo_anim_eval (anim, 2 * GST_SECOND)->x, ==, 100);
+  gst_logo_anim_free (anim);
+
+  g_assert_true (gst_logo_speed_parse ("fast", FALSE, &speed));
+  g_assert_cmpfloat (speed, ==, 120);
+  g_assert_true (gst_logo_speed_parse ("slow", TRUE, &speed));
+  g_assert_cmpfloat (speed, ==, 15);
+  g_assert_false (gst_logo_speed_parse ("warp", FALSE, &speed));
+}
+
+/* APNG */
+
+static void
+test_colorimetry (GstVideoColorimetry * colorimetry)
+{
+  GstVideoInfo info;
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_NV12, 64, 64);
+  *colorimetry = info.colorimetry;
+}
+
+/* Waits until the animation shows another image than @image */
+static GstLogoImage *
+test_sequence_wait (GstLogoSequence * seq, GstClockTime time,
+    GstLogoImage * image)
+{
+  gint64 end = g_get_monotonic_time () + TEST_TIMEOUT;
+  GstLogoImage *next;
+
+  while ((next = gst_logo_sequence_get (seq, time)) == image
+      && g_get_monotonic_time () < end) {
+    gst_logo_image_unref (next);
+    g_usleep (G_USEC_PER_SEC / 100);
+  }
+  return next;
+}
+
+static void
+test_apng (gconstpointer data)
+{
+  TestApng kind = GPOINTER_TO_INT (data);
+  GstLogoSequence *seq = gst_logo_sequence_new ();
+  GstLogoScale scale = { GST_LOGO_SCALE_NONE };
+  GstLogoEffects effects;
+  GstVideoColorimetry colorimetry;
+  GstLogoImage *first, *second;
+  gchar *path;
+
+  gst_logo_effects_init (&effects);
+  test_colorimetry (&colorimetry);
+  path = test_write_apng ("anim.png", kind);
+
+  if (kind == APNG_HUGE_OFFSET) {
+    g_assert_false (gst_logo_sequence_set_source (seq, path, 25, 64 << 20,
+            &scale, &effects));
+    goto done;
+  }
+
+  g_assert_true (gst_logo_sequence_set_source (seq, path, 25, 64 << 20,
+          &scale, &effects));
+  gst_logo_sequence_set_size (seq, 64, 64, GST_VIDEO_FORMAT_NV12,
+      &colorimetry);
+
+  first = gst_logo_sequence_get (seq, 0);
+  g_assert_nonnull (first);
+  g_assert_cmpint (first->width, ==, 8);
+  g_assert_cmpint (first->height, ==, 8);
+  g_assert_cmphex (test_surface_pixel (first->surface, 3, 3), ==, 0xffff0000);
+
+  /* The second frame is drawn over the first */
+  second = test_sequence_wait (seq, 150 * GST_MSECOND, first);
+  g_assert_true (second != first);
+  g_assert_cmphex (test_surface_pixel (second->surface, 0, 0), ==,
+      0xffff0000);
+  g_assert_cmphex (test_surface_pixel (second->surface, 3, 3), ==,
+      0xff00ff00);
+  gst_logo_image_unref (second);
+  gst_logo_image_unref (first);
+
+done:
+  gst_logo_sequence_free (seq);
+  g_unlink (path);
+  g_free (path);
+}
+
+/* Playlist */
+
+/* Waits until the playlist shows a logo of @width */
+static void
+test_playlist_wait (GstLogoPlaylist * playlist, GstClockTime time,
+    gint width)
+{
+  gint64 end = g_get_monotonic_time () + TEST_TIMEOUT;
+  GstLogoImage *current, *next;
+  gint shown;
+  guint mix;
+
+  do {
+    g_assert_true (gst_logo_playlist_get (playlist, time, &current, &next,
+            &mix));
+    shown = current ? current->width : 0;
+    if (current)
+      gst_logo_image_unref (current);
+    if (next)
+      gst_logo_image_unref (next);
+    if (shown != width)
+      g_usleep (G_USEC_PER_SEC / 100);
+  } while (shown != width && g_get_monotonic_time () < end);
+
+  g_assert_cmpint (shown, ==, width);
+}
+
+static GArray *
+test_playlist_entries (const gchar * first, const gchar * second)
+{
+  GArray *entries = gst_logo_playlist_entries_new ();
+  GstLogoPlaylistEntry entry = { NULL, GST_SECOND, 0 };
+
+  entry.file = g_strdup (first);
+  g_array_append_val (entries, entry);
+  if (second != NULL) {
+    entry.file = g_strdup (second);
+    g_array_append_val (entries, entry);
+  }
+  return entries;
+}
+
+static void
+test_playlist (void)
+{
+  GstLogoPlaylist *playlist = gst_logo_playlist_new ();
+  GstLogoScale scale = { GST_LOGO_SCALE_NONE };
+  GstLogoEffects effects;
+  GstVideoColorimetry colorimetry;
+  GstLogoImage *current, *next;
+  gchar *a, *b, *c;
+  guint mix;
+  gint64 end;
+
+  gst_logo_effects_init (&effects);
+  test_colorimetry (&colorimetry);
+  a = test_write_png ("a.png", 8, 8, 0xff0000ff);
+  b = test_write_png ("b.png", 16, 8, 0x00ff00ff);
+  c = test_write_png ("c.png", 12, 12, 0x0000ffff);
+
+  g_assert_false (gst_logo_playlist_get (playlist, 0, &current, &next, &mix));
+
+  gst_logo_playlist_configure (playlist, &scale, &effects, 0);
+  gst_logo_playlist_set_entries (playlist, test_playlist_entries (a, b));
+  gst_logo_playlist_set_size (playlist, 64, 64, GST_VIDEO_FORMAT_NV12,
+      &colorimetry);
+
+  /* Only the first logo is waited for */
+  g_assert_true (gst_logo_playlist_get (playlist, GST_SECOND / 2, &current,
+          &next, &mix));
+  g_assert_nonnull (current);
+  g_assert_cmpint (current->width, ==, 8);
+  g_assert_null (next);
+  gst_logo_image_unref (current);
+
+  test_playlist_wait (playlist, 1500 * GST_MSECOND, 16);
+  /* The playlist loops */
+  test_playlist_wait (playlist, 2500 * GST_MSECOND, 8);
+
+  /* Crossfade over the last half second of the first logo */
+  gst_logo_playlist_configure (playlist, &scale, &effects, GST_SECOND / 2);
+  end = g_get_monotonic_time () + TEST_TIMEOUT;
+  do {
+    g_assert_true (gst_logo_playlist_get (playlist, 750 * GST_MSECOND,
+            &current, &next, &mix));
+    g_assert_nonnull (current);
+    g_assert_cmpint (current->width, ==, 8);
+    gst_logo_image_unref (current);
+    if (next == NULL)
+      g_usleep (G_USEC_PER_SEC / 100);
+  } while (next == NULL && g_get_monotonic_time () < end);
+  g_assert_nonnull (next);
+  g_assert_cmpint (next->width, ==, 16);
+  g_assert_cmpuint (mix, ==, 127);
+  gst_logo_image_unref (next);
+
+  /* New entries replace the logos being shown, the last one stays on
+   * screen while they are decoded */
+  gst_logo_playlist_set_entries (playlist, test_playlist_entries (c, NULL));
+  g_assert_true (gst_logo_playlist_get (playlist, GST_SECOND / 2, &current,
+          &next, &mix));
+  g_assert_nonnull (current);
+  g_assert_true (current->width == 8 || current->width == 12);
+  gst_logo_image_unref (current);
+  test_playlist_wait (playlist, GST_SECOND / 2, 12);
+
+  /* A logo of another format is not shown, the new one is waited for */
+  gst_logo_playlist_set_size (playlist, 64, 64, GST_VIDEO_FORMAT_I420,
+      &colorimetry);
+  g_assert_true (gst_logo_playlist_get (playlist, GST_SECOND / 2, &current,
+          &next, &mix));
+  g_assert_nonnull (current);
+  g_assert_cmpint (current->sprite->format, ==, GST_VIDEO_FORMAT_I420);
+  gst_logo_image_unref (current);
+  gst_logo_playlist_stop (playlist);
+
+  gst_logo_playlist_free (playlist);
+  g_unlink (a);
+  g_unlink (b);
+  g_unlink (c);
+  g_free (a);
+  g_free (b);
+  g_free (c);
+}
+
+/* Ticker */
+
+/* Crawls the end of a red strip wider than cairo loads through the band,
+ * decoded from a plain or an interlaced PNG */
+static void
+test_ticker (gconstpointer data)
+{
+  gboolean interlaced = GPOINTER_TO_INT (data);
+  GstLogoTicker *ticker = gst_logo_ticker_new ();
+  GArray *placements = g_array_new (FALSE, FALSE, sizeof (GstLogoPlacement));
+  GstVideoInfo info;
+  gchar *path;
+  gint64 end;
+  guint i;
+  gint n;
+
+  path = test_write_image ("strip.png", 40000, 3, 0xff0000ff, interlaced);
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_BGRA, 128, 64);
+  gst_logo_ticker_set_source (ticker, path);
+
+  /* At one pixel per second the last 100 columns are in the band */
+  end = g_get_monotonic_time () + TEST_TIMEOUT;
+  do {
+    g_array_set_size (placements, 0);
+    gst_logo_ticker_place (ticker, &info, (128 + 39900) * GST_SECOND, -1, 1,
+        0, placements);
+    if (placements->len == 0)
+      g_usleep (G_USEC_PER_SEC / 100);
+  } while (placements->len == 0 && g_get_monotonic_time () < end);
+
+  /* The last two tiles, the one at the end of the strip is 64 wide */
+  g_assert_cmpuint (placements->len, ==, 2);
+  for (i = 0; i < placements->len; i++) {
+    GstLogoPlacement *placement = &g_array_index (placements,
+        GstLogoPlacement, i);
+    const GstLogoSpritePlane *plane = &placement->sprite->planes[0];
+
+    g_assert_cmpint (placement->x, ==, -220 + 256 * (gint) i);
+    g_assert_cmpint (placement->y, ==, 61);
+    g_assert_cmpint (placement->sprite->width, ==, i == 0 ? 256 : 64);
+    g_assert_cmpint (placement->sprite->height, ==, 3);
+    /* Every pixel of every pass arrived */
+    for (n = 0; n < plane->width * plane->height; n++)
+      g_assert_cmpuint (plane->alpha[n], ==, 255);
+  }
+
+  gst_logo_ticker_free (ticker);
+  g_array_unref (placements);
+  g_unlink (path);
+  g_free (path);
+}
+
+/* Blend kernels */
+
+/* Allocates a 128x64 frame of a uniform grey */
+static GstBuffer *
+test_blend_buffer (const GstVideoInfo * info)
+{
+  GstBuffer *buffer = gst_buffer_new_allocate (NULL, info->size, NULL);
+  GstMapInfo map;
+
+  g_assert_true (gst_buffer_map (buffer, &map, GST_MAP_WRITE));
+  memset (map.data, 0x40, map.size);
+  gst_buffer_unmap (buffer, &map);
+
+  return buffer;
+}
+
+static void
+test_blend_measure (const GstVideoInfo * info, GstBuffer * buffer, gint x,
+    gint y, gint width, gint height, GstLogoLightStats * stats)
+{
+  GstVideoFrame frame;
+
+  g_assert_true (gst_video_frame_map (&frame, info, buffer, GST_MAP_READ));
+  g_assert_true (gst_logo_sprite_measure (&frame, x, y, width, height,
+          stats));
+  gst_video_frame_unmap (&frame);
+}
+
+static void
+test_blend_run (const GstVideoInfo * info, GstBuffer * buffer,
+    const GstLogoSprite * sprite, guint alpha)
+{
+  GstLogoPlacement placement = { sprite, 16, 8, alpha, 0, 0 };
+  GstVideoFrame frame;
+
+  g_assert_true (gst_video_frame_map (&frame, info, buffer,
+          GST_MAP_READWRITE));
+  gst_logo_sprite_blend_layers (&placement, 1, &frame,
+      GST_LOGO_BLEND_SPACE_GAMMA, NULL);
+  gst_video_frame_unmap (&frame);
+}
+
+/* Blends an opaque orange logo at 16x8 and checks the logo area shows its
+ * light, the rest of the frame is untouched and a half transparent blend
+ * lands halfway */
+static void
+test_blend (gconstpointer data)
+{
+  GstVideoFormat format = GPOINTER_TO_INT (data);
+  GstVideoInfo info;
+  GstBuffer *buffer;
+  GstMapInfo map;
+  GstLogoSprite *sprite;
+  GstLogoLightStats back, outside, stats;
+  cairo_surface_t *surface;
+  guint8 *before;
+  gdouble light;
+  gint x, y;
+
+  if (!gst_logo_sprite_supports_format (format)) {
+    g_test_skip ("Format not supported on this host");
+    return;
+  }
+
+  gst_video_info_set_format (&info, format, 128, 64);
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 32, 16);
+  cairo_surface_flush (surface);
+  for (y = 0; y < 16; y++) {
+    guint32 *row = (guint32 *) (cairo_image_surface_get_data (surface) +
+        y * cairo_image_surface_get_stride (surface));
+
+    for (x = 0; x < 32; x++)
+      row[x] = 0xffc08040;
+  }
+  cairo_surface_mark_dirty (surface);
+  sprite = gst_logo_sprite_new_from_surface (surface, format,
+      &info.colorimetry);
+  g_assert_nonnull (sprite);
+  light = gst_logo_sprite_get_light (sprite);
+
+  buffer = test_blend_buffer (&info);
+  test_blend_measure (&info, buffer, 16, 8, 32, 16, &back);
+  test_blend_measure (&info, buffer, 64, 32, 64, 32, &outside);
+  g_assert_cmpfloat (fabs (light - back.mean), >, 0.05);
+
+  /* A transparent placement does not touch the frame */
+  g_assert_true (gst_buffer_map (buffer, &map, GST_MAP_READ));
+  before = g_malloc (map.size);
+  memcpy (before, map.data, map.size);
+  gst_buffer_unmap (buffer, &map);
+  test_blend_run (&info, buffer, sprite, 0);
+  g_assert_true (gst_buffer_map (buffer, &map, GST_MAP_READ));
+  g_assert_true (memcmp (before, map.data, map.size) == 0);
+  gst_buffer_unmap (buffer, &map);
+  g_free (before);
+
+  test_blend_run (&info, buffer, sprite, 255);
+  test_blend_measure (&info, buffer, 16, 8, 32, 16, &stats);
+  g_assert_cmpfloat_with_epsilon (stats.mean, light, 1.0 / 255);
+  g_assert_cmpfloat_with_epsilon (stats.stddev, 0, 1e-6);
+  test_blend_measure (&info, buffer, 64, 32, 64, 32, &stats);
+  g_assert_cmpfloat (stats.mean, ==, outside.mean);
+  g_assert_cmpfloat (stats.stddev, ==, outside.stddev);
+  gst_buffer_unref (buffer);
+
+  buffer = test_blend_buffer (&info);
+  test_blend_run (&info, buffer, sprite, 128);
+  test_blend_measure (&info, buffer, 16, 8, 32, 16, &stats);
+  g_assert_cmpfloat_with_epsilon (stats.mean,
+      back.mean + (light - back.mean) * 128 / 255, 2.0 / 255);
+  gst_buffer_unref (buffer);
+
+  gst_logo_sprite_free (sprite);
+  cairo_surface_destroy (surface);
+}
+
+int
+main (int argc, char *argv[])
+{
+  GstVideoFormat format;
+  gchar *name;
+  guint i;
+  gint ret;
+
+  gst_init (&argc, &argv);
+  g_test_init (&argc, &argv, NULL);
+  test_crc_init ();
+  tmp_dir = g_dir_make_tmp ("test-logo-XXXXXX", NULL);
+  g_assert_nonnull (tmp_dir);
+
+  g_test_add_func ("/logo/parse/schedule", test_schedule);
+  g_test_add_func ("/logo/parse/cover", test_cover);
+  g_test_add_func ("/logo/parse/layer", test_layer);
+  g_test_add_func ("/logo/parse/keyframe", test_keyframe);
+  g_test_add_func ("/logo/parse/playlist", test_playlist_parse);
+  g_test_add_func ("/logo/text/expand", test_text);
+  g_test_add_func ("/logo/anim/sample", test_anim);
+  g_test_add_data_func ("/logo/apng/valid", GINT_TO_POINTER (APNG_VALID),
+      test_apng);
+  g_test_add_data_func ("/logo/apng/truncated",
+      GINT_TO_POINTER (APNG_TRUNCATED), test_apng);
+  g_test_add_data_func ("/logo/apng/huge-offset",
+      GINT_TO_POINTER (APNG_HUGE_OFFSET), test_apng);
+  g_test_add_func ("/logo/playlist/switch", test_playlist);
+  g_test_add_data_func ("/logo/ticker/plain", GINT_TO_POINTER (FALSE),
+      test_ticker);
+  g_test_add_data_func ("/logo/ticker/interlaced", GINT_TO_POINTER (TRUE),
+      test_ticker);
+  for (i = 0; i < G_N_ELEMENTS (blend_formats); i++) {
+    format = blend_formats[i];
+    name = g_strdup_printf ("/logo/blend/%s",
+        gst_video_format_to_string (format));
+    g_test_add_data_func (name, GINT_TO_POINTER (format), test_blend);
+    g_free (name);
+  }
+
+  ret = g_test_run ();
+
+  g_rmdir (tmp_dir);
+  g_free (tmp_dir);
+  return ret;
+}